@@ -0,0 +1,236 @@
+/**
+ * @file data_loader.cpp
+ *
+ * Implementation of the DataLoader class, which streams a dataset from disk in
+ * chunks and prefetches the next chunk on a background thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "data_loader.hpp"
+#include "extension.hpp"
+
+namespace mlpack {
+namespace data {
+
+DataLoader::DataLoader(const std::string& predictorsFile,
+                       const std::string& responsesFile,
+                       const size_t chunkSize,
+                       const bool shuffle) :
+    predictorsReader(predictorsFile),
+    responsesReader(responsesFile),
+    chunkSize(chunkSize),
+    shuffle(shuffle),
+    nextChunk(0)
+{
+  if (chunkSize == 0)
+    Log::Fatal << "DataLoader: the chunk size must be positive!" << std::endl;
+
+  if (predictorsReader.NumPoints() != responsesReader.NumPoints())
+  {
+    Log::Fatal << "DataLoader: " << predictorsFile << " has "
+        << predictorsReader.NumPoints() << " points, but " << responsesFile
+        << " has " << responsesReader.NumPoints() << " points!" << std::endl;
+  }
+
+  order.set_size(predictorsReader.NumPoints());
+  Reset();
+}
+
+DataLoader::~DataLoader()
+{
+  // Don't rethrow errors of the background thread here.
+  if (pending.valid())
+    pending.wait();
+}
+
+bool DataLoader::Next(arma::mat& predictors, arma::mat& responses)
+{
+  if (!pending.valid())
+    return false;
+
+  // Rethrows the error of the background thread, if any.
+  pending.get();
+
+  predictors = std::move(nextPredictors);
+  responses = std::move(nextResponses);
+
+  Prefetch();
+  return true;
+}
+
+void DataLoader::Reset()
+{
+  if (pending.valid())
+    pending.wait();
+
+  // The order is drawn here, since the random number generator must not be
+  // used on the background thread.
+  if (shuffle)
+    order = arma::randperm<arma::uvec>(order.n_elem);
+  else if (order.n_elem > 0)
+    order = arma::regspace<arma::uvec>(0, order.n_elem - 1);
+
+  nextChunk = 0;
+  Prefetch();
+}
+
+void DataLoader::Prefetch()
+{
+  if (nextChunk < NumChunks())
+  {
+    pending = std::async(std::launch::async, &DataLoader::LoadChunk, this,
+        nextChunk);
+    ++nextChunk;
+  }
+  else
+  {
+    pending = std::future<void>();
+  }
+}
+
+void DataLoader::LoadChunk(const size_t chunk)
+{
+  const size_t begin = chunk * chunkSize;
+  const size_t end = std::min(begin + chunkSize, (size_t) order.n_elem);
+  const arma::uvec points = order.subvec(begin, end - 1);
+
+  nextPredictors.set_size(predictorsReader.Dimensionality(), points.n_elem);
+  nextResponses.set_size(responsesReader.Dimensionality(), points.n_elem);
+
+  // Read the points in file order, so that the disk is read sequentially.
+  const arma::uvec fileOrder = arma::sort_index(points);
+  for (size_t i = 0; i < fileOrder.n_elem; ++i)
+  {
+    const size_t column = fileOrder[i];
+    predictorsReader.Read(points[column], nextPredictors.colptr(column));
+    responsesReader.Read(points[column], nextResponses.colptr(column));
+  }
+
+  if (transform)
+    transform(nextPredictors, nextResponses);
+}
+
+DataLoader::PointReader::PointReader(const std::string& filename) :
+    filename(filename),
+    stream(filename, std::ios::in | std::ios::binary),
+    dimensionality(0),
+    points(0),
+    dataOffset(0)
+{
+  if (!stream.is_open())
+    Log::Fatal << "DataLoader: cannot open " << filename << "!" << std::endl;
+
+  const std::string extension = Extension(filename);
+  if (extension == "bin")
+  {
+    binary = true;
+
+    std::string header;
+    std::getline(stream, header);
+    if (header != "ARMA_MAT_BIN_FN008")
+    {
+      Log::Fatal << "DataLoader: " << filename << " is not an Armadillo "
+          << "binary matrix of doubles!" << std::endl;
+    }
+
+    stream >> dimensionality >> points;
+    stream.get();
+    dataOffset = stream.tellg();
+  }
+  else if (extension == "csv" || extension == "txt")
+  {
+    binary = false;
+
+    // Remember where each point starts; the values are parsed on demand.
+    std::streamoff position = stream.tellg();
+    while (std::getline(stream, line))
+    {
+      if (line.find_first_not_of(" \t\r") != std::string::npos)
+      {
+        if (offsets.empty())
+          dimensionality = Parse(line, NULL);
+
+        offsets.push_back(position);
+      }
+
+      position = stream.tellg();
+    }
+
+    stream.clear();
+  }
+  else
+  {
+    Log::Fatal << "DataLoader: unknown extension '" << extension << "' of "
+        << filename << "; use csv, txt or bin!" << std::endl;
+  }
+}
+
+size_t DataLoader::PointReader::NumPoints() const
+{
+  return binary ? points : offsets.size();
+}
+
+void DataLoader::PointReader::Read(const size_t point, double* values)
+{
+  if (binary)
+  {
+    stream.seekg(dataOffset + (std::streamoff) (point * dimensionality *
+        sizeof(double)));
+    stream.read(reinterpret_cast<char*>(values), dimensionality *
+        sizeof(double));
+  }
+  else
+  {
+    stream.seekg(offsets[point]);
+    std::getline(stream, line);
+    if (stream && Parse(line, values) != dimensionality)
+    {
+      Log::Fatal << "DataLoader: point " << point << " of " << filename
+          << " doesn't have " << dimensionality << " values!" << std::endl;
+    }
+  }
+
+  if (!stream)
+  {
+    Log::Fatal << "DataLoader: cannot read point " << point << " of "
+        << filename << "!" << std::endl;
+  }
+}
+
+size_t DataLoader::PointReader::Parse(const std::string& line,
+                                      double* values) const
+{
+  size_t count = 0;
+  const char* position = line.c_str();
+  while (true)
+  {
+    while (*position == ',' || std::isspace((unsigned char) *position))
+      ++position;
+
+    if (*position == '\0')
+      break;
+
+    char* end;
+    const double value = std::strtod(position, &end);
+    if (end == position)
+    {
+      Log::Fatal << "DataLoader: cannot parse '" << line << "' in " << filename
+          << "!" << std::endl;
+    }
+
+    // Values beyond the dimensionality are only counted.
+    if (values && count < dimensionality)
+      values[count] = value;
+
+    ++count;
+    position = end;
+  }
+
+  return count;
+}
+
+} // namespace data
+} // namespace mlpack
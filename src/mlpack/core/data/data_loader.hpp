@@ -0,0 +1,206 @@
+/**
+ * @file data_loader.hpp
+ *
+ * Definition of the DataLoader class, which streams a dataset from disk in
+ * chunks and prefetches the next chunk on a background thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_DATA_LOADER_HPP
+#define MLPACK_CORE_DATA_DATA_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <fstream>
+#include <functional>
+#include <future>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The DataLoader class streams a dataset that doesn't fit into memory, or that
+ * should be augmented on the fly, from disk.  The points are handed out in
+ * chunks of a fixed size; while the caller works on one chunk, the next chunk
+ * is read (and transformed) on a background thread, so that only two or three
+ * chunks are held in memory at any time.
+ *
+ * The predictors and the responses are read from two files with the same
+ * number of points.  The format is chosen by the extension of each file:
+ *
+ *  - csv, txt: one point per line, with the values separated by commas or
+ *    whitespace (the layout data::Load() reads by default);
+ *  - bin: an Armadillo binary matrix of doubles with one point per column,
+ *    i.e. saved without transposing, e.g. with
+ *    data::Save(filename, dataset, true, false).  Binary files allow cheap
+ *    random access and should be preferred for large datasets.
+ *
+ * Each epoch visits every point once.  If shuffling is enabled, the points are
+ * visited in a new random order in every epoch; the points of each chunk are
+ * still read in file order.
+ *
+ * @code
+ * data::DataLoader loader("x.bin", "y.bin", 10000);
+ * arma::mat predictors, responses;
+ * while (loader.Next(predictors, responses))
+ * {
+ *   // Work on the chunk, while the next one is loaded.
+ * }
+ * @endcode
+ */
+class DataLoader
+{
+ public:
+  //! Type of the function that is applied to each chunk after loading, e.g.
+  //! to augment the data.
+  typedef std::function<void(arma::mat&, arma::mat&)> TransformType;
+
+  /**
+   * Create the DataLoader object on the given files, and start loading the
+   * first chunk of the first epoch.
+   *
+   * @param predictorsFile File that holds the predictors.
+   * @param responsesFile File that holds the responses.
+   * @param chunkSize Number of points per chunk (the last chunk of an epoch
+   *     may be smaller).
+   * @param shuffle If true, visit the points in a new random order in each
+   *     epoch.
+   */
+  DataLoader(const std::string& predictorsFile,
+             const std::string& responsesFile,
+             const size_t chunkSize,
+             const bool shuffle = true);
+
+  //! Wait for the chunk that is being loaded.
+  ~DataLoader();
+
+  // The background thread works on this object, so it can't be copied.
+  DataLoader(const DataLoader&) = delete;
+  DataLoader& operator=(const DataLoader&) = delete;
+
+  /**
+   * Get the next chunk of the current epoch, and start loading the one after
+   * it.
+   *
+   * @param predictors Matrix to store the predictors of the chunk in.
+   * @param responses Matrix to store the responses of the chunk in.
+   * @return false if the epoch is over (the matrices are untouched then).
+   */
+  bool Next(arma::mat& predictors, arma::mat& responses);
+
+  //! Start a new epoch (with a new order, if shuffling is enabled).
+  void Reset();
+
+  //! Get the number of points.
+  size_t NumPoints() const { return order.n_elem; }
+
+  //! Get the number of chunks per epoch.
+  size_t NumChunks() const
+  {
+    return (order.n_elem + chunkSize - 1) / chunkSize;
+  }
+
+  //! Get the number of points per chunk.
+  size_t ChunkSize() const { return chunkSize; }
+
+  //! Get whether the points are shuffled in each epoch.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether the points are shuffled (applies from the next epoch).
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the transformation applied to each chunk.
+  const TransformType& Transform() const { return transform; }
+  //! Modify the transformation applied to each chunk.  It runs on the
+  //! background thread and should not be changed during an epoch.
+  TransformType& Transform() { return transform; }
+
+ private:
+  //! Reads single points from a csv or an Armadillo binary file.
+  class PointReader
+  {
+   public:
+    //! Open the given file, and find the dimensionality and the points.
+    PointReader(const std::string& filename);
+
+    //! Read the Dimensionality() values of the given point.
+    void Read(const size_t point, double* values);
+
+    //! Get the dimensionality of the points.
+    size_t Dimensionality() const { return dimensionality; }
+
+    //! Get the number of points.
+    size_t NumPoints() const;
+
+   private:
+    //! Parse the values of the given line, and return how many there are.
+    size_t Parse(const std::string& line, double* values) const;
+
+    //! The name of the file.
+    std::string filename;
+
+    //! The stream of the file.
+    std::ifstream stream;
+
+    //! Whether the file is an Armadillo binary file.
+    bool binary;
+
+    //! The dimensionality of the points.
+    size_t dimensionality;
+
+    //! The number of points of a binary file.
+    size_t points;
+
+    //! The position of the first value of a binary file.
+    std::streamoff dataOffset;
+
+    //! The position of each line (point) of a text file.
+    std::vector<std::streamoff> offsets;
+
+    //! Buffer for the lines of a text file.
+    std::string line;
+  };
+
+  //! Load the given chunk of the current order into the next chunk.
+  void LoadChunk(const size_t chunk);
+
+  //! Start loading the next chunk, if the epoch isn't over.
+  void Prefetch();
+
+  //! The reader of the predictors.
+  PointReader predictorsReader;
+
+  //! The reader of the responses.
+  PointReader responsesReader;
+
+  //! The number of points per chunk.
+  size_t chunkSize;
+
+  //! Whether the points are shuffled in each epoch.
+  bool shuffle;
+
+  //! The transformation applied to each chunk.
+  TransformType transform;
+
+  //! The order of the points in the current epoch.
+  arma::uvec order;
+
+  //! The index of the next chunk to load.
+  size_t nextChunk;
+
+  //! The chunk that is being loaded.
+  std::future<void> pending;
+
+  //! The predictors of the chunk that is being loaded.
+  arma::mat nextPredictors;
+
+  //! The responses of the chunk that is being loaded.
+  arma::mat nextResponses;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -62,7 +62,11 @@ class ElishFunction
   static double Fn(const double x)
   {
     if (x < 0.0)
-      return (std::exp(x) - 1) / (1 + std::exp(-x));
+    {
+      // (e^x - 1) / (1 + e^{-x}), with a single exponential.
+      const double e = std::exp(x);
+      return (e - 1) * e / (e + 1);
+    }
 
     return x / (1 + std::exp(-x));
   }
@@ -90,12 +94,12 @@ class ElishFunction
   {
     if (y < 0.0)
     {
-      return std::exp(y) - 2 / (1 + std::exp(y)) +
-          2 / std::pow(1 + std::exp(y) , 2);
+      const double e = std::exp(y);
+      return e - 2 / (1 + e) + 2 / ((1 + e) * (1 + e));
     }
 
-    return 1 / (1 + std::exp(-y)) + y * std::exp(-y) /
-        std::pow(1 + std::exp(-y) , 2);
+    const double e = std::exp(-y);
+    return 1 / (1 + e) + y * e / ((1 + e) * (1 + e));
   }
 
   /**
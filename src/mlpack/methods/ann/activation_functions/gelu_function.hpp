@@ -40,7 +40,7 @@ class GELUFunction
   static double Fn(const double x)
   {
     return 0.5 * x * (1 + std::tanh(std::sqrt(2 / M_PI) *
-           (x + 0.044715 * std::pow(x, 3))));
+           (x + 0.044715 * x * x * x)));
   }
 
   /**
@@ -64,10 +64,10 @@ class GELUFunction
    */
   static double Deriv(const double y)
   {
-    return 0.5 * std::tanh(0.0356774 * std::pow(y, 3) + 0.797885 * y) +
-           (0.0535161 * std::pow(y, 3) + 0.398942 * y) *
-           std::pow(1 / std::cosh(0.0356774 * std::pow(y, 3) +
-           0.797885 * y), 2) + 0.5;
+    // sech^2(u) = 1 - tanh^2(u), so a single tanh() is needed.
+    const double cube = y * y * y;
+    const double t = std::tanh(0.0356774 * cube + 0.797885 * y);
+    return 0.5 * t + (0.0535161 * cube + 0.398942 * y) * (1 - t * t) + 0.5;
   }
 
   /**
@@ -79,10 +79,11 @@ class GELUFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = 0.5 * arma::tanh(0.0356774 * arma::pow(y, 3) + 0.797885 * y) +
-        (0.0535161 * arma::pow(y, 3) + 0.398942 * y) %
-        arma::pow(1 / arma::cosh(0.0356774 * arma::pow(y, 3) +
-        0.797885 * y), 2) + 0.5;
+    // sech^2(u) = 1 - tanh^2(u), so a single tanh() is needed.
+    const InputVecType cube = arma::pow(y, 3);
+    const InputVecType t = arma::tanh(0.0356774 * cube + 0.797885 * y);
+    x = 0.5 * t + (0.0535161 * cube + 0.398942 * y) % (1 - arma::square(t)) +
+        0.5;
   }
 }; // class GELUFunction
 
@@ -73,7 +73,8 @@ class LiSHTFunction
    */
   static double Deriv(const double y)
   {
-    return std::tanh(y) + y * (1 - std::pow(std::tanh(y), 2));
+    const double t = std::tanh(y);
+    return t + y * (1 - t * t);
   }
 
   /**
@@ -85,7 +86,8 @@ class LiSHTFunction
   template <typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType &y, OutputVecType &x)
   {
-    x = arma::tanh(y) + y % (1 - arma::pow(arma::tanh(y), 2));
+    const InputVecType t = arma::tanh(y);
+    x = t + y % (1 - arma::square(t));
   }
 }; // class LishtFunction
 
@@ -48,8 +48,11 @@ class MishFunction
    */
   static double Fn(const double x)
   {
-    return x * (std::exp(2 * x) + 2 * std::exp(x)) /
-           (2 + 2 * std::exp(x) + std::exp(2 * x));
+    // tanh(ln(1 + e^x)) = n / (n + 2) with n = e^x (e^x + 2), which tends to 1
+    // when n overflows.
+    const double e = std::exp(x);
+    const double n = e * (e + 2);
+    return std::isinf(n) ? x : x * n / (n + 2);
   }
 
   /**
@@ -61,8 +64,13 @@ class MishFunction
   template <typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType &x, OutputVecType &y)
   {
-    y = x % (arma::exp(2 * x) + 2 * arma::exp(x)) /
-        (2 + 2 * arma::exp(x) + arma::exp(2 * x));
+    const InputVecType e = arma::exp(x);
+    const InputVecType n = e % (e + 2);
+    y = x % n / (n + 2);
+
+    // Where n overflows, tanh(ln(1 + e^x)) is 1.
+    const arma::uvec overflow = arma::find_nonfinite(n);
+    y.elem(overflow) = x.elem(overflow);
   }
 
   /**
@@ -73,9 +81,16 @@ class MishFunction
    */
   static double Deriv(const double y)
   {
-    return std::exp(y) * (4 * (y + 1) + std::exp(y) * (4 * y + 6) +
-           4 * std::exp(2 * y) + std::exp(3 * y)) /
-           std::pow(std::exp(2 * y) + 2 * std::exp(y) + 2, 2);
+    // With tanh(ln(1 + e^y)) = n / (n + 2) (see Fn()), 1 - tanh^2 is
+    // 4 (n + 1) / (n + 2)^2, and the sigmoid is 1 / (1 + e^{-y}), so a single
+    // exponential is needed.
+    const double e = std::exp(y);
+    const double n = e * (e + 2);
+    if (std::isinf(n))
+      return 1.0;
+
+    const double d = n + 2;
+    return n / d + y * 4 * (n + 1) / (d * d) / (1 + 1 / e);
   }
 
   /**
@@ -87,9 +102,11 @@ class MishFunction
   template <typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType &y, OutputVecType &x)
   {
-    x = arma::exp(y) % (4 * (y + 1) + arma::exp(y) % (4 * y + 6) +
-        4 * arma::exp(2 * y) + arma::exp(3 * y)) /
-        arma::pow(arma::exp(2 * y) + 2 * arma::exp(y) + 2, 2);
+    const InputVecType e = arma::exp(y);
+    const InputVecType n = e % (e + 2);
+    const InputVecType d = n + 2;
+    x = n / d + 4 * y % (n + 1) / arma::square(d) / (1 + 1 / e);
+    x.elem(arma::find_nonfinite(n)).ones();
   }
 }; // class MishFunction
 
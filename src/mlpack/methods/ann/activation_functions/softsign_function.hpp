@@ -95,7 +95,7 @@ class SoftsignFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = arma::pow(1.0 - arma::abs(y), 2);
+    x = arma::square(1.0 - arma::abs(y));
   }
 
   /**
@@ -76,8 +76,9 @@ class SwishFunction
    */
   static double Deriv(const double y)
   {
-    return y / (1 + std::exp(-y)) + (1 - y / (1 + std::exp(-y))) /
-                                             (1 + std::exp(-y));
+    const double sigmoid = 1.0 / (1.0 + std::exp(-y));
+    const double swish = y * sigmoid;
+    return swish + sigmoid * (1 - swish);
   }
 
   /**
@@ -89,8 +90,9 @@ class SwishFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = y / (1 + arma::exp(-y)) + (1 - y / (1 + arma::exp(-y))) /
-                                           (1 + arma::exp(-y));
+    const InputVecType sigmoid = 1 / (1 + arma::exp(-y));
+    const InputVecType swish = y % sigmoid;
+    x = swish + sigmoid % (1 - swish);
   }
 }; // class SwishFunction
 
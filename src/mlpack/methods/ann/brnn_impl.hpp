@@ -416,8 +416,12 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   backwardRNN.ResetCells();
   size_t networkSize = backwardRNN.network.size();
 
-  // Forward propogation from both directions.
+  // Forward propogation from both directions.  The output parameters of all
+  // time steps are kept in workspaces that are reused across calls.
+  size_t forwardOutputIndex = 0, backwardOutputIndex = 0;
   std::vector<arma::mat> results1, results2;
+  results1.reserve(rho);
+  results2.reserve(rho);
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
     forwardRNN.Forward(arma::mat(
@@ -430,9 +434,11 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     for (size_t l = 0; l < networkSize; ++l)
     {
       boost::apply_visitor(SaveOutputParameterVisitor(
-          forwardRNNOutputParameter), forwardRNN.network[l]);
+          forwardRNNOutputParameter, forwardOutputIndex),
+          forwardRNN.network[l]);
       boost::apply_visitor(SaveOutputParameterVisitor(
-          backwardRNNOutputParameter), backwardRNN.network[l]);
+          backwardRNNOutputParameter, backwardOutputIndex),
+          backwardRNN.network[l]);
     }
     boost::apply_visitor(SaveOutputParameterVisitor(results1),
         forwardRNN.network.back());
@@ -486,6 +492,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   // Calculate and storing delta parameters from output for t = 1 to T.
   arma::mat delta;
   std::vector<arma::mat> allDelta;
+  allDelta.reserve(rho);
 
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
@@ -526,7 +533,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     for (size_t l = 0; l < networkSize; ++l)
     {
       boost::apply_visitor(LoadOutputParameterVisitor(
-          forwardRNNOutputParameter),
+          forwardRNNOutputParameter, forwardOutputIndex),
           forwardRNN.network[networkSize - 1 - l]);
     }
     boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
@@ -565,7 +572,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     for (size_t l = 0; l < networkSize; ++l)
     {
       boost::apply_visitor(LoadOutputParameterVisitor(
-          backwardRNNOutputParameter),
+          backwardRNNOutputParameter, backwardOutputIndex),
           backwardRNN.network[networkSize - 1 - l]);
     }
     boost::apply_visitor(BackwardVisitor(
@@ -0,0 +1,416 @@
+/**
+ * @file im2col_convolution.hpp
+ *
+ * Implementation of the convolution through im2col lowering. The input patches
+ * are unrolled into the columns of a matrix, so that the convolution of all
+ * filters can be expressed as a single (BLAS-backed) matrix multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution by lowering the input to a patch
+ * matrix (im2col) and multiplying it with the filter. This class allows
+ * specification of the type of the border type. The convolution can be
+ * computed with the valid border type or the full border type (default).
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * Besides the slice-wise interface shared with the other convolution rules,
+ * the class provides the Im2Col() and Col2Im() transformations for a whole
+ * batch of multi-channel inputs. Layers that use this rule lower the complete
+ * batch once and compute the forward pass, the backward pass and the gradient
+ * each with a single matrix multiplication.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    const size_t outputRows = (input.n_rows - (filter.n_rows - 1) *
+        dilationW - 1) / dW + 1;
+    const size_t outputCols = (input.n_cols - (filter.n_cols - 1) *
+        dilationH - 1) / dH + 1;
+
+    const arma::Cube<eT> inputCube(const_cast<eT*>(input.memptr()),
+        input.n_rows, input.n_cols, 1, false, true);
+
+    arma::Mat<eT> inputCols;
+    Im2Col(inputCube, 1, filter.n_rows, filter.n_cols, inputCols, dW, dH,
+        dilationW, dilationH);
+
+    output.set_size(outputRows, outputCols);
+    arma::Col<eT> outputVec(output.memptr(), output.n_elem, false, true);
+    outputVec = inputCols.t() * arma::vectorise(filter);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    size_t outputRows = (input.n_rows - 1) * dW + 2 * (filter.n_rows - 1)
+        * dilationW + 1;
+    size_t outputCols = (input.n_cols - 1) * dH + 2 * (filter.n_cols - 1)
+        * dilationH + 1;
+
+    for (size_t i = 0; i < dW; i++)
+    {
+      if (((((i + outputRows - 2 * (filter.n_rows - 1) * dilationW - 1) % dW)
+          + dW) % dW) == i)
+      {
+        outputRows += i;
+        break;
+      }
+    }
+    for (size_t i = 0; i < dH; i++)
+    {
+      if (((((i + outputCols - 2 * (filter.n_cols - 1) * dilationH - 1) % dH)
+          + dH) % dH) == i)
+      {
+        outputCols += i;
+        break;
+      }
+    }
+
+    // Pad filter and input to the working output shape.
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(outputRows,
+        outputCols);
+    inputPadded.submat((filter.n_rows - 1) * dilationW, (filter.n_cols - 1)
+        * dilationH, (filter.n_rows - 1) * dilationW + input.n_rows - 1,
+        (filter.n_cols - 1) * dilationH + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output. The input is lowered only once and all filters are
+   * applied with a single matrix multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    if (!std::is_same<BorderMode, ValidConvolution>::value)
+    {
+      arma::Mat<eT> convOutput;
+      Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(0),
+          convOutput, dW, dH, dilationW, dilationH);
+
+      output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+          filter.n_slices);
+      output.slice(0) = convOutput;
+
+      for (size_t i = 1; i < filter.n_slices; i++)
+      {
+        Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(i),
+            output.slice(i), dW, dH, dilationW, dilationH);
+      }
+      return;
+    }
+
+    const arma::Cube<eT> inputCube(const_cast<eT*>(input.memptr()),
+        input.n_rows, input.n_cols, 1, false, true);
+
+    arma::Mat<eT> inputCols;
+    Im2Col(inputCube, 1, filter.n_rows, filter.n_cols, inputCols, dW, dH,
+        dilationW, dilationH);
+
+    const arma::Mat<eT> filterMat(const_cast<eT*>(filter.memptr()),
+        filter.n_rows * filter.n_cols, filter.n_slices, false, true);
+
+    output.set_size((input.n_rows - (filter.n_rows - 1) * dilationW - 1) /
+        dW + 1, (input.n_cols - (filter.n_cols - 1) * dilationH - 1) / dH + 1,
+        filter.n_slices);
+    arma::Mat<eT> outputMat(output.memptr(), output.n_rows * output.n_cols,
+        output.n_slices, false, true);
+    outputMat = inputCols.t() * filterMat;
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /**
+   * Unroll the (valid mode) filter patches of a batch of multi-channel inputs
+   * into the columns of a matrix. The slices of the input are interpreted as
+   * inSize consecutive channels per point. Each column of the output holds one
+   * patch, ordered like the memory of a (filterRows x filterCols x inSize)
+   * filter cube; the patches of one point are stored column-major with respect
+   * to the output image, and the points are stored one after another. Hence
+   * the convolution of the whole batch with a filter bank stored as a
+   * (filterRows * filterCols * inSize) x outSize matrix W is given by
+   * output.t() * W.
+   *
+   * @param input Input batch (rows x cols x (inSize * batchSize)).
+   * @param inSize The number of input channels per point.
+   * @param filterRows The number of rows of the filter.
+   * @param filterCols The number of columns of the filter.
+   * @param output Matrix to store the unrolled patches in.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Im2Col(const arma::Cube<eT>& input,
+                     const size_t inSize,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     arma::Mat<eT>& output,
+                     const size_t dW = 1,
+                     const size_t dH = 1,
+                     const size_t dilationW = 1,
+                     const size_t dilationH = 1)
+  {
+    const size_t batchSize = input.n_slices / inSize;
+    const size_t outputRows = (input.n_rows - (filterRows - 1) * dilationW -
+        1) / dW + 1;
+    const size_t outputCols = (input.n_cols - (filterCols - 1) * dilationH -
+        1) / dH + 1;
+    const size_t patches = outputRows * outputCols;
+
+    output.set_size(filterRows * filterCols * inSize, patches * batchSize);
+
+    #pragma omp parallel for
+    for (omp_size_t b = 0; b < (omp_size_t) batchSize; ++b)
+    {
+      for (size_t j = 0; j < outputCols; ++j)
+      {
+        for (size_t i = 0; i < outputRows; ++i)
+        {
+          eT* outputPtr = output.colptr(b * patches + j * outputRows + i);
+          for (size_t c = 0; c < inSize; ++c)
+          {
+            for (size_t kj = 0; kj < filterCols; ++kj)
+            {
+              const eT* inputPtr = input.slice_colptr(b * inSize + c, j * dH +
+                  kj * dilationH) + i * dW;
+              for (size_t ki = 0; ki < filterRows; ++ki, ++outputPtr,
+                  inputPtr += dilationW)
+                *outputPtr = *inputPtr;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Fold a matrix of unrolled patches (as produced by Im2Col()) back into a
+   * batch of multi-channel images, summing up the contributions of
+   * overlapping patches. This is the adjoint of Im2Col() and is used to
+   * propagate the error of a convolution back to its input.
+   *
+   * @param input Matrix of unrolled patches.
+   * @param inSize The number of channels per point.
+   * @param filterRows The number of rows of the filter.
+   * @param filterCols The number of columns of the filter.
+   * @param output Output batch; it must already have the shape of the input
+   *     that was passed to Im2Col() and will be overwritten.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Col2Im(const arma::Mat<eT>& input,
+                     const size_t inSize,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     arma::Cube<eT>& output,
+                     const size_t dW = 1,
+                     const size_t dH = 1,
+                     const size_t dilationW = 1,
+                     const size_t dilationH = 1)
+  {
+    const size_t batchSize = output.n_slices / inSize;
+    const size_t outputRows = (output.n_rows - (filterRows - 1) * dilationW -
+        1) / dW + 1;
+    const size_t outputCols = (output.n_cols - (filterCols - 1) * dilationH -
+        1) / dH + 1;
+    const size_t patches = outputRows * outputCols;
+
+    output.zeros();
+
+    #pragma omp parallel for
+    for (omp_size_t b = 0; b < (omp_size_t) batchSize; ++b)
+    {
+      for (size_t j = 0; j < outputCols; ++j)
+      {
+        for (size_t i = 0; i < outputRows; ++i)
+        {
+          const eT* inputPtr = input.colptr(b * patches + j * outputRows + i);
+          for (size_t c = 0; c < inSize; ++c)
+          {
+            for (size_t kj = 0; kj < filterCols; ++kj)
+            {
+              eT* outputPtr = output.slice_colptr(b * inSize + c, j * dH +
+                  kj * dilationH) + i * dW;
+              for (size_t ki = 0; ki < filterRows; ++ki, ++inputPtr,
+                  outputPtr += dilationW)
+                *outputPtr += *inputPtr;
+            }
+          }
+        }
+      }
+    }
+  }
+};  // class Im2ColConvolution
+
+/**
+ * Type trait to detect the Im2ColConvolution rule; layers use it to switch to
+ * their batched (single matrix multiplication) implementation.
+ */
+template<typename ConvolutionRule>
+struct IsIm2ColConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsIm2ColConvolution<Im2ColConvolution<BorderMode> >
+{
+  static const bool value = true;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
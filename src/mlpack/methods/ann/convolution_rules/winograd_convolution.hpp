@@ -0,0 +1,346 @@
+/**
+ * @file winograd_convolution.hpp
+ *
+ * Implementation of the convolution with Winograd's minimal filtering
+ * algorithm F(2x2, 3x3) for 3x3 filters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution of 3x3 filters with Winograd's
+ * minimal filtering algorithm F(2x2, 3x3) (Lavin and Gray, "Fast Algorithms
+ * for Convolutional Neural Networks", 2016). The output is computed in tiles
+ * of 2x2 values, each of which needs 16 multiplications instead of 36. This
+ * class allows specification of the type of the border type. The convolution
+ * can be computed with the valid border type or the full border type
+ * (default).
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * Only 3x3 filters with stride 1 and without dilation are computed this way;
+ * all other shapes are passed on to the fallback rule, so the class can be
+ * used for all three rules of the Convolution layer (e.g. the filters of the
+ * gradient rule have the size of the output).
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ * @tparam FallbackRule Convolution rule (with the same border mode) used for
+ * unsupported shapes.
+ */
+template<
+    typename BorderMode = FullConvolution,
+    typename FallbackRule = NaiveConvolution<BorderMode>
+>
+class WinogradConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    if (!Supported(input, filter, dW, dH, dilationW, dilationH))
+    {
+      FallbackRule::Convolution(input, filter, output, dW, dH, dilationW,
+          dilationH);
+      return;
+    }
+
+    Winograd(input, filter, output);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    if (!Supported(input, filter, dW, dH, dilationW, dilationH))
+    {
+      FallbackRule::Convolution(input, filter, output, dW, dH, dilationW,
+          dilationH);
+      return;
+    }
+
+    // Pad the input, so that the valid convolution covers all overlaps.
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(input.n_rows + 4,
+        input.n_cols + 4);
+    inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+    Winograd(inputPadded, filter, output);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode, FallbackRule>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode, FallbackRule>::Convolution(
+          input.slice(i), filter.slice(i), output.slice(i), dW, dH, dilationW,
+          dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode, FallbackRule>::Convolution(input,
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode, FallbackRule>::Convolution(input,
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode, FallbackRule>::Convolution(input.slice(0),
+        filter, convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; i++)
+    {
+      WinogradConvolution<BorderMode, FallbackRule>::Convolution(
+          input.slice(i), filter, output.slice(i), dW, dH, dilationW,
+          dilationH);
+    }
+  }
+
+ private:
+  //! Check whether the given shape is computed with the Winograd algorithm.
+  template<typename eT>
+  static bool Supported(const arma::Mat<eT>& input,
+                        const arma::Mat<eT>& filter,
+                        const size_t dW,
+                        const size_t dH,
+                        const size_t dilationW,
+                        const size_t dilationH)
+  {
+    return filter.n_rows == 3 && filter.n_cols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1 && input.n_rows >= 3 &&
+        input.n_cols >= 3;
+  }
+
+  /*
+   * Compute the valid convolution of the given input with the given 3x3
+   * filter, as Y = A^T [(G g G^T) .* (B^T d B)] A for each 4x4 input tile d.
+   * The output must either be empty or have the size of the result already
+   * (e.g. a slice of a cube).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter 3x3 filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   */
+  template<typename eT>
+  static void Winograd(const arma::Mat<eT>& input,
+                       const arma::Mat<eT>& filter,
+                       arma::Mat<eT>& output)
+  {
+    // Transform the filter once: U = G g G^T.
+    eT t[4][4];
+    eT u[4][4];
+    for (size_t c = 0; c < 3; ++c)
+    {
+      t[0][c] = filter(0, c);
+      t[1][c] = (filter(0, c) + filter(1, c) + filter(2, c)) / 2;
+      t[2][c] = (filter(0, c) - filter(1, c) + filter(2, c)) / 2;
+      t[3][c] = filter(2, c);
+    }
+    for (size_t r = 0; r < 4; ++r)
+    {
+      u[r][0] = t[r][0];
+      u[r][1] = (t[r][0] + t[r][1] + t[r][2]) / 2;
+      u[r][2] = (t[r][0] - t[r][1] + t[r][2]) / 2;
+      u[r][3] = t[r][2];
+    }
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    const size_t tileRows = (outputRows + 1) / 2;
+    const size_t tileCols = (outputCols + 1) / 2;
+
+    // Odd output sizes need a zero border, so that all tiles are complete.
+    arma::Mat<eT> inputPadded;
+    const arma::Mat<eT>* source = &input;
+    if (outputRows % 2 != 0 || outputCols % 2 != 0)
+    {
+      inputPadded.zeros(2 * tileRows + 2, 2 * tileCols + 2);
+      inputPadded.submat(0, 0, input.n_rows - 1, input.n_cols - 1) = input;
+      source = &inputPadded;
+    }
+
+    output.set_size(outputRows, outputCols);
+
+    eT v[4][4];
+    eT s[2][4];
+    for (size_t tj = 0; tj < tileCols; ++tj)
+    {
+      for (size_t ti = 0; ti < tileRows; ++ti)
+      {
+        // V = B^T d B, computed with additions only.
+        for (size_t c = 0; c < 4; ++c)
+        {
+          const eT* d = source->colptr(2 * tj + c) + 2 * ti;
+          t[0][c] = d[0] - d[2];
+          t[1][c] = d[1] + d[2];
+          t[2][c] = d[2] - d[1];
+          t[3][c] = d[1] - d[3];
+        }
+        for (size_t r = 0; r < 4; ++r)
+        {
+          v[r][0] = (t[r][0] - t[r][2]) * u[r][0];
+          v[r][1] = (t[r][1] + t[r][2]) * u[r][1];
+          v[r][2] = (t[r][2] - t[r][1]) * u[r][2];
+          v[r][3] = (t[r][1] - t[r][3]) * u[r][3];
+        }
+
+        // Y = A^T M A, where M = U .* V is stored in v.
+        for (size_t c = 0; c < 4; ++c)
+        {
+          s[0][c] = v[0][c] + v[1][c] + v[2][c];
+          s[1][c] = v[1][c] - v[2][c] - v[3][c];
+        }
+
+        const size_t i = 2 * ti;
+        const size_t j = 2 * tj;
+        const bool secondRow = (i + 1 < outputRows);
+        const bool secondCol = (j + 1 < outputCols);
+        output(i, j) = s[0][0] + s[0][1] + s[0][2];
+        if (secondCol)
+          output(i, j + 1) = s[0][1] - s[0][2] - s[0][3];
+        if (secondRow)
+        {
+          output(i + 1, j) = s[1][0] + s[1][1] + s[1][2];
+          if (secondCol)
+            output(i + 1, j + 1) = s[1][1] - s[1][2] - s[1][3];
+        }
+      }
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -14,9 +14,11 @@
 #define MLPACK_METHODS_ANN_FFN_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/data_loader.hpp>
 
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
+#include "visitor/deterministic_check_visitor.hpp"
 #include "visitor/output_height_visitor.hpp"
 #include "visitor/output_parameter_visitor.hpp"
 #include "visitor/output_width_visitor.hpp"
@@ -163,6 +165,73 @@ class FFN
                arma::mat responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on the given sparse input data (e.g. one-hot
+   * or hashed features) using the given optimizer.  The data is never
+   * densified as a whole: a Linear first layer multiplies the sparse batches
+   * directly, any other first layer gets a dense copy of each batch.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Sparse input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(arma::sp_mat predictors,
+               arma::mat responses,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the feedforward network on the given sparse input data.  By default,
+   * the RMSProp optimization algorithm is used, but others can be specified
+   * (such as ens::SGD).
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Sparse input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType = ens::RMSProp, typename... CallbackTypes>
+  double Train(arma::sp_mat predictors,
+               arma::mat responses,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the feedforward network on the data streamed by the given loader,
+   * e.g. when the dataset doesn't fit into memory.  A single optimization is
+   * run over all points of the loader, as if they were held in memory: the
+   * optimizer sees loader.NumPoints() separable functions, and each chunk is
+   * handed to the network when the optimizer reaches its first point, while
+   * the loader reads the next chunk in the background.  When the optimizer
+   * starts a new epoch, the loader is restarted too.
+   *
+   * The points must be visited in order, as the ensmallen SGD-type optimizers
+   * do (the loader shuffles the points itself, if enabled), and the chunk size
+   * of the loader must be a multiple of the batch size of the optimizer, so
+   * that no batch spans two chunks.  The loader should be at the start of an
+   * epoch.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param loader Loader that streams the training data.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(data::DataLoader& loader,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -176,6 +245,27 @@ class FFN
    */
   void Predict(arma::mat predictors, arma::mat& results);
 
+  /**
+   * Predict the responses to the given sparse predictors; see Train() for how
+   * the sparse input is passed to the first layer.
+   *
+   * @param predictors Sparse input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   */
+  void Predict(const arma::sp_mat& predictors, arma::mat& results);
+
+  /**
+   * Predict the response to a single point. In contrast to Predict(), the
+   * point is neither copied nor split into batches, and the layer outputs of
+   * the previous call are reused, so repeated calls with points of the same
+   * dimensionality don't allocate memory once the network is warmed up. This
+   * is meant for online scoring, where points arrive one at a time.
+   *
+   * @param point Input point.
+   * @param result Vector to put the output prediction of the response into.
+   */
+  void PredictOne(const arma::colvec& point, arma::colvec& result);
+
   /**
    * Evaluate the feedforward network with the given predictors and responses.
    * This functions is usually used to monitor progress while training.
@@ -289,14 +379,22 @@ class FFN
    * @param args The layer parameter.
    */
   template <class LayerType, class... Args>
-  void Add(Args... args) { network.push_back(new LayerType(args...)); }
+  void Add(Args... args)
+  {
+    network.push_back(new LayerType(args...));
+    ClearLayerParameters();
+  }
 
   /*
    * Add a new module to the model.
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(LayerTypes<CustomLayers...> layer)
+  {
+    network.push_back(layer);
+    ClearLayerParameters();
+  }
 
   //! Get the network model.
   const std::vector<LayerTypes<CustomLayers...> >& Model() const
@@ -305,8 +403,13 @@ class FFN
   }
   //! Modify the network model.  Be careful!  If you change the structure of the
   //! network or parameters for layers, its state may become invalid, so be sure
-  //! to call ResetParameters() afterwards.
-  std::vector<LayerTypes<CustomLayers...> >& Model() { return network; }
+  //! to call ResetParameters() afterwards.  The next pass looks the layers up
+  //! again, so layers may also be replaced.
+  std::vector<LayerTypes<CustomLayers...> >& Model()
+  {
+    ClearLayerParameters();
+    return network;
+  }
 
   //! Return the number of separable functions (the number of predictor points).
   size_t NumFunctions() const { return numFunctions; }
@@ -326,11 +429,51 @@ class FFN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Get whether the layers compute their products in single precision.
+  bool MixedPrecision() const { return mixedPrecision; }
+  /**
+   * Modify whether the layers compute their products in single precision.  The
+   * layers that support it (Linear and LinearNoBias) then multiply with the
+   * single precision BLAS routines, while the parameters, the gradient and the
+   * optimizer state are kept in double precision.  The setting takes effect
+   * with the next forward pass.  The single precision copy of the weights is
+   * made once per call of Evaluate(), EvaluateWithGradient(), Gradient(),
+   * Predict() and Forward().
+   */
+  bool& MixedPrecision() { return mixedPrecision; }
+
+  //! Get the number of layers between two stored outputs (0 stores all).
+  size_t CheckpointInterval() const { return checkpointInterval; }
+  /**
+   * Modify the number of layers between two stored outputs.  If not 0, the
+   * training pass only keeps the output of every checkpointInterval-th layer
+   * (and of the last layer); all other outputs are released as soon as the
+   * next layer has consumed them, and are recomputed from the closest
+   * checkpoint when the backward pass reaches them.  A larger interval saves
+   * more memory; with about sqrt(number of layers) each layer is computed
+   * twice, and only O(sqrt(number of layers)) outputs are alive at a time.
+   *
+   * The output of every layer that implements Deterministic() (e.g. Dropout
+   * or BatchNorm, which draw random numbers or update statistics in the
+   * forward pass) is always kept, so that such layers are never recomputed.
+   * Training on sparse data does not use checkpoints.
+   */
+  size_t& CheckpointInterval() { return checkpointInterval; }
+
   /**
    * Reset the module infomration (weights/parameters).
    */
   void ResetParameters();
 
+  /**
+   * Point the weights of all layers at the parameter matrix of the network
+   * again, keeping the current parameters; unlike ResetParameters(), the
+   * initialization rule is not applied.  A copy of a network holds separate
+   * copies of the layer weights; once linked, the network can be synchronized
+   * with another one by assigning to Parameters().
+   */
+  void LinkParameters();
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -394,6 +537,20 @@ class FFN
   template<typename InputType>
   void Forward(const InputType& input);
 
+  /**
+   * The Forward algorithm for a sparse input; see Train() for how the sparse
+   * input is passed to the first layer.
+   *
+   * @param input Sparse data sequence to compute probabilities for.
+   */
+  void Forward(const arma::sp_mat& input);
+
+  /**
+   * Pass the output of the first layer through the rest of the network.  The
+   * first pass also propagates the input width and height of the layers.
+   */
+  void ForwardRemaining();
+
   /**
    * Prepare the network for the given data.
    * This function won't actually trigger training process.
@@ -403,6 +560,15 @@ class FFN
    */
   void ResetData(arma::mat predictors, arma::mat responses);
 
+  /**
+   * Prepare the network for the given sparse data.
+   * This function won't actually trigger training process.
+   *
+   * @param predictors Sparse input data variables.
+   * @param responses Outputs results from input data variables.
+   */
+  void ResetData(arma::sp_mat predictors, arma::mat responses);
+
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm). Computes
    * backward pass for module.
@@ -416,17 +582,177 @@ class FFN
   template<typename InputType>
   void Gradient(const InputType& input);
 
+  /**
+   * Iterate through all layer modules and update the the gradient, given the
+   * sparse input of the network.
+   */
+  void Gradient(const arma::sp_mat& input);
+
+  //! Check whether the output of the given layer is a checkpoint.  Layers
+  //! that implement Deterministic() are always checkpoints, so that they are
+  //! never recomputed.
+  bool IsCheckpoint(const size_t layer) const
+  {
+    return ((layer + 1) % checkpointInterval == 0) ||
+        (layer == network.size() - 1) ||
+        boost::apply_visitor(DeterministicCheckVisitor(), network[layer]);
+  }
+
+  /**
+   * The forward pass with gradient checkpointing; only the outputs of the
+   * checkpoints are kept (see CheckpointInterval()).
+   *
+   * @param input Data sequence to compute probabilities for.
+   */
+  void ForwardCheckpoints(const arma::mat& input);
+
+  /**
+   * The backward pass and the gradient computation with gradient
+   * checkpointing.  The network is processed segment by segment, from the
+   * output to the input, and the outputs inside a segment are recomputed from
+   * the checkpoint before it.
+   *
+   * @param input Input of the forward pass.
+   */
+  void BackwardCheckpoints(const arma::mat& input);
+
+  /**
+   * The separable objective over the data streamed by a DataLoader, which is
+   * optimized by Train(data::DataLoader&, ...).  The chunk that holds the
+   * requested points is loaded into the network on demand.
+   */
+  class DataLoaderFunction
+  {
+   public:
+    //! Create the function on the given network and loader, and load the
+    //! first chunk (which also initializes the network, if needed).
+    DataLoaderFunction(FFN& network, data::DataLoader& loader) :
+        network(network),
+        loader(loader),
+        chunkBegin(0),
+        chunkEnd(0)
+    {
+      Seek(0, 0);
+    }
+
+    //! Get the number of separable functions (the number of points).
+    size_t NumFunctions() const { return loader.NumPoints(); }
+
+    //! The loader shuffles the points of each epoch, if enabled.
+    void Shuffle() { /* Nothing to do. */ }
+
+    //! Evaluate the network on the given points.
+    double Evaluate(const arma::mat& parameters,
+                    const size_t begin,
+                    const size_t batchSize)
+    {
+      Seek(begin, batchSize);
+      return network.Evaluate(parameters, begin - chunkBegin, batchSize);
+    }
+
+    //! Evaluate the network and its gradient on the given points.
+    template<typename GradType>
+    double EvaluateWithGradient(const arma::mat& parameters,
+                                const size_t begin,
+                                GradType& gradient,
+                                const size_t batchSize)
+    {
+      Seek(begin, batchSize);
+      return network.EvaluateWithGradient(parameters, begin - chunkBegin,
+          gradient, batchSize);
+    }
+
+    //! Evaluate the gradient of the network on the given points.
+    void Gradient(const arma::mat& parameters,
+                  const size_t begin,
+                  arma::mat& gradient,
+                  const size_t batchSize)
+    {
+      Seek(begin, batchSize);
+      network.Gradient(parameters, begin - chunkBegin, gradient, batchSize);
+    }
+
+   private:
+    //! Make sure the chunk that holds the given points is in the network.
+    void Seek(const size_t begin, const size_t batchSize)
+    {
+      // A new epoch of the optimizer starts a new epoch of the loader.
+      if (begin < chunkBegin)
+      {
+        loader.Reset();
+        chunkBegin = chunkEnd = 0;
+      }
+
+      while (begin >= chunkEnd)
+      {
+        arma::mat predictors, responses;
+        if (!loader.Next(predictors, responses))
+        {
+          loader.Reset();
+          chunkBegin = chunkEnd = 0;
+          continue;
+        }
+
+        chunkBegin = chunkEnd;
+        chunkEnd += responses.n_cols;
+        network.ResetData(std::move(predictors), std::move(responses));
+      }
+
+      if (begin + batchSize > chunkEnd)
+      {
+        Log::Fatal << "FFN::Train(): a batch spans two chunks of the loader; "
+            << "the chunk size (" << loader.ChunkSize() << ") must be a "
+            << "multiple of the batch size (" << batchSize << ")!"
+            << std::endl;
+      }
+    }
+
+    //! The network that is trained.
+    FFN& network;
+    //! The loader of the training data.
+    data::DataLoader& loader;
+    //! The index of the first point of the current chunk.
+    size_t chunkBegin;
+    //! The index one past the last point of the current chunk.
+    size_t chunkEnd;
+  };
+
   /**
    * Reset the module status by setting the current deterministic parameter
    * for all modules that implement the Deterministic function.
    */
   void ResetDeterministic();
 
+  /**
+   * Pass the current mixed precision setting on to all modules that implement
+   * the MixedPrecision function.  They make a new single precision copy of
+   * their weights in the next forward pass.
+   */
+  void ResetMixedPrecision();
+
   /**
    * Reset the gradient for all modules that implement the Gradient function.
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Cache the output parameter and the delta of every layer, so that the
+   * forward and backward passes only need a single visitor dispatch per layer.
+   * The cache is rebuilt by ResetParameters() and by the next pass after
+   * ClearLayerParameters().
+   */
+  void CacheLayerParameters();
+
+  /**
+   * Drop the cached output parameters and deltas, because the layers may have
+   * changed.  This is done by Add() and the non-const Model().
+   */
+  void ClearLayerParameters()
+  {
+    layerOutputParameters.clear();
+    layerDeltas.clear();
+  }
+
   /**
    * Swap the content of this network with given network.
    *
@@ -456,6 +782,10 @@ class FFN
   //! The matrix of data points (predictors).
   arma::mat predictors;
 
+  //! The sparse matrix of data points, if the network is trained on sparse
+  //! data (predictors is empty then).
+  arma::sp_mat sparsePredictors;
+
   //! The matrix of responses to the input data points.
   arma::mat responses;
 
@@ -495,6 +825,15 @@ class FFN
   //! The current evaluation mode (training or testing).
   bool deterministic;
 
+  //! If true the layers compute their products in single precision.
+  bool mixedPrecision;
+
+  //! The mixed precision setting the layers were given last.
+  bool layersMixedPrecision;
+
+  //! The number of layers between two stored outputs (0 stores all).
+  size_t checkpointInterval;
+
   //! Locally-stored delta object.
   arma::mat delta;
 
@@ -510,6 +849,12 @@ class FFN
   //! Locally-stored copy visitor
   CopyVisitor<CustomLayers...> copyVisitor;
 
+  //! Locally-stored output parameter of each layer.
+  std::vector<arma::mat*> layerOutputParameters;
+
+  //! Locally-stored delta of each layer.
+  std::vector<arma::mat*> layerDeltas;
+
   // The GAN class should have access to internal members.
   template<
     typename Model,
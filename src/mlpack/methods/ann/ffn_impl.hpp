@@ -20,8 +20,11 @@
 #include "visitor/deterministic_set_visitor.hpp"
 #include "visitor/gradient_set_visitor.hpp"
 #include "visitor/gradient_visitor.hpp"
+#include "visitor/mixed_precision_set_visitor.hpp"
 #include "visitor/set_input_height_visitor.hpp"
 #include "visitor/set_input_width_visitor.hpp"
+#include "visitor/sparse_forward_visitor.hpp"
+#include "visitor/sparse_gradient_visitor.hpp"
 
 #include <boost/serialization/variant.hpp>
 
@@ -39,7 +42,10 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(true)
+    deterministic(true),
+    mixedPrecision(false),
+    layersMixedPrecision(false),
+    checkpointInterval(0)
 {
   /* Nothing to do here. */
 }
@@ -59,6 +65,23 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
 {
   numFunctions = responses.n_cols;
   this->predictors = std::move(predictors);
+  this->sparsePredictors.reset();
+  this->responses = std::move(responses);
+  this->deterministic = true;
+  ResetDeterministic();
+
+  if (!reset)
+    ResetParameters();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
+    arma::sp_mat predictors, arma::mat responses)
+{
+  numFunctions = responses.n_cols;
+  this->sparsePredictors = std::move(predictors);
+  this->predictors.reset();
   this->responses = std::move(responses);
   this->deterministic = true;
   ResetDeterministic();
@@ -149,6 +172,76 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+      arma::sp_mat predictors,
+      arma::mat responses,
+      OptimizerType& optimizer,
+      CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses));
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer,
+      this->sparsePredictors.n_cols);
+
+  // Train the model.
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "FFN::FFN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    arma::sp_mat predictors,
+    arma::mat responses,
+    CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), std::move(responses));
+
+  OptimizerType optimizer;
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer,
+      this->sparsePredictors.n_cols);
+
+  // Train the model.
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "FFN::FFN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    data::DataLoader& loader,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  WarnMessageMaxIterations<OptimizerType>(optimizer, loader.NumPoints());
+
+  // Train the model.
+  DataLoaderFunction function(*this, loader);
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(function, parameter, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "FFN::FFN(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -164,8 +257,12 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Forward(
     ResetDeterministic();
   }
 
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
   Forward(inputs);
-  results = boost::apply_visitor(outputParameterVisitor, network.back());
+  results = *layerOutputParameters.back();
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -177,19 +274,23 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Forward(
     const size_t begin,
     const size_t end)
 {
-  boost::apply_visitor(ForwardVisitor(inputs,
-      boost::apply_visitor(outputParameterVisitor, network[begin])),
+  if (layerOutputParameters.size() != network.size())
+    CacheLayerParameters();
+
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
+  boost::apply_visitor(ForwardVisitor(inputs, *layerOutputParameters[begin]),
       network[begin]);
 
   for (size_t i = 1; i < end - begin + 1; ++i)
   {
-    boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[begin + i - 1]),
-        boost::apply_visitor(outputParameterVisitor, network[begin + i])),
-        network[begin + i]);
+    boost::apply_visitor(ForwardVisitor(*layerOutputParameters[begin + i - 1],
+        *layerOutputParameters[begin + i]), network[begin + i]);
   }
 
-  results = boost::apply_visitor(outputParameterVisitor, network[end]);
+  results = *layerOutputParameters[end];
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -200,16 +301,18 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward(
     const TargetsType& targets,
     GradientsType& gradients)
 {
-  double res = outputLayer.Forward(boost::apply_visitor(
-      outputParameterVisitor, network.back()), targets);
+  // The layers may have been looked at through Model() since Forward().
+  if (layerOutputParameters.size() != network.size())
+    CacheLayerParameters();
+
+  double res = outputLayer.Forward(*layerOutputParameters.back(), targets);
 
   for (size_t i = 0; i < network.size(); ++i)
   {
     res += boost::apply_visitor(lossVisitor, network[i]);
   }
 
-  outputLayer.Backward(boost::apply_visitor(outputParameterVisitor,
-      network.back()), targets, error);
+  outputLayer.Backward(*layerOutputParameters.back(), targets, error);
 
   gradients = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
 
@@ -234,24 +337,79 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
-  arma::mat resultsTemp;
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
   Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
-  resultsTemp = boost::apply_visitor(outputParameterVisitor,
-      network.back()).col(0);
 
-  results = arma::mat(resultsTemp.n_elem, predictors.n_cols);
-  results.col(0) = resultsTemp.col(0);
+  results.set_size(layerOutputParameters.back()->n_elem, predictors.n_cols);
+  results.col(0) = layerOutputParameters.back()->col(0);
 
+  // Write the output of each point directly into the results, without
+  // temporary copies.
   for (size_t i = 1; i < predictors.n_cols; i++)
   {
     Forward(arma::mat(predictors.colptr(i), predictors.n_rows, 1, false, true));
+    results.col(i) = layerOutputParameters.back()->col(0);
+  }
+}
 
-    resultsTemp = boost::apply_visitor(outputParameterVisitor,
-        network.back());
-    results.col(i) = resultsTemp.col(0);
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
+    const arma::sp_mat& predictors, arma::mat& results)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
+  Forward(arma::sp_mat(predictors.col(0)));
+
+  results.set_size(layerOutputParameters.back()->n_elem, predictors.n_cols);
+  results.col(0) = layerOutputParameters.back()->col(0);
+
+  for (size_t i = 1; i < predictors.n_cols; i++)
+  {
+    Forward(arma::sp_mat(predictors.col(i)));
+    results.col(i) = layerOutputParameters.back()->col(0);
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::PredictOne(
+    const arma::colvec& point, arma::colvec& result)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
+  // Use the memory of the given point as input, without a copy.
+  Forward(arma::mat(const_cast<double*>(point.memptr()), point.n_elem, 1,
+      false, true));
+
+  result = layerOutputParameters.back()->col(0);
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -267,10 +425,13 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     ResetDeterministic();
   }
 
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
   Forward(predictors);
 
-  double res = outputLayer.Forward(boost::apply_visitor(
-      outputParameterVisitor, network.back()), responses);
+  double res = outputLayer.Forward(*layerOutputParameters.back(), responses);
 
   for (size_t i = 0; i < network.size(); ++i)
   {
@@ -286,7 +447,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     const arma::mat& parameters)
 {
   double res = 0;
-  for (size_t i = 0; i < predictors.n_cols; ++i)
+  for (size_t i = 0; i < responses.n_cols; ++i)
     res += Evaluate(parameters, i, 1, true);
 
   return res;
@@ -309,9 +470,17 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
+  if (!sparsePredictors.is_empty())
+    Forward(arma::sp_mat(sparsePredictors.cols(begin, begin + batchSize - 1)));
+  else
+    Forward(predictors.cols(begin, begin + batchSize - 1));
+
   double res = outputLayer.Forward(
-      boost::apply_visitor(outputParameterVisitor, network.back()),
+      *layerOutputParameters.back(),
       responses.cols(begin, begin + batchSize - 1));
 
   for (size_t i = 0; i < network.size(); ++i)
@@ -337,7 +506,7 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
 EvaluateWithGradient(const arma::mat& parameters, GradType& gradient)
 {
   double res = 0;
-  for (size_t i = 0; i < predictors.n_cols; ++i)
+  for (size_t i = 0; i < responses.n_cols; ++i)
     res += EvaluateWithGradient(parameters, i, gradient, 1);
 
   return res;
@@ -370,9 +539,29 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  // The parameters may have changed since the last call.
+  if (mixedPrecision)
+    ResetMixedPrecision();
+
+  // The first pass sets up the layer sizes, so it keeps all outputs.
+  const bool sparse = !sparsePredictors.is_empty();
+  const bool checkpoints = (checkpointInterval > 0) && reset && !sparse;
+  const arma::mat input = sparse ? arma::mat() :
+      arma::mat(predictors.colptr(begin), predictors.n_rows, batchSize, false,
+      true);
+  const arma::sp_mat sparseInput = sparse ?
+      arma::sp_mat(sparsePredictors.cols(begin, begin + batchSize - 1)) :
+      arma::sp_mat();
+
+  if (checkpoints)
+    ForwardCheckpoints(input);
+  else if (sparse)
+    Forward(sparseInput);
+  else
+    Forward(input);
+
   double res = outputLayer.Forward(
-      boost::apply_visitor(outputParameterVisitor, network.back()),
+      *layerOutputParameters.back(),
       responses.cols(begin, begin + batchSize - 1));
 
   for (size_t i = 0; i < network.size(); ++i)
@@ -381,13 +570,23 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   }
 
   outputLayer.Backward(
-      boost::apply_visitor(outputParameterVisitor, network.back()),
+      *layerOutputParameters.back(),
       responses.cols(begin, begin + batchSize - 1),
       error);
 
+  if (checkpoints)
+  {
+    ResetGradients(gradient);
+    BackwardCheckpoints(input);
+    return res;
+  }
+
   Backward();
   ResetGradients(gradient);
-  Gradient(predictors.cols(begin, begin + batchSize - 1));
+  if (sparse)
+    Gradient(sparseInput);
+  else
+    Gradient(input);
 
   return res;
 }
@@ -407,7 +606,15 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
-  math::ShuffleData(predictors, responses, predictors, responses);
+  if (!sparsePredictors.is_empty())
+  {
+    math::ShuffleData(sparsePredictors, responses, sparsePredictors,
+        responses);
+  }
+  else
+  {
+    math::ShuffleData(predictors, responses, predictors, responses);
+  }
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -415,12 +622,57 @@ template<typename OutputLayerType, typename InitializationRuleType,
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::ResetParameters()
 {
-  ResetDeterministic();
-
   // Reset the network parameter with the given initialization rule.
   NetworkInitialization<InitializationRuleType,
                         CustomLayers...> networkInit(initializeRule);
   networkInit.Initialize(network, parameter);
+
+  // Some layers (e.g. BatchNorm) reset their mode in Reset(), so the mode of
+  // the network is set afterwards.
+  ResetDeterministic();
+
+  CacheLayerParameters();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::LinkParameters()
+{
+  if (parameter.is_empty())
+    return;
+
+  // Point the layers at the parameter matrix without running the
+  // initialization rule.  Some layers (e.g. BatchNorm) overwrite their weights
+  // in Reset(), so the current parameters are copied back in place.
+  const arma::mat parameters = parameter;
+  size_t offset = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+        network[i]);
+
+    boost::apply_visitor(resetVisitor, network[i]);
+  }
+  parameter = parameters;
+
+  ResetDeterministic();
+  CacheLayerParameters();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::CacheLayerParameters()
+{
+  layerOutputParameters.resize(network.size());
+  layerDeltas.resize(network.size());
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    layerOutputParameters[i] = &boost::apply_visitor(outputParameterVisitor,
+        network[i]);
+    layerDeltas[i] = &boost::apply_visitor(deltaVisitor, network[i]);
+  }
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -433,6 +685,17 @@ void FFN<OutputLayerType, InitializationRuleType,
       boost::apply_visitor(deterministicSetVisitor));
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetMixedPrecision()
+{
+  MixedPrecisionSetVisitor mixedPrecisionSetVisitor(mixedPrecision);
+  std::for_each(network.begin(), network.end(),
+      boost::apply_visitor(mixedPrecisionSetVisitor));
+  layersMixedPrecision = mixedPrecision;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType,
@@ -452,10 +715,40 @@ template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Forward(const InputType& input)
 {
-  boost::apply_visitor(ForwardVisitor(input,
-      boost::apply_visitor(outputParameterVisitor, network.front())),
+  if (layerOutputParameters.size() != network.size())
+    CacheLayerParameters();
+
+  if (mixedPrecision != layersMixedPrecision)
+    ResetMixedPrecision();
+
+  boost::apply_visitor(ForwardVisitor(input, *layerOutputParameters.front()),
       network.front());
 
+  ForwardRemaining();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::Forward(const arma::sp_mat& input)
+{
+  if (layerOutputParameters.size() != network.size())
+    CacheLayerParameters();
+
+  if (mixedPrecision != layersMixedPrecision)
+    ResetMixedPrecision();
+
+  boost::apply_visitor(SparseForwardVisitor(input,
+      *layerOutputParameters.front()), network.front());
+
+  ForwardRemaining();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ForwardRemaining()
+{
   if (!reset)
   {
     if (boost::apply_visitor(outputWidthVisitor, network.front()) != 0)
@@ -480,9 +773,8 @@ void FFN<OutputLayerType, InitializationRuleType,
       boost::apply_visitor(SetInputHeightVisitor(height), network[i]);
     }
 
-    boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[i - 1]),
-        boost::apply_visitor(outputParameterVisitor, network[i])), network[i]);
+    boost::apply_visitor(ForwardVisitor(*layerOutputParameters[i - 1],
+        *layerOutputParameters[i]), network[i]);
 
     if (!reset)
     {
@@ -504,21 +796,96 @@ void FFN<OutputLayerType, InitializationRuleType,
     reset = true;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ForwardCheckpoints(const arma::mat& input)
+{
+  if (layerOutputParameters.size() != network.size())
+    CacheLayerParameters();
+
+  if (mixedPrecision != layersMixedPrecision)
+    ResetMixedPrecision();
+
+  boost::apply_visitor(ForwardVisitor(input, *layerOutputParameters.front()),
+      network.front());
+
+  for (size_t i = 1; i < network.size(); ++i)
+  {
+    boost::apply_visitor(ForwardVisitor(*layerOutputParameters[i - 1],
+        *layerOutputParameters[i]), network[i]);
+
+    // The output is recomputed when the backward pass needs it again.
+    if (!IsCheckpoint(i - 1))
+      layerOutputParameters[i - 1]->reset();
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::BackwardCheckpoints(const arma::mat& input)
+{
+  // The segment [first, last] ends at a checkpoint, and starts after the
+  // previous one.
+  size_t last = network.size() - 1;
+  while (true)
+  {
+    size_t first = last;
+    while (first > 0 && !IsCheckpoint(first - 1))
+      --first;
+
+    for (size_t i = first; i < last; ++i)
+    {
+      boost::apply_visitor(ForwardVisitor((i == 0) ? input :
+          *layerOutputParameters[i - 1], *layerOutputParameters[i]),
+          network[i]);
+    }
+
+    // The gradient of a layer only depends on its input and the delta of the
+    // next layer, so it is computed right after the layer's backward pass.
+    for (size_t i = last + 1; i-- > first; )
+    {
+      const arma::mat& layerError = (i == network.size() - 1) ? error :
+          *layerDeltas[i + 1];
+
+      if (i > 0)
+      {
+        boost::apply_visitor(BackwardVisitor(*layerOutputParameters[i],
+            layerError, *layerDeltas[i]), network[i]);
+      }
+
+      boost::apply_visitor(GradientVisitor((i == 0) ? input :
+          *layerOutputParameters[i - 1], layerError), network[i]);
+    }
+
+    // Release everything of the segment except the delta that the previous
+    // segment starts from, and the output of the network.
+    for (size_t i = first; i <= last && i < network.size() - 1; ++i)
+      layerOutputParameters[i]->reset();
+    for (size_t i = first + 1; i <= last + 1 && i < network.size(); ++i)
+      layerDeltas[i]->reset();
+
+    if (first == 0)
+      break;
+
+    last = first - 1;
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward()
 {
-  boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
-      outputParameterVisitor, network.back()), error,
-      boost::apply_visitor(deltaVisitor, network.back())), network.back());
+  boost::apply_visitor(BackwardVisitor(*layerOutputParameters.back(), error,
+      *layerDeltas.back()), network.back());
 
   for (size_t i = 2; i < network.size(); ++i)
   {
-    boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[network.size() - i]),
-        boost::apply_visitor(deltaVisitor, network[network.size() - i + 1]),
-        boost::apply_visitor(deltaVisitor, network[network.size() - i])),
-        network[network.size() - i]);
+    boost::apply_visitor(BackwardVisitor(
+        *layerOutputParameters[network.size() - i],
+        *layerDeltas[network.size() - i + 1],
+        *layerDeltas[network.size() - i]), network[network.size() - i]);
   }
 }
 
@@ -528,18 +895,36 @@ template<typename InputType>
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::Gradient(const InputType& input)
 {
-  boost::apply_visitor(GradientVisitor(input,
-      boost::apply_visitor(deltaVisitor, network[1])), network.front());
+  boost::apply_visitor(GradientVisitor(input, *layerDeltas[1]),
+      network.front());
 
   for (size_t i = 1; i < network.size() - 1; ++i)
   {
-    boost::apply_visitor(GradientVisitor(boost::apply_visitor(
-        outputParameterVisitor, network[i - 1]),
-        boost::apply_visitor(deltaVisitor, network[i + 1])), network[i]);
+    boost::apply_visitor(GradientVisitor(*layerOutputParameters[i - 1],
+        *layerDeltas[i + 1]), network[i]);
   }
 
-  boost::apply_visitor(GradientVisitor(boost::apply_visitor(
-      outputParameterVisitor, network[network.size() - 2]), error),
+  boost::apply_visitor(GradientVisitor(
+      *layerOutputParameters[network.size() - 2], error),
+      network[network.size() - 1]);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::Gradient(const arma::sp_mat& input)
+{
+  boost::apply_visitor(SparseGradientVisitor(input, *layerDeltas[1]),
+      network.front());
+
+  for (size_t i = 1; i < network.size() - 1; ++i)
+  {
+    boost::apply_visitor(GradientVisitor(*layerOutputParameters[i - 1],
+        *layerDeltas[i + 1]), network[i]);
+  }
+
+  boost::apply_visitor(GradientVisitor(
+      *layerOutputParameters[network.size() - 2], error),
       network[network.size() - 1]);
 }
 
@@ -577,6 +962,10 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
 
   ar & BOOST_SERIALIZATION_NVP(network);
 
+  // The cached layer parameters refer to the old layers.
+  if (Archive::is_loading::value)
+    ClearLayerParameters();
+
   // If we are loading, we need to initialize the weights.
   if (Archive::is_loading::value)
   {
@@ -596,6 +985,9 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
 
     deterministic = true;
     ResetDeterministic();
+
+    // The loaded layers compute in double precision.
+    layersMixedPrecision = false;
   }
 }
 
@@ -611,15 +1003,21 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(reset, network.reset);
   std::swap(this->network, network.network);
   std::swap(predictors, network.predictors);
+  std::swap(sparsePredictors, network.sparsePredictors);
   std::swap(responses, network.responses);
   std::swap(parameter, network.parameter);
   std::swap(numFunctions, network.numFunctions);
   std::swap(error, network.error);
   std::swap(deterministic, network.deterministic);
+  std::swap(mixedPrecision, network.mixedPrecision);
+  std::swap(layersMixedPrecision, network.layersMixedPrecision);
+  std::swap(checkpointInterval, network.checkpointInterval);
   std::swap(delta, network.delta);
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(layerOutputParameters, network.layerOutputParameters);
+  std::swap(layerDeltas, network.layerDeltas);
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -632,11 +1030,15 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(network.height),
     reset(network.reset),
     predictors(network.predictors),
+    sparsePredictors(network.sparsePredictors),
     responses(network.responses),
     parameter(network.parameter),
     numFunctions(network.numFunctions),
     error(network.error),
     deterministic(network.deterministic),
+    mixedPrecision(network.mixedPrecision),
+    layersMixedPrecision(network.layersMixedPrecision),
+    checkpointInterval(network.checkpointInterval),
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
@@ -660,15 +1062,21 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(network.height),
     reset(network.reset),
     predictors(std::move(network.predictors)),
+    sparsePredictors(std::move(network.sparsePredictors)),
     responses(std::move(network.responses)),
     parameter(std::move(network.parameter)),
     numFunctions(network.numFunctions),
     error(std::move(network.error)),
     deterministic(network.deterministic),
+    mixedPrecision(network.mixedPrecision),
+    layersMixedPrecision(network.layersMixedPrecision),
+    checkpointInterval(network.checkpointInterval),
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    layerOutputParameters(std::move(network.layerOutputParameters)),
+    layerDeltas(std::move(network.layerDeltas))
 {
   this->network = std::move(network.network);
 };
@@ -13,6 +13,11 @@
 
 #include <mlpack/core.hpp>
 
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+
 #include <mlpack/methods/ann/ffn.hpp>
 #include <mlpack/methods/ann/gan/gan_policies.hpp>
 #include <mlpack/methods/ann/visitor/output_parameter_visitor.hpp>
@@ -25,6 +30,18 @@
 namespace mlpack {
 namespace ann /** Artificial Neural Network. **/ {
 
+/**
+ * Whether a noise function can draw from a given random number generator, that
+ * is, whether it can be called as noiseFunction(generator) with a
+ * std::mt19937.
+ */
+template<typename Noise, typename = void>
+struct NoiseTakesGenerator : std::false_type { };
+
+template<typename Noise>
+struct NoiseTakesGenerator<Noise, decltype(void(std::declval<Noise&>()(
+    std::declval<std::mt19937&>())))> : std::true_type { };
+
 /**
  * The implementation of the standard GAN module. Generative Adversarial
  * Networks (GANs) are a class of artificial intelligence algorithms used
@@ -98,6 +115,9 @@ class GAN
   //! Move constructor.
   GAN(GAN&&);
 
+  //! Stop the background noise generation, if it is running.
+  ~GAN();
+
   /**
    * Initialize the generator, discriminator and weights of the model for
    * training. This function won't actually trigger training process.
@@ -176,6 +196,10 @@ class GAN
    * This function gives the performance of the Standard GAN or DCGAN on the
    * current input, while updating Gradients.
    *
+   * If Overlap() is set, the noise for the next batch is generated by a
+   * background thread while the current batch is processed, and the
+   * discriminator sees the real and the generated batch in a single pass.
+   *
    * @param parameters The parameters of the network.
    * @param i Index of the current input.
    * @param gradient Variable to store the present gradient.
@@ -321,6 +345,24 @@ class GAN
   //! Modify the matrix of responses to the input data points.
   arma::mat& Responses() { return responses; }
 
+  /**
+   * Get whether training overlaps the noise generation of the next batch with
+   * the current one, and runs the discriminator on the real and the generated
+   * batch at once.  This only applies to the Standard GAN and DCGAN.
+   */
+  bool Overlap() const { return overlap; }
+  /**
+   * Modify whether training overlaps the noise generation of the next batch
+   * with the current one.  The noise is only generated in the background if
+   * the noise function can be called as noiseFunction(generator) with a
+   * std::mt19937; it then has to draw from that generator alone.  The
+   * background thread is started by ResetData() and stopped at the end of
+   * Train(); its generator is seeded from math::randGen when it is started, so
+   * math::RandomSeed() still fixes the noise.  Any other noise function is
+   * called on the training thread as usual.
+   */
+  bool& Overlap() { return overlap; }
+
   //! Get the matrix of data points (predictors).
   const arma::mat& Predictors() const { return predictors; }
   //! Modify the matrix of data points (predictors).
@@ -337,6 +379,33 @@ class GAN
   */
   void ResetDeterministic();
 
+  /**
+   * Fill the noise of the current batch.  If the noise function can draw from
+   * a given generator, this takes the noise generated in the background and
+   * lets the background thread generate the noise of the next batch.
+   */
+  void PrefetchNoise();
+
+  //! Take the noise generated in the background, and hand the buffer back to
+  //! the background thread.
+  void PrefetchNoise(std::true_type /* takesGenerator */);
+
+  //! Generate the noise on the calling thread.
+  void PrefetchNoise(std::false_type /* takesGenerator */);
+
+  /**
+   * Start the thread that generates the noise of the next batch into
+   * nextNoise whenever the buffer has been taken.  Nothing is started if the
+   * noise function can't draw from a given generator.
+   */
+  void StartNoiseThread(std::true_type /* takesGenerator */);
+
+  //! The noise is generated on the training thread; nothing to start.
+  void StartNoiseThread(std::false_type /* takesGenerator */) { }
+
+  //! Stop and join the noise thread, if it is running.
+  void StopNoiseThread();
+
   //! Locally stored parameter for training data + noise data.
   arma::mat predictors;
   //! Locally stored parameters of the network.
@@ -401,6 +470,22 @@ class GAN
   size_t genWeights;
   //! To keep track of number of discriminator weights in total weights.
   size_t discWeights;
+  //! Locally stored flag for overlapped training.
+  bool overlap;
+  //! Locally stored noise for the next batch, filled in the background.
+  arma::mat nextNoise;
+  //! Locally stored generator the noise thread draws from.
+  std::mt19937 noiseGenerator;
+  //! Guards noiseReady and noiseStop.
+  std::mutex noiseMutex;
+  //! Signals changes of noiseReady and noiseStop.
+  std::condition_variable noiseCondition;
+  //! Whether nextNoise holds the noise of the next batch.
+  bool noiseReady;
+  //! Whether the noise thread has to stop.
+  bool noiseStop;
+  //! The thread that fills nextNoise.
+  std::thread noiseThread;
 };
 
 } // namespace ann
@@ -57,7 +57,10 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
     reset(false),
     deterministic(false),
     genWeights(0),
-    discWeights(0)
+    discWeights(0),
+    overlap(false),
+    noiseReady(false),
+    noiseStop(false)
 {
   // Insert IdentityLayer for joining the Generator and Discriminator.
   this->discriminator.network.insert(
@@ -93,7 +96,10 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
     noise(network.noise),
     deterministic(network.deterministic),
     genWeights(network.genWeights),
-    discWeights(network.discWeights)
+    discWeights(network.discWeights),
+    overlap(network.overlap),
+    noiseReady(false),
+    noiseStop(false)
 {
   /* Nothing to do here */
 }
@@ -126,11 +132,25 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
     noise(std::move(network.noise)),
     deterministic(network.deterministic),
     genWeights(network.genWeights),
-    discWeights(network.discWeights)
+    discWeights(network.discWeights),
+    overlap(network.overlap),
+    noiseReady(false),
+    noiseStop(false)
 {
   /* Nothing to do here */
 }
 
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+GAN<Model, InitializationRuleType, Noise, PolicyType>::~GAN()
+{
+  StopNoiseThread();
+}
+
 template<
   typename Model,
   typename InitializationRuleType,
@@ -140,10 +160,14 @@ template<
 void GAN<Model, InitializationRuleType, Noise, PolicyType>::ResetData(
     arma::mat trainData)
 {
+  // Don't let the noise thread outlive the old sizes.
+  StopNoiseThread();
+
   currentBatch = 0;
 
   numFunctions = trainData.n_cols;
   noise.set_size(noiseDim, batchSize);
+  nextNoise.set_size(noiseDim, batchSize);
 
   deterministic = true;
   ResetDeterministic();
@@ -151,16 +175,18 @@ void GAN<Model, InitializationRuleType, Noise, PolicyType>::ResetData(
   /**
    * These predictors are shared by the discriminator network. The additional
    * batch size predictors are taken from the generator network while training.
-   * For more details please look in EvaluateWithGradient() function.
+   * Behind them is room for a copy of the current real batch, so that an
+   * overlapped step can pass the generated and the real batch to the
+   * discriminator as one contiguous block. For more details please look in
+   * EvaluateWithGradient() function.
    */
-  this->predictors.set_size(trainData.n_rows, numFunctions + batchSize);
+  this->predictors.set_size(trainData.n_rows, numFunctions + 2 * batchSize);
   this->predictors.cols(0, numFunctions - 1) = std::move(trainData);
   this->discriminator.predictors = arma::mat(this->predictors.memptr(),
       this->predictors.n_rows, this->predictors.n_cols, false, false);
 
-  responses.ones(1, numFunctions + batchSize);
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+  responses.ones(1, numFunctions + 2 * batchSize);
+  responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
   this->discriminator.responses = arma::mat(this->responses.memptr(),
       this->responses.n_rows, this->responses.n_cols, false, false);
 
@@ -171,6 +197,9 @@ void GAN<Model, InitializationRuleType, Noise, PolicyType>::ResetData(
   {
     Reset();
   }
+
+  if (overlap)
+    StartNoiseThread(NoiseTakesGenerator<Noise>());
 }
 
 template<
@@ -225,7 +254,12 @@ double GAN<Model, InitializationRuleType, Noise, PolicyType>::Train(
 {
   ResetData(std::move(trainData));
 
-  return Optimizer.Optimize(*this, parameter, callbacks...);
+  const double objective = Optimizer.Optimize(*this, parameter, callbacks...);
+
+  // Don't leave the noise thread running for a batch that never comes.
+  StopNoiseThread();
+
+  return objective;
 }
 
 template<
@@ -271,8 +305,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
       boost::apply_visitor(outputParameterVisitor, generator.network.back());
   discriminator.Forward(predictors.cols(numFunctions,
       numFunctions + batchSize - 1));
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+  responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
 
   currentTarget = arma::mat(responses.memptr() + numFunctions,
       1, batchSize, false, false);
@@ -318,16 +351,6 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
-  if (noiseGradientDiscriminator.is_empty())
-  {
-    noiseGradientDiscriminator = arma::zeros<arma::mat>(
-        gradientDiscriminator.n_elem, 1);
-  }
-  else
-  {
-    noiseGradientDiscriminator.zeros();
-  }
-
   gradientGenerator = arma::mat(gradient.memptr(),
       generator.Parameters().n_elem, 1, false, false);
 
@@ -335,37 +358,85 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       gradientGenerator.n_elem,
       discriminator.Parameters().n_elem, 1, false, false);
 
-  // Get the gradients of the Discriminator.
-  double res = discriminator.EvaluateWithGradient(discriminator.parameter,
-      i, gradientDiscriminator, batchSize);
+  double res;
+  if (overlap)
+  {
+    PrefetchNoise();
+    generator.Forward(noise);
+
+    // Place the generated batch and a copy of the real batch side by side,
+    // and get the gradients of the Discriminator from a single pass over both.
+    predictors.cols(numFunctions, numFunctions + batchSize - 1) =
+        boost::apply_visitor(outputParameterVisitor, generator.network.back());
+    predictors.cols(numFunctions + batchSize, numFunctions + 2 * batchSize -
+        1) = predictors.cols(i, i + batchSize - 1);
+    responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
+
+    res = discriminator.EvaluateWithGradient(discriminator.parameter,
+        numFunctions, gradientDiscriminator, 2 * batchSize);
+  }
+  else
+  {
+    if (noiseGradientDiscriminator.is_empty())
+    {
+      noiseGradientDiscriminator = arma::zeros<arma::mat>(
+          gradientDiscriminator.n_elem, 1);
+    }
+    else
+    {
+      noiseGradientDiscriminator.zeros();
+    }
 
-  noise.imbue( [&]() { return noiseFunction();} );
-  generator.Forward(noise);
-  predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+    // Get the gradients of the Discriminator.
+    res = discriminator.EvaluateWithGradient(discriminator.parameter,
+        i, gradientDiscriminator, batchSize);
+
+    noise.imbue( [&]() { return noiseFunction();} );
+    generator.Forward(noise);
+    predictors.cols(numFunctions, numFunctions + batchSize - 1) =
+        boost::apply_visitor(outputParameterVisitor, generator.network.back());
+    responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
 
-  // Get the gradients of the Generator.
-  res += discriminator.EvaluateWithGradient(discriminator.parameter,
-      numFunctions, noiseGradientDiscriminator, batchSize);
-  gradientDiscriminator += noiseGradientDiscriminator;
+    // Get the gradients of the Generator.
+    res += discriminator.EvaluateWithGradient(discriminator.parameter,
+        numFunctions, noiseGradientDiscriminator, batchSize);
+    gradientDiscriminator += noiseGradientDiscriminator;
+  }
 
   if (currentBatch % generatorUpdateStep == 0 && preTrainSize == 0)
   {
     // Minimize -log(D(G(noise))).
     // Pass the error from Discriminator to Generator.
-    responses.cols(numFunctions, numFunctions + batchSize - 1) =
-        arma::ones(1, batchSize);
+    responses.cols(numFunctions, numFunctions + batchSize - 1).ones();
 
-    discriminator.outputLayer.Backward(
-        boost::apply_visitor(outputParameterVisitor,
-        discriminator.network.back()), discriminator.responses.cols(
-        numFunctions, numFunctions + batchSize - 1), discriminator.error);
-    discriminator.Backward();
+    arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+        discriminator.network.back());
+    if (overlap)
+    {
+      // The last pass also holds the real batch, whose error is zero, so
+      // that only the generated batch passes its error on.
+      discriminator.error.zeros(output.n_rows, output.n_cols);
+      arma::mat generatedOutput(output.memptr(), output.n_rows, batchSize,
+          false, true);
+      arma::mat generatedError(discriminator.error.memptr(), output.n_rows,
+          batchSize, false, true);
+      discriminator.outputLayer.Backward(generatedOutput,
+          discriminator.responses.cols(numFunctions,
+          numFunctions + batchSize - 1), generatedError);
+      discriminator.Backward();
+
+      generator.error = boost::apply_visitor(deltaVisitor,
+          discriminator.network[1]).cols(0, batchSize - 1);
+    }
+    else
+    {
+      discriminator.outputLayer.Backward(output, discriminator.responses.cols(
+          numFunctions, numFunctions + batchSize - 1), discriminator.error);
+      discriminator.Backward();
 
-    generator.error = boost::apply_visitor(deltaVisitor,
-        discriminator.network[1]);
+      generator.error = boost::apply_visitor(deltaVisitor,
+          discriminator.network[1]);
+    }
 
     generator.Predictors() = noise;
     generator.Backward();
@@ -479,6 +550,110 @@ ResetDeterministic()
   this->generator.ResetDeterministic();
 }
 
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::PrefetchNoise()
+{
+  PrefetchNoise(NoiseTakesGenerator<Noise>());
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::PrefetchNoise(
+    std::true_type /* takesGenerator */)
+{
+  // The noise thread is started by ResetData(), unless the overlapped mode
+  // was switched on afterwards.
+  if (!noiseThread.joinable())
+    StartNoiseThread(std::true_type());
+
+  // Take the noise of this batch, and let the noise thread fill the buffer of
+  // the previous batch with the noise of the next one.
+  std::unique_lock<std::mutex> lock(noiseMutex);
+  noiseCondition.wait(lock, [this]() { return noiseReady; });
+  noise.swap(nextNoise);
+  noiseReady = false;
+  lock.unlock();
+  noiseCondition.notify_all();
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::PrefetchNoise(
+    std::false_type /* takesGenerator */)
+{
+  noise.imbue( [&]() { return noiseFunction();} );
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::StartNoiseThread(
+    std::true_type /* takesGenerator */)
+{
+  StopNoiseThread();
+
+  // The thread must not touch math::randGen, which the training thread keeps
+  // using, so it gets its own generator, seeded here.
+  noiseGenerator.seed(math::randGen());
+  nextNoise.set_size(noiseDim, batchSize);
+  noiseReady = false;
+  noiseStop = false;
+
+  noiseThread = std::thread([this]()
+  {
+    std::unique_lock<std::mutex> lock(noiseMutex);
+    while (true)
+    {
+      noiseCondition.wait(lock, [this]() { return !noiseReady || noiseStop; });
+      if (noiseStop)
+        return;
+
+      // The training thread doesn't touch nextNoise until noiseReady is set.
+      lock.unlock();
+      nextNoise.imbue( [&]() { return noiseFunction(noiseGenerator);} );
+      lock.lock();
+
+      noiseReady = true;
+      noiseCondition.notify_all();
+    }
+  });
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::StopNoiseThread()
+{
+  if (!noiseThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(noiseMutex);
+    noiseStop = true;
+  }
+  noiseCondition.notify_all();
+  noiseThread.join();
+}
+
 template<
   typename Model,
   typename InitializationRuleType,
@@ -214,6 +214,41 @@ void AtrousConvolution<
       outSize * batchSize, false, false);
   outputTemp.zeros();
 
+  if (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    // Lower the whole batch to a patch matrix and apply all filters at once.
+    arma::mat inputCols;
+    if (padding.PadWLeft() != 0 || padding.PadWRight() != 0 ||
+        padding.PadHTop() != 0 || padding.PadHBottom() != 0)
+    {
+      Im2ColConvolution<ValidConvolution>::Im2Col(inputPaddedTemp, inSize,
+          kernelWidth, kernelHeight, inputCols, strideWidth, strideHeight,
+          dilationWidth, dilationHeight);
+    }
+    else
+    {
+      Im2ColConvolution<ValidConvolution>::Im2Col(inputTemp, inSize,
+          kernelWidth, kernelHeight, inputCols, strideWidth, strideHeight,
+          dilationWidth, dilationHeight);
+    }
+
+    const arma::mat weightMat(weight.memptr(), kernelWidth * kernelHeight *
+        inSize, outSize, false, true);
+    const arma::Mat<eT> convOutput = inputCols.t() * weightMat;
+
+    const size_t patches = wConv * hConv;
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      arma::Mat<eT> outputMat(output.colptr(b), patches, outSize, false, true);
+      outputMat = convOutput.rows(b * patches, (b + 1) * patches - 1);
+      outputMat.each_row() += bias.t();
+    }
+
+    outputWidth = outputTemp.n_rows;
+    outputHeight = outputTemp.n_cols;
+    return;
+  }
+
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
       outSize * batchSize; outMap++)
   {
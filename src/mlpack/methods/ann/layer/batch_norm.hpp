@@ -178,6 +178,9 @@ class BatchNorm
   //! Locally-stored variance object.
   OutputDataType variance;
 
+  //! Locally-stored inverse standard deviation of the current batch.
+  OutputDataType stdInv;
+
   //! Locally-stored mean object.
   OutputDataType runningMean;
 
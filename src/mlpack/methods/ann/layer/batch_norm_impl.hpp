@@ -78,28 +78,33 @@ void BatchNorm<InputDataType, OutputDataType>::Forward(
   {
     mean = arma::mean(input, 1);
     variance = arma::var(input, 1, 1);
+    stdInv = 1.0 / arma::sqrt(variance + eps);
 
-    // Normalize the input.
-    output = input.each_col() - mean;
-    inputMean = output;
-    output.each_col() /= arma::sqrt(variance + eps);
+    // Normalize, scale and shift the input in a single pass over every
+    // column; the centered and the normalized input are reused in the
+    // backward and gradient step.
+    inputMean.set_size(input.n_rows, input.n_cols);
+    normalized.set_size(input.n_rows, input.n_cols);
+    output.set_size(input.n_rows, input.n_cols);
 
-    // Use Welford method to compute the sample variance and mean.
-    for (size_t i = 0; i < input.n_cols; i++)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
     {
-      count += 1;
-
-      OutputDataType diff = input.col(i) - runningMean;
-      runningMean = runningMean + diff / count;
-      runningVariance += diff % (input.col(i) - runningMean);
+      inputMean.col(i) = input.col(i) - mean;
+      normalized.col(i) = inputMean.col(i) % stdInv;
+      output.col(i) = normalized.col(i) % gamma + beta;
     }
 
-    // Reused in the backward and gradient step.
-    normalized = output;
-
-    // Scale and shift the output.
-    output.each_col() %= gamma;
-    output.each_col() += beta;
+    // Merge the batch statistics into the running statistics at once; this
+    // is the parallel form of the Welford method and gives the same sample
+    // mean and variance as updating with one point at a time.
+    const double batchSize = input.n_cols;
+    const double total = count + batchSize;
+    const OutputDataType diff = mean - runningMean;
+    runningMean += diff * (batchSize / total);
+    runningVariance += variance * batchSize +
+        arma::square(diff) * (count * batchSize / total);
+    count += input.n_cols;
   }
 }
 
@@ -108,8 +113,6 @@ template<typename eT>
 void BatchNorm<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& input, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  const arma::mat stdInv = 1.0 / arma::sqrt(variance + eps);
-
   // Step 1: dl / dxhat.
   const arma::mat norm = gy.each_col() % gamma;
 
@@ -117,14 +120,20 @@ void BatchNorm<InputDataType, OutputDataType>::Backward(
   const arma::mat var = arma::sum(norm % inputMean, 1) %
       arma::pow(stdInv, 3.0) * -0.5;
 
-  // Step 4: dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  g = (norm.each_col() % stdInv) + (inputMean.each_col() %
-      var * 2 / input.n_cols);
-
   // Step 3: sum (dl / dxhat * -1 / stdInv) + variance *
   // (sum -2 * (x - mu)) / m.
-  g.each_col() += arma::sum(norm.each_col() % -stdInv, 1) / input.n_cols;
+  const arma::mat meanTerm = arma::sum(norm, 1) % -stdInv / input.n_cols;
+  const arma::mat varTerm = var * 2 / input.n_cols;
+
+  // Step 4: dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
+  // dl / dmu * 1 / m, computed column by column.
+  g.set_size(gy.n_rows, gy.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) gy.n_cols; ++i)
+  {
+    g.col(i) = norm.col(i) % stdInv + inputMean.col(i) % varTerm + meanTerm;
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
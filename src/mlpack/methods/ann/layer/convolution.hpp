@@ -18,6 +18,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 
 #include "layer_types.hpp"
 #include "padding.hpp"
@@ -29,6 +31,12 @@ namespace ann /** Artificial Neural Network. */ {
  * Implementation of the Convolution class. The Convolution class represents a
  * single layer of a neural network.
  *
+ * If the convolution rules are Im2ColConvolution (the default), the whole
+ * batch is lowered to a patch matrix and the forward pass, the backward pass
+ * and the gradient are each computed with a single matrix multiplication.
+ * Otherwise every (input map, output map) pair is convolved separately using
+ * the given rules.
+ *
  * @tparam ForwardConvolutionRule Convolution to perform forward process.
  * @tparam BackwardConvolutionRule Convolution to perform backward process.
  * @tparam GradientConvolutionRule Convolution to calculate gradient.
@@ -38,9 +46,9 @@ namespace ann /** Artificial Neural Network. */ {
  *         arma::sp_mat or arma::cube).
  */
 template <
-    typename ForwardConvolutionRule = NaiveConvolution<ValidConvolution>,
-    typename BackwardConvolutionRule = NaiveConvolution<FullConvolution>,
-    typename GradientConvolutionRule = NaiveConvolution<ValidConvolution>,
+    typename ForwardConvolutionRule = Im2ColConvolution<ValidConvolution>,
+    typename BackwardConvolutionRule = Im2ColConvolution<FullConvolution>,
+    typename GradientConvolutionRule = Im2ColConvolution<ValidConvolution>,
     typename InputDataType = arma::mat,
     typename OutputDataType = arma::mat
 >
@@ -368,6 +376,9 @@ class Convolution
   //! Locally-stored transformed error parameter.
   arma::cube gTemp;
 
+  //! Locally-stored unrolled input patches (used by Im2ColConvolution).
+  arma::mat inputColsTemp;
+
   //! Locally-stored transformed gradient parameter.
   arma::cube gradientTemp;
 
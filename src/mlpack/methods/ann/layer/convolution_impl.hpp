@@ -202,6 +202,37 @@ void Convolution<
       outSize * batchSize, false, false);
   outputTemp.zeros();
 
+  if (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    // Lower the whole batch to a patch matrix and apply all filters at once.
+    if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+    {
+      Im2ColConvolution<ValidConvolution>::Im2Col(inputPaddedTemp, inSize,
+          kernelWidth, kernelHeight, inputColsTemp, strideWidth, strideHeight);
+    }
+    else
+    {
+      Im2ColConvolution<ValidConvolution>::Im2Col(inputTemp, inSize,
+          kernelWidth, kernelHeight, inputColsTemp, strideWidth, strideHeight);
+    }
+
+    const arma::mat weightMat(weight.memptr(), kernelWidth * kernelHeight *
+        inSize, outSize, false, true);
+    const arma::Mat<eT> convOutput = inputColsTemp.t() * weightMat;
+
+    const size_t patches = wConv * hConv;
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      arma::Mat<eT> outputMat(output.colptr(b), patches, outSize, false, true);
+      outputMat = convOutput.rows(b * patches, (b + 1) * patches - 1);
+      outputMat.each_row() += bias.t();
+    }
+
+    outputWidth = outputTemp.n_rows;
+    outputHeight = outputTemp.n_cols;
+    return;
+  }
+
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
       outSize * batchSize; outMap++)
   {
@@ -261,6 +292,42 @@ void Convolution<
   g.set_size(inputWidth * inputHeight * inSize, batchSize);
   gTemp = arma::Cube<eT>(g.memptr(), inputWidth, inputHeight,
       inSize * batchSize, false, false);
+
+  if (IsIm2ColConvolution<BackwardConvolutionRule>::value)
+  {
+    // Collect the error of all points as a (patches * batchSize) x outSize
+    // matrix, so that the error of all patches is W * error^T.
+    const size_t patches = outputWidth * outputHeight;
+    arma::Mat<eT> errorMat(patches * batchSize, outSize);
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      errorMat.rows(b * patches, (b + 1) * patches - 1) = arma::Mat<eT>(
+          ((arma::Mat<eT>&) gy).colptr(b), patches, outSize, false, true);
+    }
+
+    const arma::mat weightMat(weight.memptr(), kernelWidth * kernelHeight *
+        inSize, outSize, false, true);
+    const arma::Mat<eT> errorCols = weightMat * errorMat.t();
+
+    if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+    {
+      arma::Cube<eT> gPaddedTemp(inputWidth + padWLeft + padWRight,
+          inputHeight + padHTop + padHBottom, inSize * batchSize);
+      Im2ColConvolution<ValidConvolution>::Col2Im(errorCols, inSize,
+          kernelWidth, kernelHeight, gPaddedTemp, strideWidth, strideHeight);
+
+      gTemp = gPaddedTemp.tube(padWLeft, padHTop, padWLeft + inputWidth - 1,
+          padHTop + inputHeight - 1);
+    }
+    else
+    {
+      Im2ColConvolution<ValidConvolution>::Col2Im(errorCols, inSize,
+          kernelWidth, kernelHeight, gTemp, strideWidth, strideHeight);
+    }
+
+    return;
+  }
+
   gTemp.zeros();
 
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
@@ -320,6 +387,50 @@ void Convolution<
   gradient.set_size(weights.n_elem, 1);
   gradientTemp = arma::Cube<eT>(gradient.memptr(), weight.n_rows,
       weight.n_cols, weight.n_slices, false, false);
+
+  // Pad the given input again instead of reusing the one of the last forward
+  // pass: a recurrent network calls Gradient() for each time step after all
+  // the forward passes are done.
+  if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+  {
+    inputPaddedTemp.set_size(inputTemp.n_rows + padWLeft + padWRight,
+        inputTemp.n_cols + padHTop + padHBottom, inputTemp.n_slices);
+
+    for (size_t i = 0; i < inputTemp.n_slices; ++i)
+      padding.Forward(inputTemp.slice(i), inputPaddedTemp.slice(i));
+  }
+
+  if (IsIm2ColConvolution<GradientConvolutionRule>::value)
+  {
+    // For the same reason, lower the input to a patch matrix again.
+    if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+    {
+      Im2ColConvolution<ValidConvolution>::Im2Col(inputPaddedTemp, inSize,
+          kernelWidth, kernelHeight, inputColsTemp, strideWidth,
+          strideHeight);
+    }
+    else
+    {
+      Im2ColConvolution<ValidConvolution>::Im2Col(inputTemp, inSize,
+          kernelWidth, kernelHeight, inputColsTemp, strideWidth,
+          strideHeight);
+    }
+
+    const size_t patches = outputWidth * outputHeight;
+    arma::Mat<eT> errorMat(patches * batchSize, outSize);
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      errorMat.rows(b * patches, (b + 1) * patches - 1) = arma::Mat<eT>(
+          ((arma::Mat<eT>&) error).colptr(b), patches, outSize, false, true);
+    }
+
+    arma::Mat<eT> weightGradient(gradient.memptr(), weight.n_elem / outSize,
+        outSize, false, true);
+    weightGradient = inputColsTemp * errorMat;
+    gradient.rows(weight.n_elem, weights.n_elem - 1) = arma::sum(errorMat).t();
+    return;
+  }
+
   gradientTemp.zeros();
 
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
@@ -138,6 +138,17 @@ class FastLSTM
   //! Modify the maximum number of steps to backpropagate through time (BPTT).
   size_t& Rho() { return rho; }
 
+  //! Get whether the state is carried over from one sequence to the next.
+  bool Stateful() const { return stateful; }
+  /**
+   * Modify whether the state is carried over from one sequence to the next.
+   * If true, the last output and cell state of a sequence are used as the
+   * initial state of the next one instead of zeros; the error is still only
+   * backpropagated through the steps of the current sequence.  ResetCell()
+   * drops the carried state only if the layer is not stateful.
+   */
+  bool& Stateful() { return stateful; }
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -266,6 +277,16 @@ class FastLSTM
   //! Bias between the input and gate.
   OutputDataType input2GateBias;
 
+  //! The input weights, bias and output weights of all gates, which are
+  //! stored next to each other, as a single matrix.
+  OutputDataType gateWeight;
+
+  //! Locally-stored stacked input, constant one and previous output.
+  OutputDataType gateInput;
+
+  //! Locally-stored error with respect to the stacked gate input.
+  OutputDataType gateInputError;
+
   //! Locally-stored gate parameter.
   OutputDataType gate;
 
@@ -295,6 +316,19 @@ class FastLSTM
 
   //! Current backpropagate through time steps.
   size_t bpttSteps;
+
+  //! If true the state is carried over from one sequence to the next.
+  bool stateful;
+
+  //! Locally-stored last output of the previous sequence.
+  OutputDataType stateOutput;
+
+  //! Locally-stored last cell state of the previous sequence.
+  OutputDataType stateCell;
+
+  //! Locally-stored initial cell state of the current sequence (empty if the
+  //! sequence starts from zero).
+  OutputDataType initialCell;
 }; // class FastLSTM
 
 } // namespace ann
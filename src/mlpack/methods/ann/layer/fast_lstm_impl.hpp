@@ -20,7 +20,8 @@ namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
 template<typename InputDataType, typename OutputDataType>
-FastLSTM<InputDataType, OutputDataType>::FastLSTM()
+FastLSTM<InputDataType, OutputDataType>::FastLSTM() :
+    stateful(false)
 {
   // Nothing to do here.
 }
@@ -38,7 +39,8 @@ FastLSTM<InputDataType, OutputDataType>::FastLSTM(
     batchStep(0),
     gradientStepIdx(0),
     rhoSize(rho),
-    bpttSteps(0)
+    bpttSteps(0),
+    stateful(false)
 {
   // Weights for: input to gate layer (4 * outsize * inSize + 4 * outsize)
   // and output to gate (4 * outSize).
@@ -60,11 +62,22 @@ void FastLSTM<InputDataType, OutputDataType>::Reset()
   // (linear no bias layer) using the overall layer parameter matrix.
   output2GateWeight = OutputDataType(weights.memptr() + input2GateWeight.n_elem
       + input2GateBias.n_elem, 4 * outSize, outSize, false, false);
+
+  // All three blocks have 4 * outSize rows, so together they form a single
+  // matrix that is applied to the stacked input [input; 1; previous output].
+  gateWeight = OutputDataType(weights.memptr(), 4 * outSize,
+      inSize + 1 + outSize, false, false);
 }
 
 template<typename InputDataType, typename OutputDataType>
 void FastLSTM<InputDataType, OutputDataType>::ResetCell(const size_t size)
 {
+  if (!stateful)
+  {
+    stateOutput.reset();
+    stateCell.reset();
+  }
+
   if (size == std::numeric_limits<size_t>::max())
     return;
 
@@ -123,10 +136,33 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
     ResetCell(rhoSize);
   }
 
-  gate.cols(forwardStep, forwardStep + batchStep) = input2GateWeight * input +
-      output2GateWeight * outParameter.cols(
+  // A sequence starts from the state the previous one ended in, if it is
+  // carried over, and from zero otherwise.
+  if (forwardStep == 0)
+  {
+    if (stateful && stateCell.n_cols == batchSize)
+    {
+      outParameter.cols(0, batchStep) = stateOutput;
+      initialCell = stateCell;
+    }
+    else
+    {
+      outParameter.cols(0, batchStep).zeros();
+      initialCell.reset();
+    }
+  }
+
+  // Compute all gates with a single matrix multiplication, which is written
+  // directly into the columns of the current time step.
+  gateInput.set_size(inSize + 1 + outSize, batchSize);
+  gateInput.rows(0, inSize - 1) = input;
+  gateInput.row(inSize).ones();
+  gateInput.rows(inSize + 1, inSize + outSize) = outParameter.cols(
       forwardStep, forwardStep + batchStep);
-  gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
+
+  OutputDataType gateStep(gate.colptr(forwardStep), 4 * outSize, batchSize,
+      false, true);
+  gateStep = gateWeight * gateInput;
 
   arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
       forwardStep + batchStep);
@@ -141,13 +177,20 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
   // Update the cell: cmul1 + cmul2
   // where cmul1 is input gate * hidden state and
   // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
+  if (forwardStep == 0 && initialCell.is_empty())
   {
     cell.cols(forwardStep, forwardStep + batchStep) =
         gateActivation.submat(0, forwardStep, outSize - 1,
         forwardStep + batchStep) %
         stateActivation.cols(forwardStep, forwardStep + batchStep);
   }
+  else if (forwardStep == 0)
+  {
+    cell.cols(0, batchStep) = gateActivation.submat(0, 0, outSize - 1,
+        batchStep) % stateActivation.cols(0, batchStep) +
+        gateActivation.submat(2 * outSize, 0, 3 * outSize - 1, batchStep) %
+        initialCell;
+  }
   else
   {
     cell.cols(forwardStep, forwardStep + batchStep) =
@@ -173,6 +216,14 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
   forwardStep += batchSize;
   if ((forwardStep / batchSize) == bpttSteps)
   {
+    // Keep the final state; it is only applied when the next sequence starts,
+    // since the backward pass of this one still needs the initial state.
+    if (stateful)
+    {
+      stateOutput = output;
+      stateCell = cell.cols(forwardStep - batchSize, forwardStep - 1);
+    }
+
     forwardStep = 0;
   }
 }
@@ -185,7 +236,7 @@ void FastLSTM<InputDataType, OutputDataType>::Backward(
   ErrorType gyLocal;
   if (gradientStepIdx > 0)
   {
-    gyLocal = gy + output2GateWeight.t() * prevError;
+    gyLocal = gy + gateInputError.rows(inSize + 1, inSize + outSize);
   }
   else
   {
@@ -214,6 +265,13 @@ void FastLSTM<InputDataType, OutputDataType>::Backward(
         3 * outSize - 1, backwardStep) % (1.0 - gateActivation.submat(
         2 * outSize, backwardStep - batchStep, 3 * outSize - 1, backwardStep));
   }
+  else if (!initialCell.is_empty())
+  {
+    prevError.submat(2 * outSize, 0, 3 * outSize - 1, batchStep) =
+        initialCell % cellActivationError % gateActivation.submat(2 * outSize,
+        0, 3 * outSize - 1, batchStep) % (1.0 - gateActivation.submat(
+        2 * outSize, 0, 3 * outSize - 1, batchStep));
+  }
   else
   {
     prevError.submat(2 * outSize, 0, 3 * outSize - 1, batchStep).zeros();
@@ -238,7 +296,10 @@ void FastLSTM<InputDataType, OutputDataType>::Backward(
       (1.0 - gateActivation.submat(
       outSize, backwardStep - batchStep, 2 * outSize - 1, backwardStep));
 
-  g = input2GateWeight.t() * prevError;
+  // Propagate the error to the input and the previous output with a single
+  // matrix multiplication; the latter is used by the next backward step.
+  gateInputError = gateWeight.t() * prevError;
+  g = gateInputError.rows(0, inSize - 1);
 
   backwardStep -= batchSize;
   gradientStepIdx++;
@@ -256,17 +317,17 @@ void FastLSTM<InputDataType, OutputDataType>::Gradient(
     const ErrorType& /* error */,
     GradientType& gradient)
 {
-  // Gradient of the input to gate layer.
-  gradient.submat(0, 0, input2GateWeight.n_elem - 1, 0) =
-      arma::vectorise(prevError * input.t());
-
-  gradient.submat(input2GateWeight.n_elem, 0, input2GateWeight.n_elem +
-      input2GateBias.n_elem - 1, 0) = arma::sum(prevError, 1);
-
-  // Gradient of the output to gate layer.
-  gradient.submat(input2GateWeight.n_elem + input2GateBias.n_elem, 0,
-      gradient.n_elem - 1, 0) = arma::vectorise(prevError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
+  // The gradient of the input weights, bias and output weights is computed
+  // with a single matrix multiplication, directly into the gradient.
+  gateInput.set_size(inSize + 1 + outSize, batchSize);
+  gateInput.rows(0, inSize - 1) = input;
+  gateInput.row(inSize).ones();
+  gateInput.rows(inSize + 1, inSize + outSize) = outParameter.cols(
+      gradientStep - batchStep, gradientStep);
+
+  GradientType gateGradient(gradient.memptr(), 4 * outSize,
+      inSize + 1 + outSize, false, true);
+  gateGradient = prevError * gateInput.t();
 
   if (gradientStep > batchStep)
   {
@@ -228,6 +228,25 @@ class GRU
   //! Locally-stored previous error.
   arma::mat prevError;
 
+  //! Locally-stored reset gate times the previous output, reused between time
+  //! steps.
+  arma::mat modInput;
+
+  //! Locally-stored input of the hidden state, reused between time steps.
+  arma::mat outputH;
+
+  //! Locally-stored update gate error, reused between time steps.
+  arma::mat dZt;
+
+  //! Locally-stored hidden state error, reused between time steps.
+  arma::mat dOt;
+
+  //! Locally-stored reset gate error, reused between time steps.
+  arma::mat dRt;
+
+  //! Locally-stored update and reset gate error, reused between time steps.
+  arma::mat prevErrorSubview;
+
   //! If true dropout and scaling is disabled, see notes above.
   bool deterministic;
 
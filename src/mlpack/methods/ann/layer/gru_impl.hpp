@@ -128,7 +128,7 @@ void GRU<InputDataType, OutputDataType>::Forward(
       boost::apply_visitor(outputParameterVisitor, forgetGateModule)),
       forgetGateModule);
 
-  arma::mat modInput = (boost::apply_visitor(outputParameterVisitor,
+  modInput = (boost::apply_visitor(outputParameterVisitor,
       forgetGateModule) % *prevOutput);
 
   // Pass that through the outputHidden2GateModule.
@@ -137,7 +137,7 @@ void GRU<InputDataType, OutputDataType>::Forward(
       outputHidden2GateModule);
 
   // Merge for ot.
-  arma::mat outputH = boost::apply_visitor(outputParameterVisitor,
+  outputH = boost::apply_visitor(outputParameterVisitor,
       input2GateModule).submat(2 * outSize, 0, 3 * outSize - 1, batchSize - 1) +
       boost::apply_visitor(outputParameterVisitor, outputHidden2GateModule);
 
@@ -234,13 +234,13 @@ void GRU<InputDataType, OutputDataType>::Backward(
   }
 
   // Delta zt.
-  arma::mat dZt = gyLocal % (*backIterator -
+  dZt = gyLocal % (*backIterator -
       boost::apply_visitor(outputParameterVisitor,
       hiddenStateModule));
 
   // Delta ot.
-  arma::mat dOt = gyLocal % (arma::ones<arma::mat>(outSize, batchSize) -
-      boost::apply_visitor(outputParameterVisitor, inputGateModule));
+  dOt = gyLocal % (1 - boost::apply_visitor(outputParameterVisitor,
+      inputGateModule));
 
   // Delta of input gate.
   boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
@@ -262,7 +262,7 @@ void GRU<InputDataType, OutputDataType>::Backward(
       outputHidden2GateModule);
 
   // Delta rt.
-  arma::mat dRt = boost::apply_visitor(deltaVisitor, outputHidden2GateModule) %
+  dRt = boost::apply_visitor(deltaVisitor, outputHidden2GateModule) %
       *backIterator;
 
   // Delta of forget gate.
@@ -284,8 +284,7 @@ void GRU<InputDataType, OutputDataType>::Backward(
       boost::apply_visitor(deltaVisitor, hiddenStateModule);
 
   // Get delta ht - 1 for input gate and forget gate.
-  arma::mat prevErrorSubview = prevError.submat(0, 0, 2 * outSize - 1,
-      batchSize - 1);
+  prevErrorSubview = prevError.submat(0, 0, 2 * outSize - 1, batchSize - 1);
   boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
       outputParameterVisitor, input2GateModule),
       prevErrorSubview,
@@ -52,6 +52,8 @@
 #include "multiply_merge.hpp"
 #include "padding.hpp"
 #include "parametric_relu.hpp"
+#include "quantized_convolution.hpp"
+#include "quantized_linear.hpp"
 #include "recurrent_attention.hpp"
 #include "recurrent.hpp"
 #include "reinforce_normal.hpp"
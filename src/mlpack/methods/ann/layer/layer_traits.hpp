@@ -112,6 +112,15 @@ HAS_MEM_FUNC(Loss, HasLoss);
 // can use with SFINAE to catch when a type has a Run() function.
 HAS_MEM_FUNC(Run, HasRunCheck);
 
+// This gives us a HasStatefulCheck<T, U> type (where U is a function pointer)
+// we can use with SFINAE to catch when a type has a Stateful() function.
+HAS_MEM_FUNC(Stateful, HasStatefulCheck);
+
+// This gives us a HasMixedPrecisionCheck<T, U> type (where U is a function
+// pointer) we can use with SFINAE to catch when a type has a MixedPrecision()
+// function.
+HAS_MEM_FUNC(MixedPrecision, HasMixedPrecisionCheck);
+
 // This gives us a HasBiasCheck<T, U> type (where U is a function pointer) we
 // can use with SFINAE to catch when a type has a Bias() function.
 HAS_MEM_FUNC(Bias, HasBiasCheck);
@@ -120,6 +129,10 @@ HAS_MEM_FUNC(Bias, HasBiasCheck);
 // we can use with SFINAE to catch when a type has a MaxIterations() function.
 HAS_MEM_FUNC(MaxIterations, HasMaxIterations);
 
+// This gives us a HasBatchSize<T, U> type (where U is a function pointer) we
+// can use with SFINAE to catch when a type has a BatchSize() function.
+HAS_MEM_FUNC(BatchSize, HasBatchSize);
+
 } // namespace ann
 } // namespace mlpack
 
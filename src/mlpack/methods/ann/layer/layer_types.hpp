@@ -50,6 +50,8 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 
 // Regularizers.
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
@@ -86,6 +88,16 @@ template<typename InputDataType,
 >
 class VirtualBatchNorm;
 
+template<typename InputDataType,
+         typename OutputDataType
+>
+class QuantizedLinear;
+
+template<typename InputDataType,
+         typename OutputDataType
+>
+class QuantizedConvolution;
+
 template<typename InputDataType,
          typename OutputDataType
 >
@@ -189,16 +201,18 @@ using MoreTypes = boost::variant<
         Sequential<arma::mat, arma::mat, true>*,
         Subview<arma::mat, arma::mat>*,
         VRClassReward<arma::mat, arma::mat>*,
-        VirtualBatchNorm<arma::mat, arma::mat>*
+        VirtualBatchNorm<arma::mat, arma::mat>*,
+        QuantizedLinear<arma::mat, arma::mat>*,
+        QuantizedConvolution<arma::mat, arma::mat>*
 >;
 
 template <typename... CustomLayers>
 using LayerTypes = boost::variant<
     Add<arma::mat, arma::mat>*,
     AddMerge<arma::mat, arma::mat>*,
-    AtrousConvolution<NaiveConvolution<ValidConvolution>,
-                      NaiveConvolution<FullConvolution>,
-                      NaiveConvolution<ValidConvolution>,
+    AtrousConvolution<Im2ColConvolution<ValidConvolution>,
+                      Im2ColConvolution<FullConvolution>,
+                      Im2ColConvolution<ValidConvolution>,
                       arma::mat, arma::mat>*,
     BaseLayer<LogisticFunction, arma::mat, arma::mat>*,
     BaseLayer<IdentityFunction, arma::mat, arma::mat>*,
@@ -212,12 +226,12 @@ using LayerTypes = boost::variant<
     ConcatPerformance<NegativeLogLikelihood<arma::mat, arma::mat>,
                       arma::mat, arma::mat>*,
     Constant<arma::mat, arma::mat>*,
-    Convolution<NaiveConvolution<ValidConvolution>,
-                NaiveConvolution<FullConvolution>,
-                NaiveConvolution<ValidConvolution>, arma::mat, arma::mat>*,
-    TransposedConvolution<NaiveConvolution<ValidConvolution>,
-            NaiveConvolution<ValidConvolution>,
-            NaiveConvolution<ValidConvolution>, arma::mat, arma::mat>*,
+    Convolution<Im2ColConvolution<ValidConvolution>,
+                Im2ColConvolution<FullConvolution>,
+                Im2ColConvolution<ValidConvolution>, arma::mat, arma::mat>*,
+    TransposedConvolution<Im2ColConvolution<ValidConvolution>,
+            Im2ColConvolution<ValidConvolution>,
+            Im2ColConvolution<ValidConvolution>, arma::mat, arma::mat>*,
     DropConnect<arma::mat, arma::mat>*,
     Dropout<arma::mat, arma::mat>*,
     AlphaDropout<arma::mat, arma::mat>*,
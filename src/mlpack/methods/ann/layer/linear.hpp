@@ -66,6 +66,16 @@ class Linear
   template<typename eT>
   void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
 
+  /**
+   * Feed forward pass with a sparse input, e.g. one-hot or hashed features.
+   * Only the non-zero input values take part in the product.
+   *
+   * @param input Sparse input data used for evaluating the function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::SpMat<eT>& input, arma::Mat<eT>& output);
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
@@ -92,6 +102,20 @@ class Linear
                 const arma::Mat<eT>& error,
                 arma::Mat<eT>& gradient);
 
+  /*
+   * Calculate the gradient using the output delta and a sparse input
+   * activation; only the weights of the non-zero inputs get a non-zero
+   * gradient.
+   *
+   * @param input The sparse input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  template<typename eT>
+  void Gradient(const arma::SpMat<eT>& input,
+                const arma::Mat<eT>& error,
+                arma::Mat<eT>& gradient);
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -112,6 +136,14 @@ class Linear
   //! Modify the delta.
   OutputDataType& Delta() { return delta; }
 
+  //! Get whether the products are computed in single precision.
+  bool MixedPrecision() const { return mixedPrecision; }
+  //! Modify whether the products are computed in single precision.  The
+  //! weights are still stored and updated in double precision; modifying the
+  //! setting drops their single precision copy, so that the next forward pass
+  //! converts the current weights.
+  bool& MixedPrecision() { weightFloat.reset(); return mixedPrecision; }
+
   //! Get the input size.
   size_t InputSize() const { return inSize; }
 
@@ -162,6 +194,12 @@ class Linear
 
   //! Locally-stored regularizer object.
   RegularizerType regularizer;
+
+  //! If true the products are computed in single precision.
+  bool mixedPrecision;
+
+  //! Locally-stored single precision copy of the weights.
+  arma::fmat weightFloat;
 }; // class Linear
 
 } // namespace ann
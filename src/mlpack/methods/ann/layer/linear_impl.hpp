@@ -23,7 +23,8 @@ template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 Linear<InputDataType, OutputDataType, RegularizerType>::Linear() :
     inSize(0),
-    outSize(0)
+    outSize(0),
+    mixedPrecision(false)
 {
   // Nothing to do here.
 }
@@ -36,7 +37,8 @@ Linear<InputDataType, OutputDataType, RegularizerType>::Linear(
     RegularizerType regularizer) :
     inSize(inSize),
     outSize(outSize),
-    regularizer(regularizer)
+    regularizer(regularizer),
+    mixedPrecision(false)
 {
   weights.set_size(outSize * inSize + outSize, 1);
 }
@@ -48,6 +50,7 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Reset()
   weight = arma::mat(weights.memptr(), outSize, inSize, false, false);
   bias = arma::mat(weights.memptr() + weight.n_elem,
       outSize, 1, false, false);
+  weightFloat.reset();
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -56,6 +59,29 @@ template<typename eT>
 void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
+  if (mixedPrecision)
+  {
+    // Compute the product with the single precision BLAS routines.  The
+    // weights are converted once after each change of the parameters.
+    if (weightFloat.is_empty())
+      weightFloat = arma::conv_to<arma::fmat>::from(weight);
+    output = arma::conv_to<arma::Mat<eT> >::from(weightFloat *
+        arma::conv_to<arma::fmat>::from(input));
+  }
+  else
+  {
+    output = weight * input;
+  }
+  output.each_col() += bias;
+}
+
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
+    const arma::SpMat<eT>& input, arma::Mat<eT>& output)
+{
+  // The dense-sparse product only visits the non-zero input values.
   output = weight * input;
   output.each_col() += bias;
 }
@@ -66,7 +92,18 @@ template<typename eT>
 void Linear<InputDataType, OutputDataType, RegularizerType>::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  g = weight.t() * gy;
+  if (mixedPrecision)
+  {
+    if (weightFloat.is_empty())
+      weightFloat = arma::conv_to<arma::fmat>::from(weight);
+
+    g = arma::conv_to<arma::Mat<eT> >::from(weightFloat.t() *
+        arma::conv_to<arma::fmat>::from(gy));
+  }
+  else
+  {
+    g = weight.t() * gy;
+  }
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -77,8 +114,34 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
+  if (mixedPrecision)
+  {
+    gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::conv_to<arma::Mat<eT> >
+        ::from(arma::vectorise(arma::conv_to<arma::fmat>::from(error) *
+        arma::conv_to<arma::fmat>::from(input).t()));
+  }
+  else
+  {
+    gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
+        error * input.t());
+  }
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(error, 1);
+  regularizer.Evaluate(weights, gradient);
+}
+
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
+    const arma::SpMat<eT>& input,
+    const arma::Mat<eT>& error,
+    arma::Mat<eT>& gradient)
+{
+  // Only the columns of the non-zero inputs are accumulated.
+  const arma::Mat<eT> weightGradient = error * input.t();
   gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
-      error * input.t());
+      weightGradient);
   gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
       arma::sum(error, 1);
   regularizer.Evaluate(weights, gradient);
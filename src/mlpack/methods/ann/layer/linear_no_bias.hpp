@@ -111,6 +111,14 @@ class LinearNoBias
   //! Modify the delta.
   OutputDataType& Delta() { return delta; }
 
+  //! Get whether the products are computed in single precision.
+  bool MixedPrecision() const { return mixedPrecision; }
+  //! Modify whether the products are computed in single precision.  The
+  //! weights are still stored and updated in double precision; modifying the
+  //! setting drops their single precision copy, so that the next forward pass
+  //! converts the current weights.
+  bool& MixedPrecision() { weightFloat.reset(); return mixedPrecision; }
+
   //! Get the input size.
   size_t InputSize() const { return inSize; }
 
@@ -155,6 +163,12 @@ class LinearNoBias
 
   //! Locally-stored regularizer object.
   RegularizerType regularizer;
+
+  //! If true the products are computed in single precision.
+  bool mixedPrecision;
+
+  //! Locally-stored single precision copy of the weights.
+  arma::fmat weightFloat;
 }; // class LinearNoBias
 
 } // namespace ann
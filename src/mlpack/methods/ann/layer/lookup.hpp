@@ -70,6 +70,9 @@ class Lookup
 
   /*
    * Calculate the gradient using the output delta and the input activation.
+   * The gradient is zero except for the embedding columns of the given
+   * indices; an index that appears more than once accumulates the errors of
+   * all its occurrences.
    *
    * @param input The input parameter used for calculating the gradient.
    * @param error The calculated error.
@@ -54,8 +54,12 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  gradient = arma::zeros<arma::Mat<eT> >(weights.n_rows, weights.n_cols);
-  gradient.cols(arma::conv_to<arma::uvec>::from(input) - 1) = error;
+  gradient.zeros(weights.n_rows, weights.n_cols);
+
+  // Indices that appear more than once accumulate their errors.
+  const arma::uvec columns = arma::conv_to<arma::uvec>::from(input) - 1;
+  for (size_t i = 0; i < columns.n_elem; ++i)
+    gradient.col(columns[i]) += error.col(i);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -145,6 +145,17 @@ class LSTM
   //! Modify the maximum number of steps to backpropagate through time (BPTT).
   size_t& Rho() { return rho; }
 
+  //! Get whether the state is carried over from one sequence to the next.
+  bool Stateful() const { return stateful; }
+  /**
+   * Modify whether the state is carried over from one sequence to the next.
+   * If true, the last output and cell state of a sequence are used as the
+   * initial state of the next one instead of zeros; the error is still only
+   * backpropagated through the steps of the current sequence.  ResetCell()
+   * drops the carried state only if the layer is not stateful.
+   */
+  bool& Stateful() { return stateful; }
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -172,6 +183,14 @@ class LSTM
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Copy the input, recurrent weights and biases of the four gates into
+   * gateWeight and gateBias, so that the gates of a time step can be computed
+   * with a single matrix multiplication.  The rows are ordered like the
+   * parameter blocks: output, forget, input gate and hidden layer.
+   */
+  void PackWeights();
+
   //! Locally-stored number of input units.
   size_t inSize;
 
@@ -314,11 +333,45 @@ class LSTM
   //! Locally-stored hidden layer error.
   OutputDataType hiddenError;
 
+  //! Stacked input and recurrent weights of all gates, see PackWeights().
+  OutputDataType gateWeight;
+
+  //! Stacked biases of all gates, see PackWeights().
+  OutputDataType gateBias;
+
+  //! Locally-stored stacked input and previous output of a time step.
+  OutputDataType gateInput;
+
+  //! Locally-stored stacked gate values of a time step.
+  OutputDataType gate;
+
+  //! Locally-stored stacked gate errors of a time step.
+  OutputDataType gateError;
+
+  //! Locally-stored error with respect to the stacked gate input.
+  OutputDataType gateInputError;
+
+  //! Locally-stored gradient with respect to the stacked gate weights.
+  OutputDataType gateGradient;
+
   //! Locally-stored current rho size.
   size_t rhoSize;
 
   //! Current backpropagate through time steps.
   size_t bpttSteps;
+
+  //! If true the state is carried over from one sequence to the next.
+  bool stateful;
+
+  //! Locally-stored last output of the previous sequence.
+  OutputDataType stateOutput;
+
+  //! Locally-stored last cell state of the previous sequence.
+  OutputDataType stateCell;
+
+  //! Locally-stored initial cell state of the current sequence (empty if the
+  //! sequence starts from zero).
+  OutputDataType initialCell;
 }; // class LSTM
 
 } // namespace ann
@@ -19,7 +19,8 @@ namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
 template<typename InputDataType, typename OutputDataType>
-LSTM<InputDataType, OutputDataType>::LSTM()
+LSTM<InputDataType, OutputDataType>::LSTM() :
+    stateful(false)
 {
   // Nothing to do here.
 }
@@ -37,7 +38,8 @@ LSTM<InputDataType, OutputDataType>::LSTM(
     batchStep(0),
     gradientStepIdx(0),
     rhoSize(rho),
-    bpttSteps(0)
+    bpttSteps(0),
+    stateful(false)
 {
   weights.set_size(4 * outSize * inSize + 7 * outSize +
       4 * outSize * outSize, 1);
@@ -46,6 +48,12 @@ LSTM<InputDataType, OutputDataType>::LSTM(
 template<typename InputDataType, typename OutputDataType>
 void LSTM<InputDataType, OutputDataType>::ResetCell(const size_t size)
 {
+  if (!stateful)
+  {
+    stateOutput.reset();
+    stateCell.reset();
+  }
+
   if (size == std::numeric_limits<size_t>::max())
     return;
 
@@ -159,6 +167,37 @@ void LSTM<InputDataType, OutputDataType>::Reset()
       offset, outSize, 1, false, false);
 }
 
+template<typename InputDataType, typename OutputDataType>
+void LSTM<InputDataType, OutputDataType>::PackWeights()
+{
+  gateWeight.set_size(4 * outSize, inSize + outSize);
+  gateBias.set_size(4 * outSize, 1);
+
+  // The input weights and biases of the output, forget, input gate and the
+  // hidden layer.
+  size_t offset = 0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    gateWeight.submat(i * outSize, 0, (i + 1) * outSize - 1, inSize - 1) =
+        OutputDataType(weights.memptr() + offset, outSize, inSize, false,
+        true);
+    offset += outSize * inSize;
+
+    gateBias.rows(i * outSize, (i + 1) * outSize - 1) =
+        OutputDataType(weights.memptr() + offset, outSize, 1, false, true);
+    offset += outSize;
+  }
+
+  // The recurrent weights, in the same order.
+  for (size_t i = 0; i < 4; ++i)
+  {
+    gateWeight.submat(i * outSize, inSize, (i + 1) * outSize - 1,
+        inSize + outSize - 1) = OutputDataType(weights.memptr() + offset,
+        outSize, outSize, false, true);
+    offset += outSize * outSize;
+  }
+}
+
 // Forward when cellState is not needed.
 template<typename InputDataType, typename OutputDataType>
 template<typename InputType, typename OutputType>
@@ -187,17 +226,43 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
     ResetCell(rhoSize);
   }
 
-  inputGate.cols(forwardStep, forwardStep + batchStep) = input2GateInputWeight *
-      input + output2GateInputWeight * outParameter.cols(forwardStep,
-      forwardStep + batchStep);
-  inputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateInputBias;
+  // The weights only change between sequences, so they are packed once at the
+  // start of each sequence.
+  if (forwardStep == 0 || gateWeight.is_empty())
+    PackWeights();
 
-  forgetGate.cols(forwardStep, forwardStep + batchStep) = input2GateForgetWeight
-      * input + output2GateForgetWeight * outParameter.cols(
+  // A sequence starts from the state the previous one ended in, if it is
+  // carried over, and from zero otherwise.
+  if (forwardStep == 0)
+  {
+    if (stateful && stateCell.n_cols == batchSize)
+    {
+      outParameter.cols(0, batchStep) = stateOutput;
+      initialCell = stateCell;
+    }
+    else
+    {
+      outParameter.cols(0, batchStep).zeros();
+      initialCell.reset();
+    }
+  }
+
+  // Compute the input and recurrent part of all gates with a single matrix
+  // multiplication.
+  gateInput.set_size(inSize + outSize, batchSize);
+  gateInput.rows(0, inSize - 1) = input;
+  gateInput.rows(inSize, inSize + outSize - 1) = outParameter.cols(
       forwardStep, forwardStep + batchStep);
-  forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateForgetBias;
+
+  gate = gateWeight * gateInput;
+  gate.each_col() += gateBias;
+
+  forgetGate.cols(forwardStep, forwardStep + batchStep) =
+      gate.rows(outSize, 2 * outSize - 1);
+  inputGate.cols(forwardStep, forwardStep + batchStep) =
+      gate.rows(2 * outSize, 3 * outSize - 1);
+  hiddenLayer.cols(forwardStep, forwardStep + batchStep) =
+      gate.rows(3 * outSize, 4 * outSize - 1);
 
   if (forwardStep > 0)
   {
@@ -221,6 +286,13 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
         arma::repmat(cell2GateForgetWeight, 1, batchSize) %
         cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
   }
+  else if (!initialCell.is_empty())
+  {
+    inputGate.cols(0, batchStep) += initialCell.each_col() %
+        cell2GateInputWeight;
+    forgetGate.cols(0, batchStep) += initialCell.each_col() %
+        cell2GateForgetWeight;
+  }
 
   inputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
       (1 + arma::exp(-inputGate.cols(forwardStep, forwardStep + batchStep)));
@@ -228,22 +300,21 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   forgetGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
       (1 + arma::exp(-forgetGate.cols(forwardStep, forwardStep + batchStep)));
 
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep) = input2HiddenWeight *
-      input + output2HiddenWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2HiddenBias;
-
   hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep) =
       arma::tanh(hiddenLayer.cols(forwardStep, forwardStep + batchStep));
 
-  if (forwardStep == 0)
+  if (forwardStep == 0 && initialCell.is_empty())
   {
     cell.cols(forwardStep, forwardStep + batchStep) =
         inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
         hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
   }
+  else if (forwardStep == 0)
+  {
+    cell.cols(0, batchStep) = forgetGateActivation.cols(0, batchStep) %
+        initialCell + inputGateActivation.cols(0, batchStep) %
+        hiddenLayerActivation.cols(0, batchStep);
+  }
   else
   {
     cell.cols(forwardStep, forwardStep + batchStep) =
@@ -253,14 +324,10 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
         hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
   }
 
-  outputGate.cols(forwardStep, forwardStep + batchStep) = input2GateOutputWeight
-      * input + output2GateOutputWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep) + cell.cols(forwardStep,
+  outputGate.cols(forwardStep, forwardStep + batchStep) =
+      gate.rows(0, outSize - 1) + cell.cols(forwardStep,
       forwardStep + batchStep).each_col() % cell2GateOutputWeight;
 
-  outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateOutputBias;
-
   outputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
       (1 + arma::exp(-outputGate.cols(forwardStep, forwardStep + batchStep)));
 
@@ -282,6 +349,14 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   if ((forwardStep / batchSize) == bpttSteps)
   {
     forwardStep = 0;
+
+    // Keep the final state; it is only applied when the next sequence starts,
+    // since the backward pass of this one still needs the initial state.
+    if (stateful)
+    {
+      stateOutput = output;
+      stateCell = cellState;
+    }
   }
 }
 
@@ -326,9 +401,14 @@ void LSTM<InputDataType, OutputDataType>::Backward(
       backwardStep - batchStep, backwardStep) % (1.0 -
       forgetGateActivation.cols(backwardStep - batchStep, backwardStep)));
   }
+  else if (!initialCell.is_empty())
+  {
+    forgetGateError = initialCell % cellError % (forgetGateActivation.cols(
+        0, batchStep) % (1.0 - forgetGateActivation.cols(0, batchStep)));
+  }
   else
   {
-    forgetGateError.zeros();
+    forgetGateError.zeros(outSize, batchSize);
   }
 
   inputGateError = hiddenLayerActivation.cols(backwardStep - batchStep,
@@ -344,15 +424,17 @@ void LSTM<InputDataType, OutputDataType>::Backward(
       backwardStep) % cellError + forgetGateError.each_col() %
       cell2GateForgetWeight + inputGateError.each_col() % cell2GateInputWeight;
 
-  g = input2GateInputWeight.t() * inputGateError +
-      input2HiddenWeight.t() * hiddenError +
-      input2GateForgetWeight.t() * forgetGateError +
-      input2GateOutputWeight.t() * outputGateError;
+  // Propagate the error of all gates to the input and the previous output with
+  // a single matrix multiplication.
+  gateError.set_size(4 * outSize, batchSize);
+  gateError.rows(0, outSize - 1) = outputGateError;
+  gateError.rows(outSize, 2 * outSize - 1) = forgetGateError;
+  gateError.rows(2 * outSize, 3 * outSize - 1) = inputGateError;
+  gateError.rows(3 * outSize, 4 * outSize - 1) = hiddenError;
 
-  prevError = output2GateOutputWeight.t() * outputGateError +
-      output2GateForgetWeight.t() * forgetGateError +
-      output2GateInputWeight.t() * inputGateError +
-      output2HiddenWeight.t() * hiddenError;
+  gateInputError = gateWeight.t() * gateError;
+  g = gateInputError.rows(0, inSize - 1);
+  prevError = gateInputError.rows(inSize, inSize + outSize - 1);
 
   backwardStep -= batchSize;
   gradientStepIdx++;
@@ -370,61 +452,38 @@ void LSTM<InputDataType, OutputDataType>::Gradient(
     const ErrorType& /* error */,
     GradientType& gradient)
 {
-  // Input2GateOutputWeight and input2GateOutputBias gradients.
-  gradient.submat(0, 0, input2GateOutputWeight.n_elem - 1, 0) =
-      arma::vectorise(outputGateError * input.t());
-  gradient.submat(input2GateOutputWeight.n_elem, 0,
-      input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem - 1, 0) =
-      arma::sum(outputGateError, 1);
-  size_t offset = input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem;
-
-  // Input2GateForgetWeight and input2GateForgetBias gradients.
-  gradient.submat(offset, 0, offset + input2GateForgetWeight.n_elem - 1, 0) =
-      arma::vectorise(forgetGateError * input.t());
-  gradient.submat(offset + input2GateForgetWeight.n_elem, 0,
-      offset + input2GateForgetWeight.n_elem +
-      input2GateForgetBias.n_elem - 1, 0) = arma::sum(forgetGateError, 1);
-  offset += input2GateForgetWeight.n_elem + input2GateForgetBias.n_elem;
-
-  // Input2GateInputWeight and input2GateInputBias gradients.
-  gradient.submat(offset, 0, offset + input2GateInputWeight.n_elem - 1, 0) =
-      arma::vectorise(inputGateError * input.t());
-  gradient.submat(offset + input2GateInputWeight.n_elem, 0,
-      offset + input2GateInputWeight.n_elem +
-      input2GateInputBias.n_elem - 1, 0) = arma::sum(inputGateError, 1);
-  offset += input2GateInputWeight.n_elem + input2GateInputBias.n_elem;
-
-  // Input2HiddenWeight and input2HiddenBias gradients.
-  gradient.submat(offset, 0, offset + input2HiddenWeight.n_elem - 1, 0) =
-      arma::vectorise(hiddenError * input.t());
-  gradient.submat(offset + input2HiddenWeight.n_elem, 0,
-      offset + input2HiddenWeight.n_elem + input2HiddenBias.n_elem - 1, 0) =
-      arma::sum(hiddenError, 1);
-  offset += input2HiddenWeight.n_elem + input2HiddenBias.n_elem;
-
-  // Output2GateOutputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateOutputWeight.n_elem - 1, 0) =
-      arma::vectorise(outputGateError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2GateOutputWeight.n_elem;
-
-  // Output2GateForgetWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateForgetWeight.n_elem - 1, 0) =
-      arma::vectorise(forgetGateError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2GateForgetWeight.n_elem;
-
-  // Output2GateInputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateInputWeight.n_elem - 1, 0) =
-      arma::vectorise(inputGateError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2GateInputWeight.n_elem;
+  // Compute the gradient of the input and recurrent weights of all gates with
+  // a single matrix multiplication, using the gate errors of Backward().
+  gateInput.set_size(inSize + outSize, batchSize);
+  gateInput.rows(0, inSize - 1) = input;
+  gateInput.rows(inSize, inSize + outSize - 1) = outParameter.cols(
+      gradientStep - batchStep, gradientStep);
+
+  gateGradient = gateError * gateInput.t();
+
+  // Scatter the input weight and bias gradients of the output, forget, input
+  // gate and the hidden layer into the parameter blocks.
+  size_t offset = 0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    gradient.submat(offset, 0, offset + outSize * inSize - 1, 0) =
+        arma::vectorise(gateGradient.submat(i * outSize, 0,
+        (i + 1) * outSize - 1, inSize - 1));
+    offset += outSize * inSize;
+
+    gradient.submat(offset, 0, offset + outSize - 1, 0) = arma::sum(
+        gateError.rows(i * outSize, (i + 1) * outSize - 1), 1);
+    offset += outSize;
+  }
 
-  // Output2HiddenWeight gradients.
-  gradient.submat(offset, 0, offset + output2HiddenWeight.n_elem - 1, 0) =
-      arma::vectorise(hiddenError *
-      outParameter.cols(gradientStep - batchStep, gradientStep).t());
-  offset += output2HiddenWeight.n_elem;
+  // The recurrent weight gradients, in the same order.
+  for (size_t i = 0; i < 4; ++i)
+  {
+    gradient.submat(offset, 0, offset + outSize * outSize - 1, 0) =
+        arma::vectorise(gateGradient.submat(i * outSize, inSize,
+        (i + 1) * outSize - 1, inSize + outSize - 1));
+    offset += outSize * outSize;
+  }
 
   // Cell2GateOutputWeight gradients.
   gradient.submat(offset, 0, offset + cell2GateOutputWeight.n_elem - 1, 0) =
@@ -445,6 +504,14 @@ void LSTM<InputDataType, OutputDataType>::Gradient(
                   cell.cols((gradientStep - batchSize) - batchStep,
                             (gradientStep - batchSize)), 1);
   }
+  else if (!initialCell.is_empty())
+  {
+    gradient.submat(offset, 0, offset + cell2GateForgetWeight.n_elem - 1, 0) =
+        arma::sum(forgetGateError % initialCell, 1);
+    gradient.submat(offset + cell2GateForgetWeight.n_elem, 0, offset +
+        cell2GateForgetWeight.n_elem + cell2GateInputWeight.n_elem - 1, 0) =
+        arma::sum(inputGateError % initialCell, 1);
+  }
   else
   {
     gradient.submat(offset, 0, offset +
@@ -185,21 +185,27 @@ class MaxPooling
       for (size_t i = 0, rowidx = 0; i < output.n_rows;
           ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
+        // Scan the window in place and in column-major order, so that ties
+        // resolve to the first maximum just like index_max() does.
+        size_t maxIndex = rowidx + colidx * input.n_rows;
+        eT maxValue = input(maxIndex);
+        for (size_t c = colidx; c < colidx + kernelHeight - offset; ++c)
+        {
+          const eT* column = input.colptr(c);
+          for (size_t r = rowidx; r < rowidx + kernelWidth - offset; ++r)
+          {
+            if (column[r] > maxValue)
+            {
+              maxValue = column[r];
+              maxIndex = r + c * input.n_rows;
+            }
+          }
+        }
 
-        const size_t idx = pooling.Pooling(subInput);
-        output(i, j) = subInput(idx);
+        output(i, j) = maxValue;
 
         if (!deterministic)
-        {
-          arma::Mat<size_t> subIndices = indices(arma::span(rowidx,
-              rowidx + kernelWidth - 1 - offset),
-              arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-          poolingIndices(i, j) = subIndices(idx);
-        }
+          poolingIndices(i, j) = maxIndex;
       }
     }
   }
@@ -214,11 +220,11 @@ class MaxPooling
   template<typename eT>
   void Unpooling(const arma::Mat<eT>& error,
                  arma::Mat<eT>& output,
-                 arma::Mat<eT>& poolingIndices)
+                 const arma::Mat<eT>& poolingIndices)
   {
     for (size_t i = 0; i < poolingIndices.n_elem; ++i)
     {
-      output(poolingIndices(i)) += error(i);
+      output((size_t) poolingIndices(i)) += error(i);
     }
   }
 
@@ -243,9 +249,6 @@ class MaxPooling
   //! Locally-stored number of output channels.
   size_t outSize;
 
-  //! Locally-stored reset parameter used to initialize the module once.
-  bool reset;
-
   //! Locally-stored input width.
   size_t inputWidth;
 
@@ -276,9 +279,6 @@ class MaxPooling
   //! Locally-stored transformed output parameter.
   arma::cube gTemp;
 
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
-
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -288,12 +288,6 @@ class MaxPooling
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored indices matrix parameter.
-  arma::Mat<size_t> indices;
-
-  //! Locally-stored indices column parameter.
-  arma::Col<size_t> indicesCol;
-
   //! Locally-stored pooling indicies.
   std::vector<arma::cube> poolingIndices;
 }; // class MaxPooling
@@ -39,7 +39,6 @@ MaxPooling<InputDataType, OutputDataType>::MaxPooling(
     floor(floor),
     inSize(0),
     outSize(0),
-    reset(false),
     inputWidth(0),
     inputHeight(0),
     outputWidth(0),
@@ -86,28 +85,26 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
     poolingIndices.push_back(outputTemp);
   }
 
-  if (!reset)
+  // Every (sample, channel) slice is pooled independently; the slices are
+  // wrapped without copying so that each thread works on its own memory.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) inputTemp.n_slices; ++s)
   {
-    size_t elements = inputWidth * inputHeight;
-    indicesCol = arma::linspace<arma::Col<size_t> >(0, (elements - 1),
-        elements);
+    const arma::Mat<eT> inputSlice(inputTemp.slice_memptr(s),
+        inputTemp.n_rows, inputTemp.n_cols, false, true);
+    arma::Mat<eT> outputSlice(outputTemp.slice_memptr(s), outputTemp.n_rows,
+        outputTemp.n_cols, false, true);
 
-    indices = arma::Mat<size_t>(indicesCol.memptr(), inputWidth, inputHeight);
-
-    reset = true;
-  }
-
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
-  {
     if (!deterministic)
     {
-      PoolingOperation(inputTemp.slice(s), outputTemp.slice(s),
-        poolingIndices.back().slice(s));
+      arma::Mat<eT> indicesSlice(poolingIndices.back().slice_memptr(s),
+          outputTemp.n_rows, outputTemp.n_cols, false, true);
+      PoolingOperation(inputSlice, outputSlice, indicesSlice);
     }
     else
     {
-      PoolingOperation(inputTemp.slice(s), outputTemp.slice(s),
-          inputTemp.slice(s));
+      // The indices are not stored in deterministic mode.
+      PoolingOperation(inputSlice, outputSlice, outputSlice);
     }
   }
 
@@ -130,10 +127,17 @@ void MaxPooling<InputDataType, OutputDataType>::Backward(
   gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
       inputTemp.n_cols, inputTemp.n_slices);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) mappedError.n_slices; ++s)
   {
-    Unpooling(mappedError.slice(s), gTemp.slice(s),
-        poolingIndices.back().slice(s));
+    const arma::Mat<eT> errorSlice(mappedError.slice_memptr(s),
+        mappedError.n_rows, mappedError.n_cols, false, true);
+    arma::Mat<eT> gSlice(gTemp.slice_memptr(s), gTemp.n_rows, gTemp.n_cols,
+        false, true);
+    const arma::Mat<eT> indicesSlice(poolingIndices.back().slice_memptr(s),
+        mappedError.n_rows, mappedError.n_cols, false, true);
+
+    Unpooling(errorSlice, gSlice, indicesSlice);
   }
 
   poolingIndices.pop_back();
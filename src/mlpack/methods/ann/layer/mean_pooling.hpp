@@ -162,11 +162,11 @@ class MeanPooling
       for (size_t i = 0, rowidx = 0; i < output.n_rows;
            ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
+        // Sum over the window in place instead of copying it out.
+        output(i, j) = arma::accu(input(
             arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-        output(i, j) = arma::mean(arma::mean(subInput));
+            arma::span(colidx, colidx + kernelHeight - 1 - offset))) /
+            ((kernelWidth - offset) * (kernelHeight - offset));
       }
     }
   }
@@ -185,19 +185,14 @@ class MeanPooling
     const size_t rStep = input.n_rows / error.n_rows - offset;
     const size_t cStep = input.n_cols / error.n_cols - offset;
 
-    arma::Mat<eT> unpooledError;
     for (size_t j = 0; j < input.n_cols - cStep; j += cStep)
     {
       for (size_t i = 0; i < input.n_rows - rStep; i += rStep)
       {
-        const arma::Mat<eT>& inputArea = input(arma::span(i, i + rStep - 1),
-            arma::span(j, j + cStep - 1));
-
-        unpooledError = arma::Mat<eT>(inputArea.n_rows, inputArea.n_cols);
-        unpooledError.fill(error(i / rStep, j / cStep) / inputArea.n_elem);
-
+        // Spread the error evenly over the area without a temporary matrix.
         output(arma::span(i, i + rStep - 1 - offset),
-            arma::span(j, j + cStep - 1 - offset)) += unpooledError;
+            arma::span(j, j + cStep - 1 - offset)) +=
+            error(i / rStep, j / cStep) / (rStep * cStep);
       }
     }
   }
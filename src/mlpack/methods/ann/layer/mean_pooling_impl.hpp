@@ -83,8 +83,18 @@ void MeanPooling<InputDataType, OutputDataType>::Forward(
   outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
       batchSize * inSize);
 
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
-    Pooling(inputTemp.slice(s), outputTemp.slice(s));
+  // Every (sample, channel) slice is pooled independently; the slices are
+  // wrapped without copying so that each thread works on its own memory.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) inputTemp.n_slices; ++s)
+  {
+    const arma::Mat<eT> inputSlice(inputTemp.slice_memptr(s),
+        inputTemp.n_rows, inputTemp.n_cols, false, true);
+    arma::Mat<eT> outputSlice(outputTemp.slice_memptr(s), outputTemp.n_rows,
+        outputTemp.n_cols, false, true);
+
+    Pooling(inputSlice, outputSlice);
+  }
 
   output = arma::Mat<eT>(outputTemp.memptr(), outputTemp.n_elem / batchSize,
       batchSize);
@@ -107,9 +117,17 @@ void MeanPooling<InputDataType, OutputDataType>::Backward(
   gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
       inputTemp.n_cols, inputTemp.n_slices);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) mappedError.n_slices; ++s)
   {
-    Unpooling(inputTemp.slice(s), mappedError.slice(s), gTemp.slice(s));
+    const arma::Mat<eT> inputSlice(inputTemp.slice_memptr(s),
+        inputTemp.n_rows, inputTemp.n_cols, false, true);
+    const arma::Mat<eT> errorSlice(mappedError.slice_memptr(s),
+        mappedError.n_rows, mappedError.n_cols, false, true);
+    arma::Mat<eT> gSlice(gTemp.slice_memptr(s), gTemp.n_rows, gTemp.n_cols,
+        false, true);
+
+    Unpooling(inputSlice, errorSlice, gSlice);
   }
 
   g = arma::mat(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
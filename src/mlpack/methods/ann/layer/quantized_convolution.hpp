@@ -0,0 +1,283 @@
+/**
+ * @file quantized_convolution.hpp
+ *
+ * Definition of the QuantizedConvolution class, an inference only convolution
+ * layer that stores its filters as 8-bit integers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+
+#include "padding.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the QuantizedConvolution class. The QuantizedConvolution
+ * class is the int8 counterpart of the Convolution layer and is meant for
+ * inference only. The filters of each output map are quantized symmetrically
+ * with their own scale, and the input is quantized with a single scale that is
+ * calibrated on sample data, e.g. by Quantize(). The forward pass lowers the
+ * (padded) input of the whole batch to a patch matrix with
+ * Im2ColConvolution::Im2Col(), and then accumulates the products of the 8-bit
+ * patches and filters in 32-bit integers, like QuantizedLinear.
+ *
+ * The layer has no trainable parameters; Backward() uses the dequantized
+ * filters so that the error can still be propagated through the layer.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class QuantizedConvolution
+{
+ public:
+  //! Create the QuantizedConvolution object.
+  QuantizedConvolution();
+
+  /**
+   * Create the QuantizedConvolution object by quantizing the given filters.
+   *
+   * @param weight Filters of size (kernelWidth * kernelHeight * inSize) x
+   *     outSize; every column holds the filters of one output map, stored like
+   *     the weights of the Convolution layer.
+   * @param bias Bias of size (outSize x 1), or an empty matrix if the layer has
+   *     no bias term.
+   * @param inSize The number of input maps.
+   * @param kernelWidth Width of the filter/kernel.
+   * @param kernelHeight Height of the filter/kernel.
+   * @param strideWidth Stride of filter application in the x direction.
+   * @param strideHeight Stride of filter application in the y direction.
+   * @param padW A two-value tuple indicating padding widths of the input.
+   *     First value is padding at left side. Second value is padding on right
+   *     side.
+   * @param padH A two-value tuple indicating padding heights of the input.
+   *     First value is padding at top. Second value is padding on bottom.
+   * @param inputWidth The width of the input data.
+   * @param inputHeight The height of the input data.
+   * @param inputScale Scale used to quantize the input; input values outside
+   *     of [-127 * inputScale, 127 * inputScale] are saturated.
+   */
+  QuantizedConvolution(const arma::mat& weight,
+                       const arma::mat& bias,
+                       const size_t inSize,
+                       const size_t kernelWidth,
+                       const size_t kernelHeight,
+                       const size_t strideWidth,
+                       const size_t strideHeight,
+                       const std::tuple<size_t, size_t>& padW,
+                       const std::tuple<size_t, size_t>& padH,
+                       const size_t inputWidth,
+                       const size_t inputHeight,
+                       const double inputScale);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The propagated input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& /* input */,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType const& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the input width.
+  size_t const& InputWidth() const { return inputWidth; }
+  //! Modify input the width.
+  size_t& InputWidth() { return inputWidth; }
+
+  //! Get the input height.
+  size_t const& InputHeight() const { return inputHeight; }
+  //! Modify the input height.
+  size_t& InputHeight() { return inputHeight; }
+
+  //! Get the output width.
+  size_t const& OutputWidth() const { return outputWidth; }
+  //! Modify the output width.
+  size_t& OutputWidth() { return outputWidth; }
+
+  //! Get the output height.
+  size_t const& OutputHeight() const { return outputHeight; }
+  //! Modify the output height.
+  size_t& OutputHeight() { return outputHeight; }
+
+  //! Get the number of input maps.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the number of output maps.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the kernel width.
+  size_t KernelWidth() const { return kernelWidth; }
+
+  //! Get the kernel height.
+  size_t KernelHeight() const { return kernelHeight; }
+
+  //! Get the stride width.
+  size_t StrideWidth() const { return strideWidth; }
+
+  //! Get the stride height.
+  size_t StrideHeight() const { return strideHeight; }
+
+  //! Get the quantized filters, stored output map by output map.
+  const std::vector<int8_t>& QuantizedWeight() const { return weights; }
+
+  //! Get the per output map weight scales.
+  const arma::vec& Scales() const { return scales; }
+
+  //! Get the input scale.
+  double InputScale() const { return inputScale; }
+
+  //! Get the bias (empty if the layer has no bias term).
+  const arma::mat& Bias() const { return bias; }
+
+  //! Get the dequantized filters of size (kernelWidth * kernelHeight * inSize)
+  //! x outSize.
+  arma::mat Weight() const;
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Round and saturate the given value to the int8 range [-127, 127].
+  static int8_t Saturate(const double value);
+
+  //! Return whether the input is padded.
+  bool Padded() const
+  {
+    return padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0;
+  }
+
+  //! Locally-stored number of input maps.
+  size_t inSize;
+
+  //! Locally-stored number of output maps.
+  size_t outSize;
+
+  //! Locally-stored number of points in the last batch.
+  size_t batchSize;
+
+  //! Locally-stored filter/kernel width.
+  size_t kernelWidth;
+
+  //! Locally-stored filter/kernel height.
+  size_t kernelHeight;
+
+  //! Locally-stored stride of the filter in x-direction.
+  size_t strideWidth;
+
+  //! Locally-stored stride of the filter in y-direction.
+  size_t strideHeight;
+
+  //! Locally-stored left-side padding width.
+  size_t padWLeft;
+
+  //! Locally-stored right-side padding width.
+  size_t padWRight;
+
+  //! Locally-stored bottom padding height.
+  size_t padHBottom;
+
+  //! Locally-stored top padding height.
+  size_t padHTop;
+
+  //! Locally-stored input width.
+  size_t inputWidth;
+
+  //! Locally-stored input height.
+  size_t inputHeight;
+
+  //! Locally-stored output width.
+  size_t outputWidth;
+
+  //! Locally-stored output height.
+  size_t outputHeight;
+
+  //! Locally-stored quantized filters, one contiguous filter bank per output
+  //! map.
+  std::vector<int8_t> weights;
+
+  //! Locally-stored per output map weight scales.
+  arma::vec scales;
+
+  //! Locally-stored bias (empty if the layer has no bias term).
+  arma::mat bias;
+
+  //! Locally-stored input scale.
+  double inputScale;
+
+  //! Locally-stored padded input.
+  arma::cube inputPaddedTemp;
+
+  //! Locally-stored unrolled input patches.
+  arma::mat inputColsTemp;
+
+  //! Locally-stored quantized input patches, reused between passes.
+  std::vector<int8_t> inputQuantized;
+
+  //! Locally-stored padding layer.
+  ann::Padding<> padding;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class QuantizedConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_convolution_impl.hpp"
+
+#endif
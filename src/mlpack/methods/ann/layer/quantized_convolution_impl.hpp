@@ -0,0 +1,258 @@
+/**
+ * @file quantized_convolution_impl.hpp
+ *
+ * Implementation of the QuantizedConvolution class, an inference only
+ * convolution layer that stores its filters as 8-bit integers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedConvolution<InputDataType, OutputDataType>::QuantizedConvolution() :
+    inSize(0),
+    outSize(0),
+    batchSize(0),
+    kernelWidth(0),
+    kernelHeight(0),
+    strideWidth(1),
+    strideHeight(1),
+    padWLeft(0),
+    padWRight(0),
+    padHBottom(0),
+    padHTop(0),
+    inputWidth(0),
+    inputHeight(0),
+    outputWidth(0),
+    outputHeight(0),
+    inputScale(1.0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedConvolution<InputDataType, OutputDataType>::QuantizedConvolution(
+    const arma::mat& weight,
+    const arma::mat& bias,
+    const size_t inSize,
+    const size_t kernelWidth,
+    const size_t kernelHeight,
+    const size_t strideWidth,
+    const size_t strideHeight,
+    const std::tuple<size_t, size_t>& padW,
+    const std::tuple<size_t, size_t>& padH,
+    const size_t inputWidth,
+    const size_t inputHeight,
+    const double inputScale) :
+    inSize(inSize),
+    outSize(weight.n_cols),
+    batchSize(0),
+    kernelWidth(kernelWidth),
+    kernelHeight(kernelHeight),
+    strideWidth(strideWidth),
+    strideHeight(strideHeight),
+    padWLeft(std::get<0>(padW)),
+    padWRight(std::get<1>(padW)),
+    padHBottom(std::get<1>(padH)),
+    padHTop(std::get<0>(padH)),
+    inputWidth(inputWidth),
+    inputHeight(inputHeight),
+    outputWidth(0),
+    outputHeight(0),
+    bias(bias),
+    inputScale(inputScale > 0 ? inputScale : 1.0),
+    padding(padWLeft, padWRight, padHTop, padHBottom)
+{
+  const size_t filterSize = kernelWidth * kernelHeight * inSize;
+  if (weight.n_rows != filterSize)
+  {
+    Log::Fatal << "QuantizedConvolution::QuantizedConvolution(): the weight "
+        << "matrix has " << weight.n_rows << " rows, but the filters of "
+        << inSize << " input maps have " << filterSize << " elements!"
+        << std::endl;
+  }
+
+  if (!bias.is_empty() && bias.n_elem != outSize)
+  {
+    Log::Fatal << "QuantizedConvolution::QuantizedConvolution(): the bias has "
+        << bias.n_elem << " elements, but the weight matrix has " << outSize
+        << " columns!" << std::endl;
+  }
+
+  // Quantize the filters of each output map with their own scale, like the
+  // output channels of QuantizedLinear.
+  weights.resize(outSize * filterSize);
+  scales.set_size(outSize);
+  for (size_t o = 0; o < outSize; ++o)
+  {
+    const double maxWeight = arma::max(arma::abs(weight.col(o)));
+    scales[o] = (maxWeight > 0) ? maxWeight / 127.0 : 1.0;
+
+    for (size_t i = 0; i < filterSize; ++i)
+      weights[o * filterSize + i] = Saturate(weight(i, o) / scales[o]);
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedConvolution<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  batchSize = input.n_cols;
+  arma::Cube<eT> inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
+      inputWidth, inputHeight, inSize * batchSize, false, false);
+
+  // Lower the whole batch to a patch matrix, one patch per column.
+  if (Padded())
+  {
+    inputPaddedTemp.set_size(inputWidth + padWLeft + padWRight,
+        inputHeight + padHTop + padHBottom, inputTemp.n_slices);
+
+    for (size_t i = 0; i < inputTemp.n_slices; ++i)
+      padding.Forward(inputTemp.slice(i), inputPaddedTemp.slice(i));
+
+    Im2ColConvolution<ValidConvolution>::Im2Col(inputPaddedTemp, inSize,
+        kernelWidth, kernelHeight, inputColsTemp, strideWidth, strideHeight);
+  }
+  else
+  {
+    Im2ColConvolution<ValidConvolution>::Im2Col(inputTemp, inSize,
+        kernelWidth, kernelHeight, inputColsTemp, strideWidth, strideHeight);
+  }
+
+  outputWidth = (inputWidth + padWLeft + padWRight - kernelWidth) /
+      strideWidth + 1;
+  outputHeight = (inputHeight + padHTop + padHBottom - kernelHeight) /
+      strideHeight + 1;
+
+  inputQuantized.resize(inputColsTemp.n_elem);
+  for (size_t i = 0; i < inputColsTemp.n_elem; ++i)
+    inputQuantized[i] = Saturate(inputColsTemp[i] / inputScale);
+
+  // Every column of the output holds the output maps of one point, one after
+  // another, and every map is stored in the order of the patches.
+  const size_t filterSize = inputColsTemp.n_rows;
+  const size_t patches = outputWidth * outputHeight;
+  output.set_size(patches * outSize, batchSize);
+
+  // Both operands of each dot product are contiguous, so that the inner loop
+  // can be vectorized by the compiler.
+  #pragma omp parallel for if (inputColsTemp.n_cols > 1)
+  for (omp_size_t j = 0; j < (omp_size_t) inputColsTemp.n_cols; ++j)
+  {
+    const int8_t* x = inputQuantized.data() + j * filterSize;
+    const size_t point = j / patches;
+    const size_t patch = j % patches;
+    for (size_t o = 0; o < outSize; ++o)
+    {
+      const int8_t* w = weights.data() + o * filterSize;
+
+      int32_t sum = 0;
+      for (size_t i = 0; i < filterSize; ++i)
+        sum += int32_t(w[i]) * int32_t(x[i]);
+
+      output(o * patches + patch, point) = sum * scales[o] * inputScale +
+          (bias.is_empty() ? 0.0 : bias[o]);
+    }
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedConvolution<InputDataType, OutputDataType>::Backward(
+    const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
+{
+  // Collect the error of all points as a (patches * batchSize) x outSize
+  // matrix, so that the error of all patches is W * error^T.
+  const size_t patches = outputWidth * outputHeight;
+  arma::Mat<eT> errorMat(patches * batchSize, outSize);
+  for (size_t b = 0; b < batchSize; ++b)
+  {
+    errorMat.rows(b * patches, (b + 1) * patches - 1) = arma::Mat<eT>(
+        ((arma::Mat<eT>&) gy).colptr(b), patches, outSize, false, true);
+  }
+
+  const arma::Mat<eT> errorCols = Weight() * errorMat.t();
+
+  g.set_size(inputWidth * inputHeight * inSize, batchSize);
+  arma::Cube<eT> gTemp(g.memptr(), inputWidth, inputHeight,
+      inSize * batchSize, false, true);
+
+  if (Padded())
+  {
+    arma::Cube<eT> gPaddedTemp(inputWidth + padWLeft + padWRight,
+        inputHeight + padHTop + padHBottom, inSize * batchSize);
+    Im2ColConvolution<ValidConvolution>::Col2Im(errorCols, inSize,
+        kernelWidth, kernelHeight, gPaddedTemp, strideWidth, strideHeight);
+
+    gTemp = gPaddedTemp.tube(padWLeft, padHTop, padWLeft + inputWidth - 1,
+        padHTop + inputHeight - 1);
+  }
+  else
+  {
+    Im2ColConvolution<ValidConvolution>::Col2Im(errorCols, inSize,
+        kernelWidth, kernelHeight, gTemp, strideWidth, strideHeight);
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+arma::mat QuantizedConvolution<InputDataType, OutputDataType>::Weight() const
+{
+  const size_t filterSize = kernelWidth * kernelHeight * inSize;
+  arma::mat weight(filterSize, outSize);
+  for (size_t o = 0; o < outSize; ++o)
+    for (size_t i = 0; i < filterSize; ++i)
+      weight(i, o) = weights[o * filterSize + i] * scales[o];
+
+  return weight;
+}
+
+template<typename InputDataType, typename OutputDataType>
+int8_t QuantizedConvolution<InputDataType, OutputDataType>::Saturate(
+    const double value)
+{
+  return (int8_t) std::max(-127.0, std::min(127.0, std::round(value)));
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void QuantizedConvolution<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(inSize);
+  ar & BOOST_SERIALIZATION_NVP(outSize);
+  ar & BOOST_SERIALIZATION_NVP(kernelWidth);
+  ar & BOOST_SERIALIZATION_NVP(kernelHeight);
+  ar & BOOST_SERIALIZATION_NVP(strideWidth);
+  ar & BOOST_SERIALIZATION_NVP(strideHeight);
+  ar & BOOST_SERIALIZATION_NVP(padWLeft);
+  ar & BOOST_SERIALIZATION_NVP(padWRight);
+  ar & BOOST_SERIALIZATION_NVP(padHBottom);
+  ar & BOOST_SERIALIZATION_NVP(padHTop);
+  ar & BOOST_SERIALIZATION_NVP(inputWidth);
+  ar & BOOST_SERIALIZATION_NVP(inputHeight);
+  ar & BOOST_SERIALIZATION_NVP(outputWidth);
+  ar & BOOST_SERIALIZATION_NVP(outputHeight);
+  ar & BOOST_SERIALIZATION_NVP(weights);
+  ar & BOOST_SERIALIZATION_NVP(scales);
+  ar & BOOST_SERIALIZATION_NVP(bias);
+  ar & BOOST_SERIALIZATION_NVP(inputScale);
+
+  if (Archive::is_loading::value)
+    padding = ann::Padding<>(padWLeft, padWRight, padHTop, padHBottom);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
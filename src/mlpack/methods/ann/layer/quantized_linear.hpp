@@ -0,0 +1,167 @@
+/**
+ * @file quantized_linear.hpp
+ *
+ * Definition of the QuantizedLinear class, an inference only fully-connected
+ * layer that stores its weights as 8-bit integers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the QuantizedLinear class. The QuantizedLinear class is
+ * the int8 counterpart of the Linear and LinearNoBias layers and is meant for
+ * inference only. Each row of the weight matrix is quantized symmetrically
+ * with its own scale (per output channel), and the input is quantized with a
+ * single scale that is calibrated on sample data, e.g. by Quantize(). The
+ * forward pass accumulates the products of the 8-bit values in 32-bit
+ * integers, and rescales the result afterwards.
+ *
+ * The layer has no trainable parameters; Backward() uses the dequantized
+ * weights so that the error can still be propagated through the layer.
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class QuantizedLinear
+{
+ public:
+  //! Create the QuantizedLinear object.
+  QuantizedLinear();
+
+  /**
+   * Create the QuantizedLinear object by quantizing the given weights.
+   *
+   * @param weight Weight matrix of size (output units x input units).
+   * @param bias Bias of size (output units x 1), or an empty matrix if the
+   *     layer has no bias term.
+   * @param inputScale Scale used to quantize the input; input values outside
+   *     of [-127 * inputScale, 127 * inputScale] are saturated.
+   */
+  QuantizedLinear(const arma::mat& weight,
+                  const arma::mat& bias,
+                  const double inputScale);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The propagated input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& /* input */,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType const& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the quantized weights, stored row by row.
+  const std::vector<int8_t>& QuantizedWeight() const { return weights; }
+
+  //! Get the per output channel weight scales.
+  const arma::vec& Scales() const { return scales; }
+
+  //! Get the input scale.
+  double InputScale() const { return inputScale; }
+
+  //! Get the bias (empty if the layer has no bias term).
+  const arma::mat& Bias() const { return bias; }
+
+  //! Get the dequantized weights of size (output units x input units).
+  arma::mat Weight() const;
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Round and saturate the given value to the int8 range [-127, 127].
+  static int8_t Saturate(const double value);
+
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored quantized weights, one contiguous row per output unit.
+  std::vector<int8_t> weights;
+
+  //! Locally-stored per output channel weight scales.
+  arma::vec scales;
+
+  //! Locally-stored bias (empty if the layer has no bias term).
+  arma::mat bias;
+
+  //! Locally-stored input scale.
+  double inputScale;
+
+  //! Locally-stored quantized input, reused between passes.
+  std::vector<int8_t> inputQuantized;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class QuantizedLinear
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
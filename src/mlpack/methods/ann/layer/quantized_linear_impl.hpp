@@ -0,0 +1,137 @@
+/**
+ * @file quantized_linear_impl.hpp
+ *
+ * Implementation of the QuantizedLinear class, an inference only
+ * fully-connected layer that stores its weights as 8-bit integers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedLinear<InputDataType, OutputDataType>::QuantizedLinear() :
+    inSize(0),
+    outSize(0),
+    inputScale(1.0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+QuantizedLinear<InputDataType, OutputDataType>::QuantizedLinear(
+    const arma::mat& weight,
+    const arma::mat& bias,
+    const double inputScale) :
+    inSize(weight.n_cols),
+    outSize(weight.n_rows),
+    bias(bias),
+    inputScale(inputScale > 0 ? inputScale : 1.0)
+{
+  if (!bias.is_empty() && bias.n_elem != outSize)
+  {
+    Log::Fatal << "QuantizedLinear::QuantizedLinear(): the bias has "
+        << bias.n_elem << " elements, but the weight matrix has " << outSize
+        << " rows!" << std::endl;
+  }
+
+  // Quantize each output channel with its own scale, so that channels with
+  // small weights don't lose their precision to channels with large ones.
+  weights.resize(outSize * inSize);
+  scales.set_size(outSize);
+  for (size_t o = 0; o < outSize; ++o)
+  {
+    const double maxWeight = arma::max(arma::abs(weight.row(o)));
+    scales[o] = (maxWeight > 0) ? maxWeight / 127.0 : 1.0;
+
+    for (size_t i = 0; i < inSize; ++i)
+      weights[o * inSize + i] = Saturate(weight(o, i) / scales[o]);
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedLinear<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  inputQuantized.resize(input.n_elem);
+  for (size_t i = 0; i < input.n_elem; ++i)
+    inputQuantized[i] = Saturate(input[i] / inputScale);
+
+  output.set_size(outSize, input.n_cols);
+
+  // Both operands of each dot product are contiguous, so that the inner loop
+  // can be vectorized by the compiler.  The sum of 127 * 127 * inSize fits
+  // into a 32-bit integer for any reasonable number of input units.
+  #pragma omp parallel for if (input.n_cols > 1)
+  for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+  {
+    const int8_t* x = inputQuantized.data() + j * inSize;
+    for (size_t o = 0; o < outSize; ++o)
+    {
+      const int8_t* w = weights.data() + o * inSize;
+
+      int32_t sum = 0;
+      for (size_t i = 0; i < inSize; ++i)
+        sum += int32_t(w[i]) * int32_t(x[i]);
+
+      output(o, j) = sum * scales[o] * inputScale;
+    }
+  }
+
+  if (!bias.is_empty())
+    output.each_col() += bias.col(0);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void QuantizedLinear<InputDataType, OutputDataType>::Backward(
+    const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
+{
+  g = Weight().t() * gy;
+}
+
+template<typename InputDataType, typename OutputDataType>
+arma::mat QuantizedLinear<InputDataType, OutputDataType>::Weight() const
+{
+  arma::mat weight(outSize, inSize);
+  for (size_t o = 0; o < outSize; ++o)
+    for (size_t i = 0; i < inSize; ++i)
+      weight(o, i) = weights[o * inSize + i] * scales[o];
+
+  return weight;
+}
+
+template<typename InputDataType, typename OutputDataType>
+int8_t QuantizedLinear<InputDataType, OutputDataType>::Saturate(
+    const double value)
+{
+  return (int8_t) std::max(-127.0, std::min(127.0, std::round(value)));
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void QuantizedLinear<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(inSize);
+  ar & BOOST_SERIALIZATION_NVP(outSize);
+  ar & BOOST_SERIALIZATION_NVP(weights);
+  ar & BOOST_SERIALIZATION_NVP(scales);
+  ar & BOOST_SERIALIZATION_NVP(bias);
+  ar & BOOST_SERIALIZATION_NVP(inputScale);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
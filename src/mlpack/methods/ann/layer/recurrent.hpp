@@ -108,6 +108,14 @@ class Recurrent
                 const arma::Mat<eT>& error,
                 arma::Mat<eT>& /* gradient */);
 
+  /*
+   * Resets the cell to accept a new input. This breaks the BPTT chain starts a
+   * new one.
+   *
+   * @param size The current maximum number of steps through time.
+   */
+  void ResetCell(const size_t size);
+
   //! Get the model modules.
   std::vector<LayerTypes<CustomLayers...> >& Model() { return network; }
 
@@ -164,6 +172,9 @@ class Recurrent
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
 
+  //! Locally-stored number of steps of the current sequence.
+  size_t rhoSize;
+
   //! Locally-stored number of forward steps.
   size_t forwardStep;
 
@@ -28,6 +28,7 @@ template<typename InputDataType, typename OutputDataType,
          typename... CustomLayers>
 Recurrent<InputDataType, OutputDataType, CustomLayers...>::Recurrent() :
     rho(0),
+    rhoSize(0),
     forwardStep(0),
     backwardStep(0),
     gradientStep(0),
@@ -56,6 +57,7 @@ Recurrent<InputDataType, OutputDataType, CustomLayers...>::Recurrent(
     feedbackModule(new FeedbackModuleType(feedback)),
     transferModule(new TransferModuleType(transfer)),
     rho(rho),
+    rhoSize(rho),
     forwardStep(0),
     backwardStep(0),
     gradientStep(0),
@@ -92,6 +94,7 @@ template<typename InputDataType, typename OutputDataType,
 Recurrent<InputDataType, OutputDataType, CustomLayers...>::Recurrent(
     const Recurrent& network) :
     rho(network.rho),
+    rhoSize(network.rhoSize),
     forwardStep(network.forwardStep),
     backwardStep(network.backwardStep),
     gradientStep(network.gradientStep),
@@ -159,7 +162,7 @@ void Recurrent<InputDataType, OutputDataType, CustomLayers...>::Forward(
   }
 
   forwardStep++;
-  if (forwardStep == rho)
+  if (forwardStep == rhoSize)
   {
     forwardStep = 0;
     backwardStep = 0;
@@ -186,7 +189,7 @@ void Recurrent<InputDataType, OutputDataType, CustomLayers...>::Backward(
     recurrentError = gy;
   }
 
-  if (backwardStep < (rho - 1))
+  if (backwardStep < (rhoSize - 1))
   {
     boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
         outputParameterVisitor, recurrentModule), recurrentError,
@@ -222,7 +225,7 @@ void Recurrent<InputDataType, OutputDataType, CustomLayers...>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& /* gradient */)
 {
-  if (gradientStep < (rho - 1))
+  if (gradientStep < (rhoSize - 1))
   {
     boost::apply_visitor(GradientVisitor(input, error), recurrentModule);
 
@@ -245,13 +248,32 @@ void Recurrent<InputDataType, OutputDataType, CustomLayers...>::Gradient(
   }
 
   gradientStep++;
-  if (gradientStep == rho)
+  if (gradientStep == rhoSize)
   {
     gradientStep = 0;
     feedbackOutputParameter.clear();
   }
 }
 
+template<typename InputDataType, typename OutputDataType,
+         typename... CustomLayers>
+void Recurrent<InputDataType, OutputDataType, CustomLayers...>::ResetCell(
+    const size_t size)
+{
+  // Sequences shorter than rho wrap around after their last step.
+  rhoSize = std::min(rho, size);
+
+  forwardStep = 0;
+  backwardStep = 0;
+  gradientStep = 0;
+  feedbackOutputParameter.clear();
+
+  if (!recurrentError.is_empty())
+  {
+    recurrentError.zeros();
+  }
+}
+
 template<typename InputDataType, typename OutputDataType,
          typename... CustomLayers>
 template<typename Archive>
@@ -275,6 +297,11 @@ void Recurrent<InputDataType, OutputDataType, CustomLayers...>::serialize(
   ar & BOOST_SERIALIZATION_NVP(rho);
   ar & BOOST_SERIALIZATION_NVP(ownsLayer);
 
+  if (Archive::is_loading::value)
+  {
+    rhoSize = rho;
+  }
+
   // Set up the network.
   if (Archive::is_loading::value)
   {
@@ -17,6 +17,7 @@
 
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
 
@@ -30,6 +31,13 @@ namespace ann /** Artificial Neural Network. */ {
  * Implementation of the Transposed Convolution class. The Transposed
  * Convolution class represents a single layer of a neural network.
  *
+ * If the convolution rules are Im2ColConvolution (the default), the forward
+ * pass scatters the whole batch into the output with a single matrix
+ * multiplication followed by Col2Im(), and the backward pass and the gradient
+ * lower the error once and use a single matrix multiplication each.
+ * Otherwise every (input map, output map) pair is convolved separately using
+ * the given rules.
+ *
  * @tparam ForwardConvolutionRule Convolution to perform forward process.
  * @tparam BackwardConvolutionRule Convolution to perform backward process.
  * @tparam GradientConvolutionRule Convolution to calculate gradient.
@@ -39,9 +47,9 @@ namespace ann /** Artificial Neural Network. */ {
  *         arma::sp_mat or arma::cube).
  */
 template <
-    typename ForwardConvolutionRule = NaiveConvolution<ValidConvolution>,
-    typename BackwardConvolutionRule = NaiveConvolution<ValidConvolution>,
-    typename GradientConvolutionRule = NaiveConvolution<ValidConvolution>,
+    typename ForwardConvolutionRule = Im2ColConvolution<ValidConvolution>,
+    typename BackwardConvolutionRule = Im2ColConvolution<ValidConvolution>,
+    typename GradientConvolutionRule = Im2ColConvolution<ValidConvolution>,
     typename InputDataType = arma::mat,
     typename OutputDataType = arma::mat
 >
@@ -294,6 +302,36 @@ class TransposedConvolution
    */
   void InitializeSamePadding();
 
+  /*
+   * Insert zeros between the units of the input and pad it for the forward
+   * convolution; the result is stored in inputPaddedTemp.  Only used if the
+   * convolution rules are not Im2ColConvolution.
+   *
+   * @param input The input data.
+   */
+  template<typename eT>
+  void ExpandInput(const arma::Cube<eT>& input);
+
+  /*
+   * Arrange the weights as a (kernelWidth * kernelHeight * outSize) x inSize
+   * matrix, whose columns hold the filters of one input map in the order of
+   * the patches of Im2ColConvolution::Im2Col().
+   *
+   * @param output The arranged weights.
+   */
+  template<typename eT>
+  void WeightColumns(arma::Mat<eT>& output);
+
+  /*
+   * Pad the error and unroll its patches with Im2ColConvolution::Im2Col(),
+   * one column per input unit.
+   *
+   * @param error The backpropagated error.
+   * @param output The unrolled patches of the error.
+   */
+  template<typename eT>
+  void LowerError(const arma::Mat<eT>& error, arma::Mat<eT>& output);
+
   /*
    * Rotates a dense matrix counterclockwise by 180 degrees.
    *
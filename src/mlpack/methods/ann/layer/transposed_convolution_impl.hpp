@@ -213,50 +213,58 @@ void TransposedConvolution<
   arma::cube inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, inSize * batchSize, false, false);
 
-  if (strideWidth > 1 || strideHeight > 1)
-  {
-    InsertZeros(inputTemp, strideWidth, strideHeight, inputExpandedTemp);
+  output.set_size(outputWidth * outputHeight * outSize, batchSize);
+  outputTemp = arma::Cube<eT>(output.memptr(), outputWidth, outputHeight,
+      outSize * batchSize, false, false);
 
-    if (paddingForward.PadWLeft() != 0 || paddingForward.PadWRight() != 0 ||
-        paddingForward.PadHTop() != 0 || paddingForward.PadHBottom() != 0)
+  if (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    // Every input unit adds its filters, scaled by its value, to the output
+    // patch at its (strided) position.  With the input maps of all points as
+    // a (patches * batchSize) x inSize matrix, the contributions of all
+    // patches are one matrix multiplication, and Col2Im() sums them up.
+    const size_t patches = inputWidth * inputHeight;
+    arma::Mat<eT> inputMat(patches * batchSize, inSize);
+    for (size_t b = 0; b < batchSize; ++b)
     {
-      inputPaddedTemp.set_size(inputExpandedTemp.n_rows +
-          paddingForward.PadWLeft() + paddingForward.PadWRight(),
-          inputExpandedTemp.n_cols + paddingForward.PadHTop() +
-          paddingForward.PadHBottom(), inputExpandedTemp.n_slices);
+      inputMat.rows(b * patches, (b + 1) * patches - 1) = arma::Mat<eT>(
+          const_cast<arma::Mat<eT>&>(input).colptr(b), patches, inSize, false,
+          true);
+    }
 
-      for (size_t i = 0; i < inputExpandedTemp.n_slices; ++i)
-      {
-        paddingForward.Forward(inputExpandedTemp.slice(i),
-            inputPaddedTemp.slice(i));
-      }
+    arma::Mat<eT> weightCols;
+    WeightColumns(weightCols);
+    const arma::Mat<eT> outputCols = weightCols * inputMat.t();
+
+    // The padding of the associated convolution is cropped from the result.
+    if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+    {
+      arma::Cube<eT> outputPaddedTemp(outputWidth + padWLeft + padWRight,
+          outputHeight + padHTop + padHBottom, outSize * batchSize);
+      Im2ColConvolution<ValidConvolution>::Col2Im(outputCols, outSize,
+          kernelWidth, kernelHeight, outputPaddedTemp, strideWidth,
+          strideHeight);
+
+      outputTemp = outputPaddedTemp.tube(padWLeft, padHTop, padWLeft +
+          outputWidth - 1, padHTop + outputHeight - 1);
     }
     else
     {
-      inputPaddedTemp = arma::Cube<eT>(inputExpandedTemp.memptr(),
-          inputExpandedTemp.n_rows, inputExpandedTemp.n_cols,
-          inputExpandedTemp.n_slices, false, false);;
+      Im2ColConvolution<ValidConvolution>::Col2Im(outputCols, outSize,
+          kernelWidth, kernelHeight, outputTemp, strideWidth, strideHeight);
     }
-  }
-  else if (paddingForward.PadWLeft() != 0 ||
-           paddingForward.PadWRight() != 0 ||
-           paddingForward.PadHTop() != 0 ||
-           paddingForward.PadHBottom() != 0)
-  {
-    inputPaddedTemp.set_size(inputTemp.n_rows + paddingForward.PadWLeft() +
-        paddingForward.PadWRight(), inputTemp.n_cols +
-        paddingForward.PadHTop() + paddingForward.PadHBottom(),
-        inputTemp.n_slices);
 
-    for (size_t i = 0; i < inputTemp.n_slices; ++i)
+    for (size_t b = 0; b < batchSize; ++b)
     {
-      paddingForward.Forward(inputTemp.slice(i), inputPaddedTemp.slice(i));
+      arma::Mat<eT> outputMat(output.colptr(b), outputWidth * outputHeight,
+          outSize, false, true);
+      outputMat.each_row() += bias.t();
     }
+
+    return;
   }
 
-  output.set_size(outputWidth * outputHeight * outSize, batchSize);
-  outputTemp = arma::Cube<eT>(output.memptr(), outputWidth, outputHeight,
-      outSize * batchSize, false, false);
+  ExpandInput(inputTemp);
   outputTemp.zeros();
 
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
@@ -313,6 +321,28 @@ void TransposedConvolution<
 >::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
+  g.set_size(inputWidth * inputHeight * inSize, batchSize);
+
+  if (IsIm2ColConvolution<BackwardConvolutionRule>::value)
+  {
+    // The error of an input unit is the correlation of the error with the
+    // filters at its position, so with the lowered error the error of all
+    // points is one matrix multiplication.
+    arma::Mat<eT> errorCols, weightCols;
+    LowerError(gy, errorCols);
+    WeightColumns(weightCols);
+    const arma::Mat<eT> gMat = errorCols.t() * weightCols;
+
+    const size_t patches = inputWidth * inputHeight;
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      arma::Mat<eT> gPoint(g.colptr(b), patches, inSize, false, true);
+      gPoint = gMat.rows(b * patches, (b + 1) * patches - 1);
+    }
+
+    return;
+  }
+
   arma::Cube<eT> mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
   arma::Cube<eT> mappedErrorPadded;
@@ -330,7 +360,6 @@ void TransposedConvolution<
           mappedErrorPadded.slice(i));
     }
   }
-  g.set_size(inputWidth * inputHeight * inSize, batchSize);
   gTemp = arma::Cube<eT>(g.memptr(), inputWidth, inputHeight, inSize *
       batchSize, false, false);
 
@@ -393,7 +422,50 @@ void TransposedConvolution<
   gradient.set_size(weights.n_elem, 1);
   gradientTemp = arma::Cube<eT>(gradient.memptr(), weight.n_rows,
       weight.n_cols, weight.n_slices, false, false);
+
+  if (IsIm2ColConvolution<GradientConvolutionRule>::value)
+  {
+    // The filter of an (input map, output map) pair collects the lowered
+    // error at every input unit, scaled by the value of the unit.
+    const size_t patches = inputWidth * inputHeight;
+    arma::Mat<eT> inputMat(patches * batchSize, inSize);
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      inputMat.rows(b * patches, (b + 1) * patches - 1) = arma::Mat<eT>(
+          const_cast<arma::Mat<eT>&>(input).colptr(b), patches, inSize, false,
+          true);
+    }
+
+    arma::Mat<eT> errorCols;
+    LowerError(error, errorCols);
+    const arma::Mat<eT> weightGradient = errorCols * inputMat;
+
+    const size_t filterSize = kernelWidth * kernelHeight;
+    for (size_t outMap = 0; outMap < outSize; ++outMap)
+    {
+      for (size_t inMap = 0; inMap < inSize; ++inMap)
+      {
+        arma::Col<eT> filterGradient(gradientTemp.slice_memptr(outMap *
+            inSize + inMap), filterSize, false, true);
+        filterGradient = weightGradient.submat(outMap * filterSize, inMap,
+            (outMap + 1) * filterSize - 1, inMap);
+      }
+    }
+
+    gradient.rows(weight.n_elem, weights.n_elem - 1).zeros();
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      gradient.rows(weight.n_elem, weights.n_elem - 1) += arma::sum(
+          arma::Mat<eT>(((arma::Mat<eT>&) error).colptr(b), outputWidth *
+          outputHeight, outSize, false, true)).t();
+    }
+
+    return;
+  }
+
+  ExpandInput(inputTemp);
   gradientTemp.zeros();
+  gradient.rows(weight.n_elem, weights.n_elem - 1).zeros();
 
   arma::Mat<eT> inputSlice, output, deltaSlice, rotatedOutput;
 
@@ -430,8 +502,133 @@ void TransposedConvolution<
       gradientTemp.slice(outMapIdx) += rotatedOutput;
     }
 
-    gradient.submat(weight.n_elem + (outMap % outSize), 0, weight.n_elem +
-        (outMap % outSize), 0) = arma::accu(mappedError.slices(outMap, outMap));
+    gradient(weight.n_elem + (outMap % outSize)) +=
+        arma::accu(mappedError.slice(outMap));
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename eT>
+void TransposedConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::ExpandInput(const arma::Cube<eT>& input)
+{
+  if (strideWidth > 1 || strideHeight > 1)
+  {
+    InsertZeros(input, strideWidth, strideHeight, inputExpandedTemp);
+
+    if (paddingForward.PadWLeft() != 0 || paddingForward.PadWRight() != 0 ||
+        paddingForward.PadHTop() != 0 || paddingForward.PadHBottom() != 0)
+    {
+      inputPaddedTemp.set_size(inputExpandedTemp.n_rows +
+          paddingForward.PadWLeft() + paddingForward.PadWRight(),
+          inputExpandedTemp.n_cols + paddingForward.PadHTop() +
+          paddingForward.PadHBottom(), inputExpandedTemp.n_slices);
+
+      for (size_t i = 0; i < inputExpandedTemp.n_slices; ++i)
+      {
+        paddingForward.Forward(inputExpandedTemp.slice(i),
+            inputPaddedTemp.slice(i));
+      }
+    }
+    else
+    {
+      inputPaddedTemp = arma::Cube<eT>(inputExpandedTemp.memptr(),
+          inputExpandedTemp.n_rows, inputExpandedTemp.n_cols,
+          inputExpandedTemp.n_slices, false, false);;
+    }
+  }
+  else if (paddingForward.PadWLeft() != 0 ||
+           paddingForward.PadWRight() != 0 ||
+           paddingForward.PadHTop() != 0 ||
+           paddingForward.PadHBottom() != 0)
+  {
+    inputPaddedTemp.set_size(input.n_rows + paddingForward.PadWLeft() +
+        paddingForward.PadWRight(), input.n_cols +
+        paddingForward.PadHTop() + paddingForward.PadHBottom(),
+        input.n_slices);
+
+    for (size_t i = 0; i < input.n_slices; ++i)
+    {
+      paddingForward.Forward(input.slice(i), inputPaddedTemp.slice(i));
+    }
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename eT>
+void TransposedConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::WeightColumns(arma::Mat<eT>& output)
+{
+  const size_t filterSize = kernelWidth * kernelHeight;
+  output.set_size(filterSize * outSize, inSize);
+  for (size_t outMap = 0; outMap < outSize; ++outMap)
+  {
+    for (size_t inMap = 0; inMap < inSize; ++inMap)
+    {
+      output.submat(outMap * filterSize, inMap, (outMap + 1) * filterSize - 1,
+          inMap) = arma::vectorise(weight.slice(outMap * inSize + inMap));
+    }
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+template<typename eT>
+void TransposedConvolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::LowerError(const arma::Mat<eT>& error, arma::Mat<eT>& output)
+{
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
+      outputHeight, outSize * batchSize, false, false);
+
+  if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+  {
+    arma::Cube<eT> mappedErrorPadded(outputWidth + padWLeft + padWRight,
+        outputHeight + padHTop + padHBottom, outSize * batchSize);
+    for (size_t i = 0; i < mappedError.n_slices; ++i)
+    {
+      paddingBackward.Forward(mappedError.slice(i),
+          mappedErrorPadded.slice(i));
+    }
+
+    Im2ColConvolution<ValidConvolution>::Im2Col(mappedErrorPadded, outSize,
+        kernelWidth, kernelHeight, output, strideWidth, strideHeight);
+  }
+  else
+  {
+    Im2ColConvolution<ValidConvolution>::Im2Col(mappedError, outSize,
+        kernelWidth, kernelHeight, output, strideWidth, strideHeight);
   }
 }
 
@@ -151,6 +151,29 @@ class LayerNameVisitor : public boost::static_visitor<std::string>
     return "linearnobias";
   }
 
+  /**
+   * Return the name of the given layer of type QuantizedLinear as a string.
+   * 
+   * @param Given layer of type QuantizedLinear.
+   * @return The string representation of the layer.
+   */
+  std::string LayerString(QuantizedLinear<>* /*layer*/) const
+  {
+    return "quantizedlinear";
+  }
+
+  /**
+   * Return the name of the given layer of type QuantizedConvolution as a
+   * string.
+   * 
+   * @param Given layer of type QuantizedConvolution.
+   * @return The string representation of the layer.
+   */
+  std::string LayerString(QuantizedConvolution<>* /*layer*/) const
+  {
+    return "quantizedconvolution";
+  }
+
   /**
    * Return the name of the given layer of type MaxPooling as a string.
    * 
@@ -0,0 +1,54 @@
+/**
+ * @file quantize.hpp
+ *
+ * Definition of the post-training quantization of feed forward networks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZE_HPP
+#define MLPACK_METHODS_ANN_QUANTIZE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "ffn.hpp"
+#include "layer/layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Quantize a trained feed forward network for inference.  The calibration data
+ * is passed through the network to find the range of the input of each layer.
+ * Every top-level Linear and LinearNoBias layer is then replaced by a
+ * QuantizedLinear layer, and every top-level Convolution layer by a
+ * QuantizedConvolution layer, with int8 weights (one scale per output unit or
+ * map) and an input scale calibrated on that range.  All other layers, and
+ * their parameters, are kept as they are.  Networks that hold such layers
+ * inside of container layers (e.g. Sequential) can't be fully quantized and
+ * are rejected.
+ *
+ * The quantized network can be used with Predict() and serialized like any
+ * other network, but it should not be trained anymore, since the quantized
+ * layers have no trainable parameters.
+ *
+ * @param network Trained network to quantize.
+ * @param calibrationData Representative input data, one point per column.
+ *     Input values outside of the range seen here are saturated.
+ */
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename... CustomLayers>
+void Quantize(FFN<OutputLayerType, InitializationRuleType, CustomLayers...>&
+                  network,
+              const arma::mat& calibrationData);
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantize_impl.hpp"
+
+#endif
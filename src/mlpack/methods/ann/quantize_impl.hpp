@@ -0,0 +1,160 @@
+/**
+ * @file quantize_impl.hpp
+ *
+ * Implementation of the post-training quantization of feed forward networks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZE_IMPL_HPP
+#define MLPACK_METHODS_ANN_QUANTIZE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantize.hpp"
+
+#include "visitor/delete_visitor.hpp"
+#include "visitor/output_parameter_visitor.hpp"
+#include "visitor/quantizable_check_visitor.hpp"
+#include "visitor/weight_size_visitor.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename... CustomLayers>
+void Quantize(FFN<OutputLayerType, InitializationRuleType, CustomLayers...>&
+                  network,
+              const arma::mat& calibrationData)
+{
+  if (calibrationData.is_empty())
+  {
+    Log::Fatal << "Quantize(): the calibration data is empty!" << std::endl;
+  }
+
+  std::vector<LayerTypes<CustomLayers...> >& model = network.Model();
+
+  // The layers held by container layers (e.g. Sequential) share the parameter
+  // matrix of the network and get their input from the container, so they
+  // can't be replaced.
+  for (size_t i = 0; i < model.size(); ++i)
+  {
+    if (!boost::get<Linear<>*>(&model[i]) &&
+        !boost::get<LinearNoBias<>*>(&model[i]) &&
+        !boost::get<Convolution<>*>(&model[i]) &&
+        boost::apply_visitor(QuantizableCheckVisitor(), model[i]))
+    {
+      Log::Fatal << "Quantize(): layer " << i << " holds Linear, LinearNoBias "
+          << "or Convolution layers, which can only be quantized at the top "
+          << "level of the network!" << std::endl;
+    }
+  }
+
+  // Run the calibration data through the network, so that the input of each
+  // layer is available.
+  arma::mat output;
+  network.Forward(calibrationData, output);
+
+  // Create all quantized layers before any layer is replaced, since the input
+  // of a layer is the output parameter of the layer before it.
+  OutputParameterVisitor outputParameterVisitor;
+  std::vector<LayerTypes<CustomLayers...> > quantized(model.size());
+  std::vector<bool> replaced(model.size(), false);
+  for (size_t i = 0; i < model.size(); ++i)
+  {
+    Linear<>** linear = boost::get<Linear<>*>(&model[i]);
+    LinearNoBias<>** linearNoBias = boost::get<LinearNoBias<>*>(&model[i]);
+    Convolution<>** convolution = boost::get<Convolution<>*>(&model[i]);
+    if (!linear && !linearNoBias && !convolution)
+      continue;
+
+    const arma::mat& input = (i == 0) ? calibrationData :
+        boost::apply_visitor(outputParameterVisitor, model[i - 1]);
+    const double inputScale = arma::max(arma::max(arma::abs(input))) / 127.0;
+
+    if (linear)
+    {
+      const arma::mat& parameters = (*linear)->Parameters();
+      const size_t inSize = (*linear)->InputSize();
+      const size_t outSize = (*linear)->OutputSize();
+
+      quantized[i] = new QuantizedLinear<>(
+          arma::mat(parameters.memptr(), outSize, inSize),
+          arma::mat(parameters.memptr() + outSize * inSize, outSize, 1),
+          inputScale);
+    }
+    else if (linearNoBias)
+    {
+      const arma::mat& parameters = (*linearNoBias)->Parameters();
+      const size_t inSize = (*linearNoBias)->InputSize();
+      const size_t outSize = (*linearNoBias)->OutputSize();
+
+      quantized[i] = new QuantizedLinear<>(
+          arma::mat(parameters.memptr(), outSize, inSize), arma::mat(),
+          inputScale);
+    }
+    else
+    {
+      // The filters of each output map are stored one after another, followed
+      // by the bias.
+      const Convolution<>& layer = **convolution;
+      const arma::mat& parameters = layer.Parameters();
+      const size_t filterSize = layer.KernelWidth() * layer.KernelHeight() *
+          layer.InputSize();
+      const size_t outSize = layer.OutputSize();
+
+      quantized[i] = new QuantizedConvolution<>(
+          arma::mat(parameters.memptr(), filterSize, outSize),
+          arma::mat(parameters.memptr() + filterSize * outSize, outSize, 1),
+          layer.InputSize(), layer.KernelWidth(), layer.KernelHeight(),
+          layer.StrideWidth(), layer.StrideHeight(),
+          std::make_tuple(layer.PadWLeft(), layer.PadWRight()),
+          std::make_tuple(layer.PadHTop(), layer.PadHBottom()),
+          layer.InputWidth(), layer.InputHeight(), inputScale);
+    }
+
+    replaced[i] = true;
+  }
+
+  // The parameter matrix of the network is rebuilt without the weights of the
+  // replaced layers.  Container layers (e.g. Sequential) keep their weights in
+  // their sub-layers, which alias the parameter matrix, so the old parameters
+  // are copied over block by block instead of layer by layer.
+  WeightSizeVisitor weightSizeVisitor;
+  std::vector<size_t> oldSizes(model.size());
+  for (size_t i = 0; i < model.size(); ++i)
+    oldSizes[i] = boost::apply_visitor(weightSizeVisitor, model[i]);
+
+  const arma::mat oldParameters = network.Parameters();
+  for (size_t i = 0; i < model.size(); ++i)
+  {
+    if (replaced[i])
+    {
+      boost::apply_visitor(DeleteVisitor(), model[i]);
+      model[i] = quantized[i];
+    }
+  }
+
+  network.Parameters().clear();
+  network.ResetParameters();
+
+  for (size_t i = 0, oldOffset = 0, offset = 0; i < model.size(); ++i)
+  {
+    if (!replaced[i] && oldSizes[i] > 0)
+    {
+      network.Parameters().rows(offset, offset + oldSizes[i] - 1) =
+          oldParameters.rows(oldOffset, oldOffset + oldSizes[i] - 1);
+    }
+
+    if (!replaced[i])
+      offset += oldSizes[i];
+    oldOffset += oldSizes[i];
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
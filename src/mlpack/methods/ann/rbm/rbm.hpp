@@ -335,6 +335,14 @@ class RBM
   //! Return the number of steps of Gibbs Sampling.
   size_t NumSteps() const { return numSteps; }
 
+  //! Get whether the negative chains persist between updates (PCD-k).
+  bool Persistence() const { return persistence; }
+  //! Modify whether the negative chains persist between updates (PCD-k).
+  bool& Persistence() { return persistence; }
+
+  //! Get the persistent negative chains, one per column.
+  arma::Mat<ElemType> const& PersistentState() const { return state; }
+
   //! Return the parameters of the network.
   const arma::Mat<ElemType>& Parameters() const { return parameter; }
   //! Modify the parameters of the network.
@@ -380,6 +388,34 @@ class RBM
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Seed one generator per OpenMP thread from the mlpack random number
+   * generator.  Unless force is set, the generators are only seeded if there
+   * are fewer of them than threads.
+   *
+   * @param force Whether to reseed the existing generators.
+   */
+  void ResetGenerators(const bool force);
+
+  /**
+   * Replace every element of the given matrix, which holds probabilities, by
+   * a Bernoulli sample.  Large matrices are sampled in parallel, every thread
+   * drawing from its own generator in generators.
+   *
+   * @param output The probabilities to sample, overwritten by the samples.
+   */
+  void SampleBernoulli(arma::Mat<ElemType>& output);
+
+  /**
+   * Replace every element of the given matrix, which holds means, by a sample
+   * of a Normal distribution with the given deviation around it.  The
+   * elements are sampled in parallel like in SampleBernoulli().
+   *
+   * @param output The means to sample around, overwritten by the samples.
+   * @param deviation The deviation of the Normal distribution.
+   */
+  void SampleNormal(arma::Mat<ElemType>& output, const ElemType deviation);
+
   //! Locally stored parameters of the network.
   arma::Mat<ElemType> parameter;
   //! The matrix of data points (predictors).
@@ -446,6 +482,8 @@ class RBM
   bool persistence;
   //! Locally-stored reset variable.
   bool reset;
+  //! Locally-stored generators used for sampling, one per thread.
+  std::vector<std::mt19937> generators;
 };
 
 } // namespace ann
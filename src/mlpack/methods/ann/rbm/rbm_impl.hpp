@@ -82,6 +82,7 @@ RBM<InitializationRuleType, DataType, PolicyType>::Reset()
   negativeGradient.zeros();
   tempNegativeGradient.zeros();
   initializeRule.Initialize(parameter, parameter.n_elem, 1);
+  ResetGenerators(true);
 
   reset = true;
 }
@@ -168,11 +169,7 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleHidden(
     arma::Mat<ElemType>&& output)
 {
   HiddenMean(std::move(input), std::move(output));
-
-  for (size_t i = 0; i < output.n_elem; i++)
-  {
-    output(i) = math::RandBernoulli(output(i));
-  }
+  SampleBernoulli(output);
 }
 
 template<
@@ -187,11 +184,7 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleVisible(
     arma::Mat<ElemType>&& output)
 {
   VisibleMean(std::move(input), std::move(output));
-
-  for (size_t i = 0; i < output.n_elem; i++)
-  {
-    output(i) = math::RandBernoulli(output(i));
-  }
+  SampleBernoulli(output);
 }
 
 template<
@@ -275,7 +268,7 @@ void RBM<InitializationRuleType, DataType, PolicyType>::Gradient(
   Phase(std::move(predictors.cols(i, i + batchSize - 1)),
       std::move(positiveGradient));
 
-  for (size_t i = 0; i < negSteps; i++)
+  for (size_t j = 0; j < negSteps; j++)
   {
     Gibbs(std::move(predictors.cols(i, i + batchSize - 1)),
         std::move(negativeSamples));
@@ -287,6 +280,85 @@ void RBM<InitializationRuleType, DataType, PolicyType>::Gradient(
   gradient = ((negativeGradient / negSteps) - positiveGradient);
 }
 
+template<
+  typename InitializationRuleType,
+  typename DataType,
+  typename PolicyType
+>
+void RBM<InitializationRuleType, DataType, PolicyType>::ResetGenerators(
+    const bool force)
+{
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+    threads = omp_get_max_threads();
+  #endif
+
+  // The generators are only reseeded if asked for, or if the number of
+  // threads has grown since they were last seeded.
+  if (!force && generators.size() >= threads)
+    return;
+
+  // A draw from the mlpack generator seeds every thread, so that
+  // math::RandomSeed() keeps the samples reproducible for a fixed number of
+  // threads.
+  generators.resize(threads);
+  for (size_t thread = 0; thread < threads; ++thread)
+  {
+    std::seed_seq sequence{ (size_t) math::randGen(), thread };
+    generators[thread].seed(sequence);
+  }
+}
+
+template<
+  typename InitializationRuleType,
+  typename DataType,
+  typename PolicyType
+>
+void RBM<InitializationRuleType, DataType, PolicyType>::SampleBernoulli(
+    arma::Mat<ElemType>& output)
+{
+  ResetGenerators(false);
+
+  #pragma omp parallel if (output.n_elem >= 4096)
+  {
+    size_t thread = 0;
+    #ifdef HAS_OPENMP
+      thread = omp_get_thread_num();
+    #endif
+    std::mt19937& generator = generators[thread];
+    std::uniform_real_distribution<double> uniform;
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) output.n_elem; ++i)
+      output[i] = (uniform(generator) < output[i]) ? 1 : 0;
+  }
+}
+
+template<
+  typename InitializationRuleType,
+  typename DataType,
+  typename PolicyType
+>
+void RBM<InitializationRuleType, DataType, PolicyType>::SampleNormal(
+    arma::Mat<ElemType>& output, const ElemType deviation)
+{
+  ResetGenerators(false);
+
+  #pragma omp parallel if (output.n_elem >= 4096)
+  {
+    size_t thread = 0;
+    #ifdef HAS_OPENMP
+      thread = omp_get_thread_num();
+    #endif
+    std::mt19937& generator = generators[thread];
+    std::normal_distribution<double> normal;
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) output.n_elem; ++i)
+      output[i] += deviation * normal(generator);
+  }
+}
+
 template<
   typename InitializationRuleType,
   typename DataType,
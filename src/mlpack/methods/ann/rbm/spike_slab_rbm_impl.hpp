@@ -56,6 +56,7 @@ RBM<InitializationRuleType, DataType, PolicyType>::Reset()
   negativeGradient.zeros();
   tempNegativeGradient.zeros();
   initializeRule.Initialize(parameter, parameter.n_elem, 1);
+  ResetGenerators(true);
 
   reset = true;
 }
@@ -109,10 +110,16 @@ RBM<InitializationRuleType, DataType, PolicyType>::Phase(
   SampleSpike(std::move(spikeMean), std::move(spikeSamples));
   SlabMean(std::move(input), std::move(spikeSamples), std::move(slabMean));
 
-  for (size_t i = 0 ; i < hiddenSize; i++)
+  // Summing the input over the columns first turns the gradient of every
+  // slice into an outer product.
+  const arma::Col<ElemType> inputSum = arma::sum(input, 1);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) hiddenSize; ++i)
   {
-    weightGrad.slice(i) = input * arma::repmat(slabMean.col(i).t(),
-        input.n_cols, 1) * spikeMean(i);
+    arma::Mat<ElemType> weightGradSlice(weightGrad.slice_memptr(i),
+        visibleSize, poolSize, false, true);
+    weightGradSlice = spikeMean(i) * inputSum * slabMean.col(i).t();
   }
 
   spikeBiasGrad = spikeMean;
@@ -163,10 +170,8 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleVisible(
 
   for (k = 0; k < numMaxTrials; k++)
   {
-    for (size_t i = 0; i < visibleSize; i++)
-    {
-      output(i) = math::RandNormal(visibleMean(i), 1.0 / visiblePenalty(0));
-    }
+    output = visibleMean;
+    SampleNormal(output, 1.0 / visiblePenalty(0));
     if (arma::norm(output, 2) < radius)
     {
       break;
@@ -240,11 +245,19 @@ RBM<InitializationRuleType, DataType, PolicyType>::SpikeMean(
     DataType&& visible,
     DataType&& spikeMean)
 {
-  for (size_t i = 0; i < hiddenSize; i++)
+  // The sum of all entries of v^T W_i W_i^T v divided by the squared number
+  // of columns is the squared norm of W_i^T applied to the mean column, so the
+  // visible x visible product is never formed.
+  const arma::Col<ElemType> meanVisible = arma::mean(visible, 1);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) hiddenSize; ++i)
   {
-    spikeMean(i) = LogisticFunction::Fn(0.5 * (1.0 / slabPenalty) * arma::accu(
-        visible.t() * (weight.slice(i) * weight.slice(i).t()) * visible)
-        / std::pow(visible.n_cols, 2) + spikeBias(i));
+    const arma::Mat<ElemType> weightSlice(weight.slice_memptr(i), visibleSize,
+        poolSize, false, true);
+    const arma::Col<ElemType> projection = weightSlice.t() * meanVisible;
+    spikeMean(i) = LogisticFunction::Fn(0.5 * (1.0 / slabPenalty) *
+        arma::dot(projection, projection) + spikeBias(i));
   }
 }
 
@@ -259,10 +272,8 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleSpike(
     DataType&& spikeMean,
     DataType&& spike)
 {
-  for (size_t i = 0; i < hiddenSize; i++)
-  {
-    spike(i) = math::RandBernoulli(spikeMean(i));
-  }
+  spike = spikeMean;
+  SampleBernoulli(spike);
 }
 
 template<
@@ -277,10 +288,16 @@ RBM<InitializationRuleType, DataType, PolicyType>::SlabMean(
     DataType&& spike,
     DataType&& slabMean)
 {
-  for (size_t i = 0; i < hiddenSize; i++)
+  // The mean over the columns commutes with the projection.
+  const arma::Col<ElemType> meanVisible = arma::mean(visible, 1);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) hiddenSize; ++i)
   {
-    slabMean.col(i) = arma::mean((1.0 / slabPenalty) * spike(i) *
-        weight.slice(i).t() * visible, 1);
+    const arma::Mat<ElemType> weightSlice(weight.slice_memptr(i), visibleSize,
+        poolSize, false, true);
+    slabMean.col(i) = (1.0 / slabPenalty) * spike(i) * weightSlice.t() *
+        meanVisible;
   }
 }
 
@@ -295,13 +312,8 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleSlab(
     DataType&& slabMean,
     DataType&& slab)
 {
-  for (size_t i = 0; i < hiddenSize; i++)
-  {
-    for (size_t j = 0; j < poolSize; j++)
-    {
-      slab(j, i) = math::RandNormal(slabMean(j, i), 1.0 / slabPenalty);
-    }
-  }
+  slab = slabMean;
+  SampleNormal(slab, 1.0 / slabPenalty);
 }
 
 } // namespace ann
@@ -102,6 +102,32 @@ class RNN
       ::value, void>::type
   WarnMessageMaxIterations(OptimizerType& optimizer, size_t samples) const;
 
+  /**
+   * Use the batch size of the optimizer as the size of the batches whose
+   * order Shuffle() shuffles.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param optimizer optimizer used in the training process.
+   */
+  template<typename OptimizerType>
+  typename std::enable_if<
+      HasBatchSize<OptimizerType, size_t&(OptimizerType::*)()>
+      ::value, void>::type
+  SetBucketSize(OptimizerType& optimizer);
+
+  /**
+   * The optimizer has no BatchSize() parameter, so Shuffle() shuffles single
+   * sequences.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param optimizer optimizer used in the training process.
+   */
+  template<typename OptimizerType>
+  typename std::enable_if<
+      !HasBatchSize<OptimizerType, size_t&(OptimizerType::*)()>
+      ::value, void>::type
+  SetBucketSize(OptimizerType& optimizer);
+
   /**
    * Train the recurrent neural network on the given input data using the given
    * optimizer.
@@ -190,6 +216,25 @@ class RNN
                arma::cube& results,
                const size_t batchSize = 256);
 
+  /**
+   * Predict the responses to a single time step of one or more streams,
+   * continuing from the state the previous call left the network in, so that
+   * long streams can be processed one step at a time without recomputing
+   * their history.  The network should be stateful (see Stateful()), since
+   * the state is otherwise dropped every rho steps.  New streams are started
+   * when the number of columns changes, or by calling ResetState().
+   *
+   * @param input Input of the current time step, one column per stream.
+   * @param output Output of the network for the current time step.
+   */
+  void PredictStep(const arma::mat& input, arma::mat& output);
+
+  /**
+   * Reset the state carried over by a stateful network, e.g. before a new
+   * stream is processed.
+   */
+  void ResetState();
+
   /**
    * Evaluate the recurrent neural network with the given parameters. This
    * function is usually called by the optimizer to train the model.
@@ -259,10 +304,21 @@ class RNN
 
   /**
    * Shuffle the order of function visitation. This may be called by the
-   * optimizer.
+   * optimizer.  If SequenceLengths() are given, the sequences stay sorted by
+   * length within batches of the optimizer's batch size, and only the order of
+   * the batches is shuffled (see SequenceLengths()).
    */
   void Shuffle();
 
+  /**
+   * Get the number of time steps needed by the batch starting at the given
+   * data point; this is the length of its longest sequence, but at most rho.
+   *
+   * @param begin Index of the first sequence (column) of the batch.
+   * @param batchSize Number of sequences in the batch.
+   */
+  size_t BatchSteps(const size_t begin, const size_t batchSize) const;
+
   /*
    * Add a new module to the model.
    *
@@ -294,12 +350,64 @@ class RNN
   //! Get the matrix of responses to the input data points.
   const arma::cube& Responses() const { return responses; }
   //! Modify the matrix of responses to the input data points.
-  arma::cube& Responses() { return responses; }
+  arma::cube& Responses()
+  {
+    trainingLengths.reset();
+    return responses;
+  }
 
   //! Get the matrix of data points (predictors).
   const arma::cube& Predictors() const { return predictors; }
   //! Modify the matrix of data points (predictors).
-  arma::cube& Predictors() { return predictors; }
+  arma::cube& Predictors()
+  {
+    trainingLengths.reset();
+    return predictors;
+  }
+
+  //! Get whether the state is carried over between chunks of the sequences.
+  bool Stateful() const { return stateful; }
+  /**
+   * Modify whether the state is carried over between chunks of the sequences.
+   * A stateful network is trained with truncated backpropagation through
+   * time on long streams: the sequences are split into consecutive chunks of
+   * rho time steps, which are the functions visited by the optimizer (in
+   * order; Shuffle() has no effect).  The recurrent layers that support it
+   * (LSTM and FastLSTM) start each chunk from the state the previous chunk
+   * ended in, while the error is only backpropagated within the chunk.  The
+   * state is reset when the optimizer starts a new pass over the data.
+   *
+   * Stateful training needs a response for every time step, so it can be
+   * combined neither with single mode nor with SequenceLengths().
+   */
+  bool& Stateful() { return stateful; }
+
+  /**
+   * Get the length (number of time steps) of each sequence.  If empty, every
+   * sequence is assumed to span all the slices of the predictors.
+   */
+  const arma::urowvec& SequenceLengths() const { return sequenceLengths; }
+  /**
+   * Modify the length (number of time steps) of each sequence.  This allows
+   * sequences of different lengths to be trained together: the shorter
+   * sequences are padded up to the number of slices of the predictors, and
+   * the padded time steps contribute neither to the objective nor to the
+   * gradient.  In single mode the response of a sequence is compared to the
+   * output at its last time step.
+   *
+   * The lengths have to be set before Train() is called, one per data point.
+   * Train() then sorts the sequences by length so that each batch only runs
+   * as many time steps as its longest sequence needs; the lengths themselves
+   * are left in the order of the data given to Train().  If the optimizer has
+   * a BatchSize(), Shuffle() keeps the sorted sequences of each batch
+   * together and only shuffles the order of the batches; a last, smaller batch
+   * stays at the end.
+   */
+  arma::urowvec& SequenceLengths()
+  {
+    trainingLengths.reset();
+    return sequenceLengths;
+  }
 
   /**
    * Reset the state of the network.  This ensures that all internally-held
@@ -330,8 +438,84 @@ class RNN
 
   /**
    * Reset the state of RNN cells in the network for new input sequence.
+   *
+   * @param steps Number of time steps of the new sequence; at most rho steps
+   *     are used.
+   */
+  void ResetCells(const size_t steps = std::numeric_limits<size_t>::max());
+
+  /**
+   * Check that there is one sequence length per data point, and sort the data
+   * points by descending sequence length.  The sorted lengths are stored in
+   * trainingLengths; SequenceLengths() is left as it is.
+   */
+  void SortSequences();
+
+  /**
+   * Get the length of each sequence of the data held by the network: the
+   * sorted (or shuffled) lengths after Train(), or the lengths given by the
+   * user if the data was set through Predictors() and SequenceLengths().
+   */
+  const arma::urowvec& Lengths() const
+  {
+    return trainingLengths.is_empty() ? sequenceLengths : trainingLengths;
+  }
+
+  /**
+   * Evaluate the network on the given time steps of the given sequences.
+   *
+   * @param firstStep First time step (slice) to evaluate.
+   * @param steps Number of time steps to evaluate.
+   * @param begin Index of the first sequence (column).
+   * @param batchSize Number of sequences.
+   */
+  double EvaluateSteps(const size_t firstStep,
+                       const size_t steps,
+                       const size_t begin,
+                       const size_t batchSize);
+
+  /**
+   * Evaluate the network on the given time steps of the given sequences, and
+   * add the gradient of the objective to the given gradient.
+   *
+   * @param firstStep First time step (slice) to evaluate.
+   * @param steps Number of time steps to evaluate.
+   * @param begin Index of the first sequence (column).
+   * @param batchSize Number of sequences.
+   * @param gradient Gradient to add the gradient of the steps to.
    */
-  void ResetCells();
+  template<typename GradType>
+  double EvaluateStepsWithGradient(const size_t firstStep,
+                                   const size_t steps,
+                                   const size_t begin,
+                                   const size_t batchSize,
+                                   GradType& gradient);
+
+  /**
+   * Find the sequences of the given batch that are compared to the response at
+   * the given time step and store their indices in activeSequences.
+   *
+   * @return true if all sequences of the batch are active.
+   */
+  bool ActiveSequences(const size_t begin,
+                       const size_t batchSize,
+                       const size_t step);
+
+  /**
+   * Compute the loss of the network output at the given time step, taking
+   * only the sequences into account that are still active at this step.
+   */
+  double OutputLoss(const size_t begin,
+                    const size_t batchSize,
+                    const size_t step);
+
+  /**
+   * Compute the error of the network output at the given time step; the error
+   * of all sequences that are not active at this step is zero.
+   */
+  void OutputError(const size_t begin,
+                   const size_t batchSize,
+                   const size_t step);
 
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm). Computes
@@ -391,6 +575,24 @@ class RNN
   //! The matrix of responses to the input data points.
   arma::cube responses;
 
+  //! The length of each sequence (empty if all have the full length).
+  arma::urowvec sequenceLengths;
+
+  //! The length of each training sequence, in the order of the (sorted or
+  //! shuffled) training data.  It is cleared when the data or the lengths are
+  //! modified through the accessors.
+  arma::urowvec trainingLengths;
+
+  //! The size of the batches whose order Shuffle() shuffles, if the training
+  //! sequences are sorted by length (0 if the optimizer has no batch size).
+  size_t bucketSize;
+
+  //! The indices of the sequences of the current batch that are active.
+  arma::uvec activeSequences;
+
+  //! The error of the active sequences for the backward pass.
+  arma::mat activeError;
+
   //! Matrix of (trained) parameters.
   arma::mat parameter;
 
@@ -406,7 +608,8 @@ class RNN
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
 
-  //! List of all module parameters for the backward pass (BBTT).
+  //! List of all module parameters for the backward pass (BBTT); it is kept
+  //! between the passes to reuse the allocated memory.
   std::vector<arma::mat> moduleOutputParameter;
 
   //! Locally-stored weight size visitor.
@@ -421,6 +624,12 @@ class RNN
   //! The current evaluation mode (training or testing).
   bool deterministic;
 
+  //! If true the state is carried over between chunks of the sequences.
+  bool stateful;
+
+  //! The number of streams processed by PredictStep().
+  size_t streams;
+
   //! The current gradient for the gradient pass.
   arma::mat currentGradient;
 
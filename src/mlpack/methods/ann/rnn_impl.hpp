@@ -20,6 +20,7 @@
 #include "visitor/forward_visitor.hpp"
 #include "visitor/backward_visitor.hpp"
 #include "visitor/reset_cell_visitor.hpp"
+#include "visitor/stateful_set_visitor.hpp"
 #include "visitor/deterministic_set_visitor.hpp"
 #include "visitor/gradient_set_visitor.hpp"
 #include "visitor/gradient_visitor.hpp"
@@ -46,7 +47,10 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     reset(false),
     single(single),
     numFunctions(0),
-    deterministic(true)
+    deterministic(true),
+    stateful(false),
+    streams(0),
+    bucketSize(0)
 {
   /* Nothing to do here */
 }
@@ -95,6 +99,30 @@ WarnMessageMaxIterations(OptimizerType& optimizer, size_t samples) const
   return;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+typename std::enable_if<
+      HasBatchSize<OptimizerType, size_t&(OptimizerType::*)()>
+      ::value, void>::type
+RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+SetBucketSize(OptimizerType& optimizer)
+{
+  bucketSize = optimizer.BatchSize();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+typename std::enable_if<
+      !HasBatchSize<OptimizerType, size_t&(OptimizerType::*)()>
+      ::value, void>::type
+RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+SetBucketSize(OptimizerType& /* optimizer */)
+{
+  bucketSize = 0;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
@@ -109,6 +137,23 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
 
+  trainingLengths.reset();
+  if (stateful)
+  {
+    if (single || !sequenceLengths.is_empty())
+    {
+      Log::Fatal << "RNN::Train(): stateful training needs a response for "
+          << "every time step of every sequence!" << std::endl;
+    }
+
+    // Each function is a chunk of rho time steps of all sequences.
+    numFunctions = (this->predictors.n_slices + rho - 1) / rho;
+  }
+  else if (!sequenceLengths.is_empty())
+  {
+    SortSequences();
+  }
+
   this->deterministic = true;
   ResetDeterministic();
 
@@ -118,6 +163,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   }
 
   WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
+  SetBucketSize(optimizer);
 
   // Train the model.
   Timer::Start("rnn_optimization");
@@ -132,14 +178,141 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType,
-         CustomLayers...>::ResetCells()
+         CustomLayers...>::ResetCells(const size_t steps)
+{
+  for (size_t i = 1; i < network.size(); ++i)
+  {
+    boost::apply_visitor(StatefulSetVisitor(stateful), network[i]);
+    boost::apply_visitor(ResetCellVisitor(std::min(rho, steps)), network[i]);
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ResetState()
 {
+  // Layers that are not stateful drop their state when the cell is reset.
   for (size_t i = 1; i < network.size(); ++i)
   {
+    boost::apply_visitor(StatefulSetVisitor(false), network[i]);
     boost::apply_visitor(ResetCellVisitor(rho), network[i]);
+    boost::apply_visitor(StatefulSetVisitor(stateful), network[i]);
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::SortSequences()
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "RNN::Train(): " << sequenceLengths.n_elem
+        << " sequence lengths given, but there are " << predictors.n_cols
+        << " data points!" << std::endl;
+  }
+
+  if (sequenceLengths.min() == 0 || sequenceLengths.max() > predictors.n_slices)
+  {
+    Log::Fatal << "RNN::Train(): the sequence lengths must be between 1 and "
+        << "the number of time steps (" << predictors.n_slices << ")!"
+        << std::endl;
+  }
+
+  // Group sequences of similar length, so that the batches need to process as
+  // little padding as possible.  The lengths given by the user are kept in
+  // their order; the training data is sorted along with a copy of them.
+  const arma::uvec ordering = arma::stable_sort_index(sequenceLengths,
+      "descend");
+  for (size_t i = 0; i < predictors.n_slices; ++i)
+    predictors.slice(i) = predictors.slice(i).cols(ordering);
+  for (size_t i = 0; i < responses.n_slices; ++i)
+    responses.slice(i) = responses.slice(i).cols(ordering);
+
+  trainingLengths = sequenceLengths.cols(ordering);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t RNN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::BatchSteps(const size_t begin,
+                                        const size_t batchSize) const
+{
+  return std::min(rho, size_t(arma::max(
+      Lengths().subvec(begin, begin + batchSize - 1))));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+bool RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ActiveSequences(const size_t begin,
+                                           const size_t batchSize,
+                                           const size_t step)
+{
+  activeSequences.set_size(batchSize);
+  size_t active = 0;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    // Sequences longer than rho are truncated, so in single mode their
+    // response is compared to the output of the last processed step.
+    const size_t length = std::min(size_t(Lengths()[begin + i]), rho);
+    if ((single && length == step + 1) || (!single && length > step))
+      activeSequences[active++] = i;
+  }
+
+  activeSequences.resize(active);
+  return active == batchSize;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+double RNN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::OutputLoss(const size_t begin,
+                                        const size_t batchSize,
+                                        const size_t step)
+{
+  const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+      network.back());
+  const arma::mat target(responses.slice(single ? 0 : step).colptr(begin),
+      responses.n_rows, batchSize, false, true);
+
+  if (ActiveSequences(begin, batchSize, step))
+    return outputLayer.Forward(output, target);
+  else if (activeSequences.is_empty())
+    return 0;
+
+  return outputLayer.Forward(arma::mat(output.cols(activeSequences)),
+      arma::mat(target.cols(activeSequences)));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::OutputError(const size_t begin,
+                                       const size_t batchSize,
+                                       const size_t step)
+{
+  const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
+      network.back());
+  const arma::mat target(responses.slice(single ? 0 : step).colptr(begin),
+      responses.n_rows, batchSize, false, true);
+
+  if (ActiveSequences(begin, batchSize, step))
+  {
+    outputLayer.Backward(output, target, error);
+    return;
+  }
+
+  error.zeros(output.n_rows, output.n_cols);
+  if (activeSequences.is_empty())
+    return;
+
+  outputLayer.Backward(arma::mat(output.cols(activeSequences)),
+      arma::mat(target.cols(activeSequences)), activeError);
+  error.cols(activeSequences) = activeError;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
@@ -153,6 +326,23 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
 
+  trainingLengths.reset();
+  if (stateful)
+  {
+    if (single || !sequenceLengths.is_empty())
+    {
+      Log::Fatal << "RNN::Train(): stateful training needs a response for "
+          << "every time step of every sequence!" << std::endl;
+    }
+
+    // Each function is a chunk of rho time steps of all sequences.
+    numFunctions = (this->predictors.n_slices + rho - 1) / rho;
+  }
+  else if (!sequenceLengths.is_empty())
+  {
+    SortSequences();
+  }
+
   this->deterministic = true;
   ResetDeterministic();
 
@@ -164,6 +354,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   OptimizerType optimizer;
 
   WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
+  SetBucketSize(optimizer);
 
   // Train the model.
   Timer::Start("rnn_optimization");
@@ -223,6 +414,38 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+PredictStep(const arma::mat& input, arma::mat& output)
+{
+  if (parameter.is_empty())
+  {
+    ResetParameters();
+  }
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  // A different number of streams starts new streams.
+  if (input.n_cols != streams)
+  {
+    streams = input.n_cols;
+    ResetState();
+  }
+
+  for (size_t i = 1; i < network.size(); ++i)
+  {
+    boost::apply_visitor(StatefulSetVisitor(stateful), network[i]);
+  }
+
+  Forward(input);
+  output = boost::apply_visitor(outputParameterVisitor, network.back());
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
@@ -252,20 +475,59 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
     targetSize = responses.n_rows;
   }
 
-  ResetCells();
+  // In stateful mode each function is a chunk of (at most) rho consecutive
+  // time steps of all sequences; the chunks are visited in order, and the
+  // state of the network is carried over from one chunk to the next.
+  if (stateful)
+  {
+    if (begin == 0)
+      ResetState();
+
+    double performance = 0;
+    for (size_t chunk = begin; chunk < begin + batchSize; ++chunk)
+    {
+      const size_t steps = std::min(rho,
+          size_t(predictors.n_slices) - chunk * rho);
+      ResetCells(steps);
+      performance += EvaluateSteps(chunk * rho, steps, 0, predictors.n_cols);
+    }
+
+    return performance;
+  }
+
+  const size_t steps = Lengths().is_empty() ? rho :
+      BatchSteps(begin, batchSize);
+  ResetCells(steps);
 
+  return EvaluateSteps(0, steps, begin, batchSize);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+EvaluateSteps(const size_t firstStep,
+              const size_t steps,
+              const size_t begin,
+              const size_t batchSize)
+{
   double performance = 0;
   size_t responseSeq = 0;
 
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < steps; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
-    arma::mat stepData(predictors.slice(seqNum).colptr(begin),
+    arma::mat stepData(predictors.slice(firstStep + seqNum).colptr(begin),
         predictors.n_rows, batchSize, false, true);
     Forward(stepData);
     if (!single)
     {
-      responseSeq = seqNum;
+      responseSeq = firstStep + seqNum;
+    }
+
+    if (!Lengths().is_empty())
+    {
+      performance += OutputLoss(begin, batchSize, seqNum);
+      continue;
     }
 
     performance += outputLayer.Forward(boost::apply_visitor(
@@ -333,27 +595,73 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     targetSize = responses.n_rows;
   }
 
-  ResetCells();
+  // See Evaluate() for the stateful mode.
+  if (stateful)
+  {
+    if (begin == 0)
+      ResetState();
+
+    double performance = 0;
+    for (size_t chunk = begin; chunk < begin + batchSize; ++chunk)
+    {
+      const size_t steps = std::min(rho,
+          size_t(predictors.n_slices) - chunk * rho);
+      ResetCells(steps);
+      performance += EvaluateStepsWithGradient(chunk * rho, steps, 0,
+          predictors.n_cols, gradient);
+    }
+
+    return performance;
+  }
+
+  // With sequences of different lengths, only as many steps as the longest
+  // sequence of the batch needs are processed.
+  const size_t effectiveRho = Lengths().is_empty() ?
+      std::min(rho, size_t(responses.size())) : BatchSteps(begin, batchSize);
+  ResetCells(effectiveRho);
 
+  return EvaluateStepsWithGradient(0, effectiveRho, begin, batchSize,
+      gradient);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename GradType>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+EvaluateStepsWithGradient(const size_t firstStep,
+                          const size_t steps,
+                          const size_t begin,
+                          const size_t batchSize,
+                          GradType& gradient)
+{
   double performance = 0;
   size_t responseSeq = 0;
-  const size_t effectiveRho = std::min(rho, size_t(responses.size()));
 
-  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
+  // The output parameters of all time steps are kept in a workspace that is
+  // reused across calls, so no memory is allocated once it holds all steps.
+  size_t outputParameterIndex = 0;
+
+  for (size_t seqNum = 0; seqNum < steps; ++seqNum)
   {
     // Wrap a matrix around our data to avoid a copy.
-    arma::mat stepData(predictors.slice(seqNum).colptr(begin),
+    arma::mat stepData(predictors.slice(firstStep + seqNum).colptr(begin),
         predictors.n_rows, batchSize, false, true);
     Forward(stepData);
     if (!single)
     {
-      responseSeq = seqNum;
+      responseSeq = firstStep + seqNum;
     }
 
     for (size_t l = 0; l < network.size(); ++l)
     {
-      boost::apply_visitor(SaveOutputParameterVisitor(moduleOutputParameter),
-          network[l]);
+      boost::apply_visitor(SaveOutputParameterVisitor(moduleOutputParameter,
+          outputParameterIndex), network[l]);
+    }
+
+    if (!Lengths().is_empty())
+    {
+      performance += OutputLoss(begin, batchSize, seqNum);
+      continue;
     }
 
     performance += outputLayer.Forward(boost::apply_visitor(
@@ -377,16 +685,23 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   ResetGradients(currentGradient);
 
-  for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
+  for (size_t seqNum = 0; seqNum < steps; ++seqNum)
   {
+    // The time step of the data that is processed backwards.
+    const size_t step = firstStep + steps - seqNum - 1;
+
     currentGradient.zeros();
     for (size_t l = 0; l < network.size(); ++l)
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(moduleOutputParameter),
-          network[network.size() - 1 - l]);
+      boost::apply_visitor(LoadOutputParameterVisitor(moduleOutputParameter,
+          outputParameterIndex), network[network.size() - 1 - l]);
     }
 
-    if (single && seqNum > 0)
+    if (!Lengths().is_empty())
+    {
+      OutputError(begin, batchSize, steps - seqNum - 1);
+    }
+    else if (single && seqNum > 0)
     {
       error.zeros();
     }
@@ -401,13 +716,12 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     {
       outputLayer.Backward(boost::apply_visitor(
           outputParameterVisitor, network.back()),
-          arma::mat(responses.slice(effectiveRho - seqNum - 1).colptr(begin),
+          arma::mat(responses.slice(step).colptr(begin),
           responses.n_rows, batchSize, false, true), error);
     }
 
     Backward();
-    Gradient(
-        arma::mat(predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
+    Gradient(arma::mat(predictors.slice(step).colptr(begin),
         predictors.n_rows, batchSize, false, true));
     gradient += currentGradient;
   }
@@ -430,6 +744,42 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Shuffle()
 {
+  // The chunks of a stateful network have to be visited in order.
+  if (stateful)
+    return;
+
+  if (!Lengths().is_empty())
+  {
+    // Only shuffle the order of the batches, so that the sequences of a batch
+    // keep similar lengths.  A last, smaller batch stays at the end, so that
+    // the batches are the same the next time.  The sequence lengths have to
+    // be shuffled along with the data.
+    const size_t bucket = std::max(bucketSize, (size_t) 1);
+    const size_t buckets = predictors.n_cols / bucket;
+    if (buckets < 2)
+      return;
+
+    const arma::uvec bucketOrdering = arma::shuffle(
+        arma::linspace<arma::uvec>(0, buckets - 1, buckets));
+    arma::uvec ordering(predictors.n_cols);
+    for (size_t i = 0; i < buckets; ++i)
+    {
+      ordering.subvec(i * bucket, (i + 1) * bucket - 1) =
+          arma::linspace<arma::uvec>(bucketOrdering[i] * bucket,
+          (bucketOrdering[i] + 1) * bucket - 1, bucket);
+    }
+    for (size_t i = buckets * bucket; i < predictors.n_cols; ++i)
+      ordering[i] = i;
+
+    for (size_t i = 0; i < predictors.n_slices; ++i)
+      predictors.slice(i) = predictors.slice(i).cols(ordering);
+    for (size_t i = 0; i < responses.n_slices; ++i)
+      responses.slice(i) = responses.slice(i).cols(ordering);
+
+    trainingLengths = Lengths().cols(ordering);
+    return;
+  }
+
   arma::cube newPredictors, newResponses;
   math::ShuffleData(predictors, responses, newPredictors, newResponses);
 
@@ -0,0 +1,67 @@
+/**
+ * @file deterministic_check_visitor.hpp
+ *
+ * This file provides an abstraction to check whether a layer, or any layer it
+ * holds, implements the Deterministic() function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_DETERMINISTIC_CHECK_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_DETERMINISTIC_CHECK_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * DeterministicCheckVisitor returns true if the given module, or any module in
+ * its Model(), implements the Deterministic() function.  Such modules behave
+ * differently during training, e.g. they draw random numbers or update
+ * statistics in the forward pass.
+ */
+class DeterministicCheckVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Check whether the module implements the Deterministic() function.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+
+ private:
+  //! Return true if the module implements the Deterministic() function.
+  template<typename T>
+  typename std::enable_if<
+      HasDeterministicCheck<T, bool&(T::*)(void)>::value, bool>::type
+  LayerDeterministic(T* layer) const;
+
+  //! Check the modules of the Model() if the module doesn't implement the
+  //! Deterministic() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasDeterministicCheck<T, bool&(T::*)(void)>::value &&
+      HasModelCheck<T>::value, bool>::type
+  LayerDeterministic(T* layer) const;
+
+  //! Return false if the module doesn't implement the Deterministic() or
+  //! Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasDeterministicCheck<T, bool&(T::*)(void)>::value &&
+      !HasModelCheck<T>::value, bool>::type
+  LayerDeterministic(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "deterministic_check_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file deterministic_check_visitor_impl.hpp
+ *
+ * Implementation of the Deterministic() check layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_DETERMINISTIC_CHECK_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_DETERMINISTIC_CHECK_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "deterministic_check_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! DeterministicCheckVisitor visitor class.
+template<typename LayerType>
+inline bool DeterministicCheckVisitor::operator()(LayerType* layer) const
+{
+  return LayerDeterministic(layer);
+}
+
+inline bool DeterministicCheckVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasDeterministicCheck<T, bool&(T::*)(void)>::value, bool>::type
+DeterministicCheckVisitor::LayerDeterministic(T* /* layer */) const
+{
+  return true;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasDeterministicCheck<T, bool&(T::*)(void)>::value &&
+    HasModelCheck<T>::value, bool>::type
+DeterministicCheckVisitor::LayerDeterministic(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    if (boost::apply_visitor(DeterministicCheckVisitor(), layer->Model()[i]))
+      return true;
+  }
+
+  return false;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasDeterministicCheck<T, bool&(T::*)(void)>::value &&
+    !HasModelCheck<T>::value, bool>::type
+DeterministicCheckVisitor::LayerDeterministic(T* /* layer */) const
+{
+  return false;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
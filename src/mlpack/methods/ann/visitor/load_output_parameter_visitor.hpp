@@ -31,6 +31,17 @@ class LoadOutputParameterVisitor : public boost::static_visitor<void>
   //! Restore the output parameter given a parameter set.
   LoadOutputParameterVisitor(std::vector<arma::mat>& parameter);
 
+  /**
+   * Restore the output parameter given a parameter set that was filled using
+   * the indexed SaveOutputParameterVisitor.  The matrices are not removed from
+   * the parameter set, so that it can be reused for the next pass; instead the
+   * given position is moved back past the restored output parameters.
+   *
+   * @param parameter The parameter set used as workspace.
+   * @param index Position after the last output parameter to restore.
+   */
+  LoadOutputParameterVisitor(std::vector<arma::mat>& parameter, size_t& index);
+
   //! Restore the output parameter.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
@@ -41,6 +52,13 @@ class LoadOutputParameterVisitor : public boost::static_visitor<void>
   //! The parameter set.
   std::vector<arma::mat>& parameter;
 
+  //! The position after the next output parameter to restore (nullptr to
+  //! remove the restored output parameters from the parameter set).
+  size_t* index;
+
+  //! Restore the given output parameter from the parameter set.
+  void Load(arma::mat& outputParameter) const;
+
   //! Restore the output parameter for a module which doesn't implement the
   //! Model() function.
   template<typename T>
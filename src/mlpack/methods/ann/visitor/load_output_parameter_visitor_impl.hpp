@@ -20,7 +20,15 @@ namespace ann {
 
 //! LoadOutputParameterVisitor visitor class.
 inline LoadOutputParameterVisitor::LoadOutputParameterVisitor(
-    std::vector<arma::mat>& parameter) : parameter(parameter)
+    std::vector<arma::mat>& parameter) : parameter(parameter), index(nullptr)
+{
+  /* Nothing to do here. */
+}
+
+inline LoadOutputParameterVisitor::LoadOutputParameterVisitor(
+    std::vector<arma::mat>& parameter, size_t& index) :
+    parameter(parameter),
+    index(&index)
 {
   /* Nothing to do here. */
 }
@@ -41,8 +49,7 @@ inline typename std::enable_if<
     !HasModelCheck<T>::value, void>::type
 LoadOutputParameterVisitor::OutputParameter(T* layer) const
 {
-  layer->OutputParameter() = parameter.back();
-  parameter.pop_back();
+  Load(layer->OutputParameter());
 }
 
 template<typename T>
@@ -52,12 +59,32 @@ LoadOutputParameterVisitor::OutputParameter(T* layer) const
 {
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    boost::apply_visitor(LoadOutputParameterVisitor(parameter),
-        layer->Model()[layer->Model().size() - i - 1]);
+    if (index)
+    {
+      boost::apply_visitor(LoadOutputParameterVisitor(parameter, *index),
+          layer->Model()[layer->Model().size() - i - 1]);
+    }
+    else
+    {
+      boost::apply_visitor(LoadOutputParameterVisitor(parameter),
+          layer->Model()[layer->Model().size() - i - 1]);
+    }
   }
 
-  layer->OutputParameter() = parameter.back();
-  parameter.pop_back();
+  Load(layer->OutputParameter());
+}
+
+inline void LoadOutputParameterVisitor::Load(arma::mat& outputParameter) const
+{
+  if (index)
+  {
+    outputParameter = parameter[--(*index)];
+  }
+  else
+  {
+    outputParameter = parameter.back();
+    parameter.pop_back();
+  }
 }
 
 } // namespace ann
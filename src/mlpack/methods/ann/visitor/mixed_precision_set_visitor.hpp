@@ -0,0 +1,82 @@
+/**
+ * @file mixed_precision_set_visitor.hpp
+ *
+ * This file provides an abstraction for the MixedPrecision() function for
+ * different layers and automatically directs any parameter to the right layer
+ * type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_MIXED_PRECISION_SET_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_MIXED_PRECISION_SET_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * MixedPrecisionSetVisitor set the mixed precision parameter given the
+ * mixed precision value.
+ */
+class MixedPrecisionSetVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Set the mixed precision parameter given the current mixed precision value.
+  MixedPrecisionSetVisitor(const bool mixedPrecision = true);
+
+  //! Set the mixed precision parameter.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! The mixed precision parameter.
+  const bool mixedPrecision;
+
+  //! Set the mixed precision parameter if the module implements the
+  //! MixedPrecision() and Model() function.
+  template<typename T>
+  typename std::enable_if<
+      HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerMixedPrecision(T* layer) const;
+
+  //! Set the mixed precision parameter if the module implements the
+  //! Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerMixedPrecision(T* layer) const;
+
+  //! Set the mixed precision parameter if the module implements the
+  //! MixedPrecision() function.
+  template<typename T>
+  typename std::enable_if<
+      HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerMixedPrecision(T* layer) const;
+
+  //! Do not set the mixed precision parameter if the module doesn't implement
+  //! the MixedPrecision() or Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerMixedPrecision(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "mixed_precision_set_visitor_impl.hpp"
+
+#endif
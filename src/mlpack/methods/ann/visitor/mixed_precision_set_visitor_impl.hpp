@@ -0,0 +1,87 @@
+/**
+ * @file mixed_precision_set_visitor_impl.hpp
+ *
+ * Implementation of the MixedPrecision() function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_MIXED_PRECISION_SET_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_MIXED_PRECISION_SET_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mixed_precision_set_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! MixedPrecisionSetVisitor visitor class.
+inline MixedPrecisionSetVisitor::MixedPrecisionSetVisitor(
+    const bool mixedPrecision) : mixedPrecision(mixedPrecision)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline void MixedPrecisionSetVisitor::operator()(LayerType* layer) const
+{
+  LayerMixedPrecision(layer);
+}
+
+inline void MixedPrecisionSetVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+    HasModelCheck<T>::value, void>::type
+MixedPrecisionSetVisitor::LayerMixedPrecision(T* layer) const
+{
+  layer->MixedPrecision() = mixedPrecision;
+
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(MixedPrecisionSetVisitor(mixedPrecision),
+        layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+    HasModelCheck<T>::value, void>::type
+MixedPrecisionSetVisitor::LayerMixedPrecision(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(MixedPrecisionSetVisitor(mixedPrecision),
+        layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+    !HasModelCheck<T>::value, void>::type
+MixedPrecisionSetVisitor::LayerMixedPrecision(T* layer) const
+{
+  layer->MixedPrecision() = mixedPrecision;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasMixedPrecisionCheck<T, bool&(T::*)(void)>::value &&
+    !HasModelCheck<T>::value, void>::type
+MixedPrecisionSetVisitor::LayerMixedPrecision(T* /* input */) const
+{
+  /* Nothing to do here. */
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
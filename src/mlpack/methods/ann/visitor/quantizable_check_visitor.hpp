@@ -0,0 +1,67 @@
+/**
+ * @file quantizable_check_visitor.hpp
+ *
+ * This file provides an abstraction to check whether a layer, or any layer it
+ * holds, is replaced by a quantized layer in Quantize().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_QUANTIZABLE_CHECK_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_QUANTIZABLE_CHECK_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/convolution.hpp>
+#include <mlpack/methods/ann/layer/linear.hpp>
+#include <mlpack/methods/ann/layer/linear_no_bias.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * QuantizableCheckVisitor returns true if the given module, or any module in
+ * its Model(), is a Linear, LinearNoBias or Convolution layer, i.e. a layer
+ * that Quantize() replaces by its int8 counterpart.
+ */
+class QuantizableCheckVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Check the Model() of the module, if it has one.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  //! The Linear layer is replaced by a QuantizedLinear layer.
+  bool operator()(Linear<>* layer) const;
+
+  //! The LinearNoBias layer is replaced by a QuantizedLinear layer.
+  bool operator()(LinearNoBias<>* layer) const;
+
+  //! The Convolution layer is replaced by a QuantizedConvolution layer.
+  bool operator()(Convolution<>* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+
+ private:
+  //! Check the modules of the Model() of the module.
+  template<typename T>
+  typename std::enable_if<HasModelCheck<T>::value, bool>::type
+  LayerQuantizable(T* layer) const;
+
+  //! Return false if the module doesn't implement the Model() function.
+  template<typename T>
+  typename std::enable_if<!HasModelCheck<T>::value, bool>::type
+  LayerQuantizable(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantizable_check_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file quantizable_check_visitor_impl.hpp
+ *
+ * Implementation of the quantizable check layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_QUANTIZABLE_CHECK_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_QUANTIZABLE_CHECK_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantizable_check_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! QuantizableCheckVisitor visitor class.
+template<typename LayerType>
+inline bool QuantizableCheckVisitor::operator()(LayerType* layer) const
+{
+  return LayerQuantizable(layer);
+}
+
+inline bool QuantizableCheckVisitor::operator()(Linear<>* /* layer */) const
+{
+  return true;
+}
+
+inline bool QuantizableCheckVisitor::operator()(
+    LinearNoBias<>* /* layer */) const
+{
+  return true;
+}
+
+inline bool QuantizableCheckVisitor::operator()(
+    Convolution<>* /* layer */) const
+{
+  return true;
+}
+
+inline bool QuantizableCheckVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<HasModelCheck<T>::value, bool>::type
+QuantizableCheckVisitor::LayerQuantizable(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    if (boost::apply_visitor(QuantizableCheckVisitor(), layer->Model()[i]))
+      return true;
+  }
+
+  return false;
+}
+
+template<typename T>
+inline typename std::enable_if<!HasModelCheck<T>::value, bool>::type
+QuantizableCheckVisitor::LayerQuantizable(T* /* layer */) const
+{
+  return false;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
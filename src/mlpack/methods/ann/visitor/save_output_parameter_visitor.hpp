@@ -30,6 +30,18 @@ class SaveOutputParameterVisitor : public boost::static_visitor<void>
   //! Save the output parameter into the given parameter set.
   SaveOutputParameterVisitor(std::vector<arma::mat>& parameter);
 
+  /**
+   * Save the output parameter into the given parameter set, starting at the
+   * given position.  Existing matrices in the parameter set are overwritten
+   * instead of appending new ones, so a parameter set that is reused for
+   * several passes does not allocate memory once it holds all outputs.  The
+   * position is advanced past the saved output parameters.
+   *
+   * @param parameter The parameter set used as workspace.
+   * @param index Position to save the next output parameter at.
+   */
+  SaveOutputParameterVisitor(std::vector<arma::mat>& parameter, size_t& index);
+
   //! Save the output parameter.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
@@ -40,6 +52,12 @@ class SaveOutputParameterVisitor : public boost::static_visitor<void>
   //! The parameter set.
   std::vector<arma::mat>& parameter;
 
+  //! The position to save the next output parameter at (nullptr to append).
+  size_t* index;
+
+  //! Save the given output parameter into the parameter set.
+  void Save(const arma::mat& outputParameter) const;
+
   //! Save the output parameter for a module which doesn't implement the
   //! Model() function.
   template<typename T>
@@ -20,7 +20,15 @@ namespace ann {
 
 //! SaveOutputParameterVisitor visitor class.
 inline SaveOutputParameterVisitor::SaveOutputParameterVisitor(
-    std::vector<arma::mat>& parameter) : parameter(parameter)
+    std::vector<arma::mat>& parameter) : parameter(parameter), index(nullptr)
+{
+  /* Nothing to do here. */
+}
+
+inline SaveOutputParameterVisitor::SaveOutputParameterVisitor(
+    std::vector<arma::mat>& parameter, size_t& index) :
+    parameter(parameter),
+    index(&index)
 {
   /* Nothing to do here. */
 }
@@ -41,7 +49,7 @@ inline typename std::enable_if<
     !HasModelCheck<T>::value, void>::type
 SaveOutputParameterVisitor::OutputParameter(T* layer) const
 {
-  parameter.push_back(layer->OutputParameter());
+  Save(layer->OutputParameter());
 }
 
 template<typename T>
@@ -49,15 +57,40 @@ inline typename std::enable_if<
     HasModelCheck<T>::value, void>::type
 SaveOutputParameterVisitor::OutputParameter(T* layer) const
 {
-  parameter.push_back(layer->OutputParameter());
+  Save(layer->OutputParameter());
 
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    boost::apply_visitor(SaveOutputParameterVisitor(parameter),
-        layer->Model()[i]);
+    if (index)
+    {
+      boost::apply_visitor(SaveOutputParameterVisitor(parameter, *index),
+          layer->Model()[i]);
+    }
+    else
+    {
+      boost::apply_visitor(SaveOutputParameterVisitor(parameter),
+          layer->Model()[i]);
+    }
   }
 }
 
+inline void SaveOutputParameterVisitor::Save(
+    const arma::mat& outputParameter) const
+{
+  if (index && *index < parameter.size())
+  {
+    // Reuse the memory of the stored matrix if the size didn't change.
+    parameter[*index] = outputParameter;
+  }
+  else
+  {
+    parameter.push_back(outputParameter);
+  }
+
+  if (index)
+    ++(*index);
+}
+
 } // namespace ann
 } // namespace mlpack
 
@@ -0,0 +1,51 @@
+/**
+ * @file sparse_gradient_visitor_impl.hpp
+ *
+ * Implementation of the Gradient() function layer abstraction for a sparse
+ * input.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_SPARSE_GRADIENT_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_SPARSE_GRADIENT_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sparse_gradient_visitor.hpp"
+#include "gradient_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! SparseGradientVisitor visitor class.
+inline SparseGradientVisitor::SparseGradientVisitor(const arma::sp_mat& input,
+                                                    const arma::mat& delta) :
+    input(input),
+    delta(delta)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline void SparseGradientVisitor::operator()(LayerType* layer) const
+{
+  const arma::mat denseInput(input);
+  GradientVisitor(denseInput, delta)(layer);
+}
+
+inline void SparseGradientVisitor::operator()(Linear<>* layer) const
+{
+  layer->Gradient(input, delta, layer->Gradient());
+}
+
+inline void SparseGradientVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
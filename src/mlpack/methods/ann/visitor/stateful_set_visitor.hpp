@@ -0,0 +1,82 @@
+/**
+ * @file stateful_set_visitor.hpp
+ *
+ * This file provides an abstraction for the Stateful() function for
+ * different layers and automatically directs any parameter to the right layer
+ * type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_STATEFUL_SET_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_STATEFUL_SET_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * StatefulSetVisitor set the stateful parameter given the
+ * stateful value.
+ */
+class StatefulSetVisitor : public boost::static_visitor<void>
+{
+ public:
+  //! Set the stateful parameter given the current stateful value.
+  StatefulSetVisitor(const bool stateful = true);
+
+  //! Set the stateful parameter.
+  template<typename LayerType>
+  void operator()(LayerType* layer) const;
+
+  void operator()(MoreTypes layer) const;
+
+ private:
+  //! The stateful parameter.
+  const bool stateful;
+
+  //! Set the stateful parameter if the module implements the
+  //! Stateful() and Model() function.
+  template<typename T>
+  typename std::enable_if<
+      HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerStateful(T* layer) const;
+
+  //! Set the stateful parameter if the module implements the
+  //! Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+      HasModelCheck<T>::value, void>::type
+  LayerStateful(T* layer) const;
+
+  //! Set the stateful parameter if the module implements the
+  //! Stateful() function.
+  template<typename T>
+  typename std::enable_if<
+      HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerStateful(T* layer) const;
+
+  //! Do not set the stateful parameter if the module doesn't implement the
+  //! Stateful() or Model() function.
+  template<typename T>
+  typename std::enable_if<
+      !HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+      !HasModelCheck<T>::value, void>::type
+  LayerStateful(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "stateful_set_visitor_impl.hpp"
+
+#endif
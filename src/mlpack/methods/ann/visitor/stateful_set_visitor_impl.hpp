@@ -0,0 +1,87 @@
+/**
+ * @file stateful_set_visitor_impl.hpp
+ *
+ * Implementation of the Stateful() function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_STATEFUL_SET_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_STATEFUL_SET_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stateful_set_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! StatefulSetVisitor visitor class.
+inline StatefulSetVisitor::StatefulSetVisitor(
+    const bool stateful) : stateful(stateful)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline void StatefulSetVisitor::operator()(LayerType* layer) const
+{
+  LayerStateful(layer);
+}
+
+inline void StatefulSetVisitor::operator()(MoreTypes layer) const
+{
+  layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+    HasModelCheck<T>::value, void>::type
+StatefulSetVisitor::LayerStateful(T* layer) const
+{
+  layer->Stateful() = stateful;
+
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(StatefulSetVisitor(stateful),
+        layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+    HasModelCheck<T>::value, void>::type
+StatefulSetVisitor::LayerStateful(T* layer) const
+{
+  for (size_t i = 0; i < layer->Model().size(); ++i)
+  {
+    boost::apply_visitor(StatefulSetVisitor(stateful),
+        layer->Model()[i]);
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+    !HasModelCheck<T>::value, void>::type
+StatefulSetVisitor::LayerStateful(T* layer) const
+{
+  layer->Stateful() = stateful;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasStatefulCheck<T, bool&(T::*)(void)>::value &&
+    !HasModelCheck<T>::value, void>::type
+StatefulSetVisitor::LayerStateful(T* /* input */) const
+{
+  /* Nothing to do here. */
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_NUMERIC_SPLIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "numeric_split_traits.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -62,6 +63,37 @@ class BestBinaryNumericSplit
       arma::Col<typename VecType::elem_type>& classProbabilities,
       AuxiliarySplitInfo<typename VecType::elem_type>& aux);
 
+  /**
+   * Check if we can split a node, given the indices that sort the data of the
+   * node.  This behaves like the overload above, but does not need to sort
+   * the data itself.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param sortedIndices Indices that sort the data in ascending order.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::uvec& sortedIndices,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::Col<typename VecType::elem_type>& classProbabilities,
+      AuxiliarySplitInfo<typename VecType::elem_type>& aux);
+
   /**
    * Returns 2, since the binary split always has two children.
    */
@@ -86,6 +118,16 @@ class BestBinaryNumericSplit
       const AuxiliarySplitInfo<ElemType>& /* aux */);
 };
 
+//! The best binary numeric split can work with presorted data.
+template<typename FitnessFunction>
+class NumericSplitTraits<BestBinaryNumericSplit<FitnessFunction>>
+{
+ public:
+  static const bool UsesSortedIndices = true;
+  static const bool UsesBinnedData = false;
+  static const bool UsesThreshold = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -17,8 +17,11 @@
 #include "gini_gain.hpp"
 #include "information_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "all_dimension_select.hpp"
+#include "numeric_split_traits.hpp"
+#include "flat_decision_tree.hpp"
 #include <type_traits>
 
 namespace mlpack {
@@ -30,6 +33,18 @@ namespace tree {
  *
  * The class inherits from the auxiliary split information in order to prevent
  * an empty auxiliary split information struct from taking any extra size.
+ *
+ * The candidate dimensions of a node are searched in parallel when OpenMP is
+ * available; the chosen split is the same one a search of the dimensions in
+ * order would choose.  If the numeric split type can use sorted indices (see
+ * NumericSplitTraits), every dimension is sorted once before training and the
+ * sorted order is carried down to the children, instead of sorting the data
+ * again at every node.  In the same way, if the numeric split type works with
+ * binned data (like HistogramNumericSplit), the data is binned once and the
+ * bins are carried down to the children.
+ *
+ * For fast classification of many points, a trained tree can be compiled into
+ * a FlatDecisionTree.
  */
 template<typename FitnessFunction = GiniGain,
          template<typename> class NumericSplitType = BestBinaryNumericSplit,
@@ -467,6 +482,19 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  { return (data::Datatype) dimensionTypeOrMajorityClass; }
+
+  //! Get the majority class (only meaningful if this is a leaf in a trained
+  //! tree).
+  size_t MajorityClass() const { return dimensionTypeOrMajorityClass; }
+
+  //! Get the class probabilities of a leaf, or the information used by the
+  //! split type to pick a child for a non-leaf.
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -517,8 +545,9 @@ class DecisionTree :
 
   /**
    * Corresponding to the public Train() method, this method is designed for
-   * avoiding unnecessary copies during training.  This function is called to
-   * train children.
+   * avoiding unnecessary copies during training.  This function sorts or bins
+   * the data if the numeric split type can use that, and then trains the
+   * tree.
    *
    * @param data Dataset to train on.
    * @param begin Index of the starting point in the dataset that belongs to
@@ -545,10 +574,48 @@ class DecisionTree :
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
 
+  /**
+   * Train the node on the given data, given the indices that sort the points of
+   * the node in every dimension or the bins of the points.  The sorted indices
+   * and the bins are kept up to date when the points are split between the
+   * children.  If both are empty, the numeric split type works on the data by
+   * itself.
+   *
+   * @param data Dataset to train on.
+   * @param begin Index of the starting point in the dataset that belongs to
+   *      this node.
+   * @param count Number of points in this node.
+   * @param datasetInfo Type information for each dimension.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param sortedIndices Indices (relative to begin) that sort the points of
+   *      the node, one column per dimension.
+   * @param bins Bin of every point, one column per dimension.
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType>
+  double Train(MatType& data,
+               const size_t begin,
+               const size_t count,
+               const data::DatasetInfo& datasetInfo,
+               arma::Row<size_t>& labels,
+               const size_t numClasses,
+               arma::rowvec& weights,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector,
+               arma::umat& sortedIndices,
+               arma::Mat<unsigned char>& bins);
+
   /**
    * Corresponding to the public Train() method, this method is designed for
-   * avoiding unnecessary copies during training.  This method is called for
-   * training children.
+   * avoiding unnecessary copies during training.  This method sorts or bins
+   * the data if the numeric split type can use that, and then trains the
+   * tree.
    *
    * @param data Dataset to train on.
    * @param begin Index of the starting point in the dataset that belongs to
@@ -572,6 +639,166 @@ class DecisionTree :
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Train the node on the given data, assuming that all dimensions are numeric
+   * and given the indices that sort the points of the node in every dimension
+   * or the bins of the points.  The sorted indices and the bins are kept up to
+   * date when the points are split between the children.  If both are empty,
+   * the numeric split type works on the data by itself.
+   *
+   * @param data Dataset to train on.
+   * @param begin Index of the starting point in the dataset that belongs to
+   *      this node.
+   * @param count Number of points in this node.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param sortedIndices Indices (relative to begin) that sort the points of
+   *      the node, one column per dimension.
+   * @param bins Bin of every point, one column per dimension.
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType>
+  double Train(MatType& data,
+               const size_t begin,
+               const size_t count,
+               arma::Row<size_t>& labels,
+               const size_t numClasses,
+               arma::rowvec& weights,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector,
+               arma::umat& sortedIndices,
+               arma::Mat<unsigned char>& bins);
+
+  /**
+   * Sort the points of the given dataset in every dimension, if the numeric
+   * split type can use sorted indices, every dimension is searched at each
+   * node (AllDimensionSelect), and the tree may grow deeper than one level.
+   * Otherwise sortedIndices is left empty.  The sorted indices take as much
+   * memory as a dataset of size_t.
+   *
+   * @param data Dataset to sort.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param sortedIndices Matrix to store the sorted indices in, one column per
+   *      dimension.
+   */
+  template<typename MatType>
+  static void SortDimensions(const MatType& data,
+                             const size_t maximumDepth,
+                             arma::umat& sortedIndices);
+
+  /**
+   * Bin the points of the given dataset in every dimension with the numeric
+   * split type, if it works with binned data.  The bins take an eighth of the
+   * memory of a dataset of doubles.
+   *
+   * @param data Dataset to bin.
+   * @param bins Matrix to store the bins in, one column per dimension.
+   */
+  template<typename MatType, typename SplitType = NumericSplit>
+  static typename std::enable_if<
+      NumericSplitTraits<SplitType>::UsesBinnedData, void>::type
+  BinDimensions(const MatType& data, arma::Mat<unsigned char>& bins);
+
+  /**
+   * Leave the bins empty, since the numeric split type does not use them.
+   */
+  template<typename MatType, typename SplitType = NumericSplit>
+  static typename std::enable_if<
+      !NumericSplitTraits<SplitType>::UsesBinnedData, void>::type
+  BinDimensions(const MatType& data, arma::Mat<unsigned char>& bins);
+
+  /**
+   * After the points of a node have been split between its children, split
+   * the sorted indices of the node the same way, so that every child gets the
+   * indices that sort its own points.
+   *
+   * @param sortedIndices Sorted indices of the whole dataset.
+   * @param begin Index of the first point of the node.
+   * @param positions The new position (relative to begin) of every point of
+   *      the node, indexed by its old position.
+   * @param childAssignments The child of every point, indexed by its old
+   *      position.
+   * @param childCounts The number of points in each child.
+   */
+  static void SplitSortedIndices(arma::umat& sortedIndices,
+                                 const size_t begin,
+                                 const arma::uvec& positions,
+                                 const arma::Row<size_t>& childAssignments,
+                                 const arma::Row<size_t>& childCounts);
+
+  /**
+   * Call the SplitIfBetter() overload of the numeric split type that takes
+   * sorted indices, unless there are none.
+   */
+  template<bool UseWeights,
+           typename VecType,
+           typename WeightVecType,
+           typename SplitType = NumericSplit>
+  static typename std::enable_if<
+      NumericSplitTraits<SplitType>::UsesSortedIndices &&
+      !NumericSplitTraits<SplitType>::UsesBinnedData, double>::type
+  NumericSplitIfBetter(const double bestGain,
+                       const VecType& data,
+                       const arma::uvec& sortedIndices,
+                       const arma::Col<unsigned char>& bins,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const WeightVecType& weights,
+                       const size_t minimumLeafSize,
+                       const double minimumGainSplit,
+                       arma::vec& classProbabilities,
+                       NumericAuxiliarySplitInfo& aux);
+
+  /**
+   * Call the SplitIfBetter() overload of the numeric split type that takes
+   * the bins of the points, unless there are none.
+   */
+  template<bool UseWeights,
+           typename VecType,
+           typename WeightVecType,
+           typename SplitType = NumericSplit>
+  static typename std::enable_if<
+      NumericSplitTraits<SplitType>::UsesBinnedData, double>::type
+  NumericSplitIfBetter(const double bestGain,
+                       const VecType& data,
+                       const arma::uvec& sortedIndices,
+                       const arma::Col<unsigned char>& bins,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const WeightVecType& weights,
+                       const size_t minimumLeafSize,
+                       const double minimumGainSplit,
+                       arma::vec& classProbabilities,
+                       NumericAuxiliarySplitInfo& aux);
+
+  /**
+   * Call the SplitIfBetter() method of a numeric split type that uses neither
+   * sorted indices nor bins.
+   */
+  template<bool UseWeights,
+           typename VecType,
+           typename WeightVecType,
+           typename SplitType = NumericSplit>
+  static typename std::enable_if<
+      !NumericSplitTraits<SplitType>::UsesSortedIndices &&
+      !NumericSplitTraits<SplitType>::UsesBinnedData, double>::type
+  NumericSplitIfBetter(const double bestGain,
+                       const VecType& data,
+                       const arma::uvec& sortedIndices,
+                       const arma::Col<unsigned char>& bins,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const WeightVecType& weights,
+                       const size_t minimumLeafSize,
+                       const double minimumGainSplit,
+                       arma::vec& classProbabilities,
+                       NumericAuxiliarySplitInfo& aux);
 };
 
 /**
@@ -655,7 +655,8 @@ double DecisionTree<FitnessFunction,
       dimensionSelector);
 }
 
-//! Train on the given data, assuming all dimensions are numeric.
+//! Train on the given data, sorting or binning it first if the split type can
+//! use that.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType,
@@ -680,6 +681,83 @@ double DecisionTree<FitnessFunction,
     const double minimumGainSplit,
     const size_t maximumDepth,
     DimensionSelectionType& dimensionSelector)
+{
+  arma::umat sortedIndices;
+  SortDimensions(data.cols(begin, begin + count - 1), maximumDepth,
+      sortedIndices);
+  arma::Mat<unsigned char> bins;
+  BinDimensions(data.cols(begin, begin + count - 1), bins);
+
+  return Train<UseWeights>(data, begin, count, datasetInfo, labels, numClasses,
+      weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, sortedIndices, bins);
+}
+
+//! Train on the given data, sorting or binning it first if the split type can
+//! use that.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    MatType& data,
+    const size_t begin,
+    const size_t count,
+    arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector)
+{
+  arma::umat sortedIndices;
+  SortDimensions(data.cols(begin, begin + count - 1), maximumDepth,
+      sortedIndices);
+  arma::Mat<unsigned char> bins;
+  BinDimensions(data.cols(begin, begin + count - 1), bins);
+
+  return Train<UseWeights>(data, begin, count, labels, numClasses, weights,
+      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+      sortedIndices, bins);
+}
+
+//! Train on the given data, given the sorted indices or the bins of every
+//! dimension.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    MatType& data,
+    const size_t begin,
+    const size_t count,
+    const data::DatasetInfo& datasetInfo,
+    arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector,
+    arma::umat& sortedIndices,
+    arma::Mat<unsigned char>& bins)
 {
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
@@ -700,13 +778,27 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Collect the dimensions to look through, so they can be searched in
+    // parallel.
+    std::vector<size_t> dimensions;
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // Every dimension gets its own split information, since the searches may
+    // run at the same time.
+    std::vector<double> gains(dimensions.size());
+    std::vector<arma::vec> splitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAux(
+        dimensions.size());
+
+    auto search = [&](const size_t k, const double gain) -> double
     {
-      double dimGain = -DBL_MAX;
+      const size_t i = dimensions[k];
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        return CategoricalSplit::template SplitIfBetter<UseWeights>(gain,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
@@ -714,30 +806,66 @@ double DecisionTree<FitnessFunction,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo[k],
+            categoricalAux[k]);
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        const arma::uvec sorted = sortedIndices.is_empty() ? arma::uvec() :
+            arma::uvec(sortedIndices.colptr(i) + begin, count, false, true);
+        const arma::Col<unsigned char> binned = bins.is_empty() ?
+            arma::Col<unsigned char>() :
+            arma::Col<unsigned char>(bins.colptr(i) + begin, count, false,
+            true);
+        return NumericSplitIfBetter<UseWeights>(gain,
             data.cols(begin, begin + count - 1).row(i),
+            sorted,
+            binned,
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo[k],
+            numericAux[k]);
       }
 
+      return DBL_MAX;
+    };
+
+    // Search every dimension against the gain of this node.  Small nodes are
+    // not worth the threads.
+    #pragma omp parallel for schedule(dynamic) if (count >= 64)
+    for (omp_size_t k = 0; k < (omp_size_t) dimensions.size(); ++k)
+      gains[k] = search(k, bestGain);
+
+    // Now take the dimensions in order, as a serial search would.  Only the
+    // first split was found against the right gain; a later dimension has to
+    // beat the best split before it, so it is searched again against that
+    // gain if it could.
+    for (size_t k = 0; k < dimensions.size(); ++k)
+    {
       // If the splitter reported that it did not split, move to the next
       // dimension.
-      if (dimGain == DBL_MAX)
+      if (gains[k] == DBL_MAX)
         continue;
 
-      // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
+      if (bestDim != datasetInfo.Dimensionality())
+      {
+        if (gains[k] <= bestGain)
+          continue;
+
+        gains[k] = search(k, bestGain);
+        if (gains[k] == DBL_MAX)
+          continue;
+      }
+
+      // There was an improvement, so mark that it's the new best dimension.
+      bestDim = dimensions[k];
+      bestGain = gains[k];
+      classProbabilities = splitInfo[k];
+      NumericAuxiliarySplitInfo::operator=(numericAux[k]);
+      CategoricalAuxiliarySplitInfo::operator=(categoricalAux[k]);
 
       // If the gain is the best possible, no need to keep looking.
       if (bestGain >= 0.0)
@@ -786,12 +914,19 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
+    // If we have sorted indices, remember where every point came from, so the
+    // indices can follow the points.
+    const arma::Row<size_t> oldAssignments = sortedIndices.is_empty() ?
+        arma::Row<size_t>() : childAssignments;
+    arma::uvec order;
+    if (!sortedIndices.is_empty())
+      order = arma::regspace<arma::uvec>(0, count - 1);
+
     // Split into children.
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -800,29 +935,48 @@ double DecisionTree<FitnessFunction,
           labels.swap_cols(currentCol, j);
           if (UseWeights)
             weights.swap_cols(currentCol, j);
+          if (!sortedIndices.is_empty())
+            order.swap_rows(currentCol - begin, j - begin);
+          if (!bins.is_empty())
+            bins.swap_rows(currentCol, j);
           ++currentCol;
         }
       }
+    }
+
+    if (!sortedIndices.is_empty())
+    {
+      arma::uvec positions(count);
+      for (size_t j = 0; j < count; ++j)
+        positions[order[j]] = j;
+
+      SplitSortedIndices(sortedIndices, begin, positions, oldAssignments,
+          childCounts);
+    }
 
-      // Now build the child recursively.
+    // Now build the children recursively.
+    size_t currentChildBegin = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
       DecisionTree* child = new DecisionTree();
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
+        child->Train<UseWeights>(data, currentChildBegin, childCounts[i],
+            datasetInfo, labels, numClasses, weights, childCounts[i],
+            minimumGainSplit, maximumDepth - 1, dimensionSelector,
+            sortedIndices, bins);
       }
       else
       {
         // During recursion entropy of child node may change.
         double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+            childCounts[i], datasetInfo, labels, numClasses, weights,
+            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+            dimensionSelector, sortedIndices, bins);
         bestGain += double(childCounts[i]) / double(count) * (-childGain);
       }
       children.push_back(child);
+      currentChildBegin += childCounts[i];
     }
   }
   else
@@ -841,7 +995,8 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
-//! Train on the given data, assuming all dimensions are numeric.
+//! Train on the given data, assuming all dimensions are numeric, given the
+//! sorted indices or the bins of every dimension.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType,
@@ -864,7 +1019,9 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    arma::umat& sortedIndices,
+    arma::Mat<unsigned char>& bins)
 {
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
@@ -887,29 +1044,71 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Collect the dimensions to look through, so they can be searched in
+    // parallel.
+    std::vector<size_t> dimensions;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
-    {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
-                                    labels.cols(begin, begin + count - 1),
-                                    numClasses,
-                                    UseWeights ?
-                                        weights.cols(begin, begin + count - 1) :
-                                        weights,
-                                    minimumLeafSize,
-                                    minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
+      dimensions.push_back(i);
+
+    // Every dimension gets its own split information, since the searches may
+    // run at the same time.
+    std::vector<double> gains(dimensions.size());
+    std::vector<arma::vec> splitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
 
+    auto search = [&](const size_t k, const double gain) -> double
+    {
+      const size_t i = dimensions[k];
+      const arma::uvec sorted = sortedIndices.is_empty() ? arma::uvec() :
+          arma::uvec(sortedIndices.colptr(i) + begin, count, false, true);
+      const arma::Col<unsigned char> binned = bins.is_empty() ?
+          arma::Col<unsigned char>() :
+          arma::Col<unsigned char>(bins.colptr(i) + begin, count, false, true);
+      return NumericSplitIfBetter<UseWeights>(gain,
+          data.cols(begin, begin + count - 1).row(i),
+          sorted,
+          binned,
+          labels.cols(begin, begin + count - 1),
+          numClasses,
+          UseWeights ? weights.cols(begin, begin + count - 1) : weights,
+          minimumLeafSize,
+          minimumGainSplit,
+          splitInfo[k],
+          numericAux[k]);
+    };
+
+    // Search every dimension against the gain of this node.  Small nodes are
+    // not worth the threads.
+    #pragma omp parallel for schedule(dynamic) if (count >= 64)
+    for (omp_size_t k = 0; k < (omp_size_t) dimensions.size(); ++k)
+      gains[k] = search(k, bestGain);
+
+    // Now take the dimensions in order, as a serial search would.  Only the
+    // first split was found against the right gain; a later dimension has to
+    // beat the best split before it, so it is searched again against that
+    // gain if it could.
+    for (size_t k = 0; k < dimensions.size(); ++k)
+    {
       // If the splitter did not report that it improved, then move to the next
       // dimension.
-      if (dimGain == DBL_MAX)
+      if (gains[k] == DBL_MAX)
         continue;
 
-      bestDim = i;
-      bestGain = dimGain;
+      if (bestDim != data.n_rows)
+      {
+        if (gains[k] <= bestGain)
+          continue;
+
+        gains[k] = search(k, bestGain);
+        if (gains[k] == DBL_MAX)
+          continue;
+      }
+
+      bestDim = dimensions[k];
+      bestGain = gains[k];
+      classProbabilities = splitInfo[k];
+      NumericAuxiliarySplitInfo::operator=(numericAux[k]);
 
       // If the gain is the best possible, no need to keep looking.
       if (bestGain >= 0.0)
@@ -946,11 +1145,18 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
+    // If we have sorted indices, remember where every point came from, so the
+    // indices can follow the points.
+    const arma::Row<size_t> oldAssignments = sortedIndices.is_empty() ?
+        arma::Row<size_t>() : childAssignments;
+    arma::uvec order;
+    if (!sortedIndices.is_empty())
+      order = arma::regspace<arma::uvec>(0, count - 1);
+
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -959,29 +1165,47 @@ double DecisionTree<FitnessFunction,
           labels.swap_cols(currentCol, j);
           if (UseWeights)
             weights.swap_cols(currentCol, j);
+          if (!sortedIndices.is_empty())
+            order.swap_rows(currentCol - begin, j - begin);
+          if (!bins.is_empty())
+            bins.swap_rows(currentCol, j);
           ++currentCol;
         }
       }
+    }
+
+    if (!sortedIndices.is_empty())
+    {
+      arma::uvec positions(count);
+      for (size_t j = 0; j < count; ++j)
+        positions[order[j]] = j;
 
-      // Now build the child recursively.
+      SplitSortedIndices(sortedIndices, begin, positions, oldAssignments,
+          childCounts);
+    }
+
+    // Now build the children recursively.
+    size_t currentChildBegin = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
       DecisionTree* child = new DecisionTree();
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+        child->Train<UseWeights>(data, currentChildBegin, childCounts[i],
+            labels, numClasses, weights, childCounts[i], minimumGainSplit,
+            maximumDepth - 1, dimensionSelector, sortedIndices, bins);
       }
       else
       {
         // During recursion entropy of child node may change.
         double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+            childCounts[i], labels, numClasses, weights, minimumLeafSize,
+            minimumGainSplit, maximumDepth - 1, dimensionSelector,
+            sortedIndices, bins);
         bestGain += double(childCounts[i]) / double(count) * (-childGain);
       }
       children.push_back(child);
+      currentChildBegin += childCounts[i];
     }
   }
   else
@@ -999,6 +1223,260 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
+//! Sort every dimension of the data, if the split type can use it.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::SortDimensions(const MatType& data,
+                                               const size_t maximumDepth,
+                                               arma::umat& sortedIndices)
+{
+  // The root is the only node that could split, so each dimension would only
+  // be sorted once anyway.  When only some dimensions are searched at each
+  // node, keeping every dimension sorted costs more than it saves.
+  if (!NumericSplitTraits<NumericSplit>::UsesSortedIndices || NoRecursion ||
+      maximumDepth == 1 ||
+      !std::is_same<DimensionSelectionType, AllDimensionSelect>::value)
+  {
+    sortedIndices.reset();
+    return;
+  }
+
+  sortedIndices.set_size(data.n_cols, data.n_rows);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_rows; ++i)
+    sortedIndices.col(i) = arma::sort_index(data.row(i));
+}
+
+//! Bin every dimension of the data with the split type.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType, typename SplitType>
+typename std::enable_if<
+    NumericSplitTraits<SplitType>::UsesBinnedData, void>::type
+DecisionTree<FitnessFunction,
+             NumericSplitType,
+             CategoricalSplitType,
+             DimensionSelectionType,
+             ElemType,
+             NoRecursion>::BinDimensions(const MatType& data,
+                                         arma::Mat<unsigned char>& bins)
+{
+  SplitType::Bin(data, bins);
+}
+
+//! The split type does not use bins.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType, typename SplitType>
+typename std::enable_if<
+    !NumericSplitTraits<SplitType>::UsesBinnedData, void>::type
+DecisionTree<FitnessFunction,
+             NumericSplitType,
+             CategoricalSplitType,
+             DimensionSelectionType,
+             ElemType,
+             NoRecursion>::BinDimensions(const MatType& /* data */,
+                                         arma::Mat<unsigned char>& bins)
+{
+  bins.reset();
+}
+
+//! Split the sorted indices of a node between its children.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::SplitSortedIndices(
+    arma::umat& sortedIndices,
+    const size_t begin,
+    const arma::uvec& positions,
+    const arma::Row<size_t>& childAssignments,
+    const arma::Row<size_t>& childCounts)
+{
+  const size_t count = positions.n_elem;
+
+  // Find where each child starts, relative to begin.
+  arma::Row<size_t> childBegins(childCounts.n_elem);
+  size_t childBegin = 0;
+  for (size_t i = 0; i < childCounts.n_elem; ++i)
+  {
+    childBegins[i] = childBegin;
+    childBegin += childCounts[i];
+  }
+
+  // Walking through a dimension in sorted order and sending every point to
+  // its child keeps the indices of each child sorted.
+  #pragma omp parallel if (count >= 64)
+  {
+    arma::uvec buffer(count);
+    arma::Row<size_t> next(childCounts.n_elem);
+
+    #pragma omp for
+    for (omp_size_t d = 0; d < (omp_size_t) sortedIndices.n_cols; ++d)
+    {
+      arma::uword* column = sortedIndices.colptr(d) + begin;
+      next = childBegins;
+      for (size_t j = 0; j < count; ++j)
+      {
+        const size_t child = childAssignments[column[j]];
+        buffer[next[child]++] = positions[column[j]] - childBegins[child];
+      }
+
+      std::copy(buffer.begin(), buffer.end(), column);
+    }
+  }
+}
+
+//! Use the sorted indices, if there are any.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights,
+         typename VecType,
+         typename WeightVecType,
+         typename SplitType>
+typename std::enable_if<
+    NumericSplitTraits<SplitType>::UsesSortedIndices &&
+    !NumericSplitTraits<SplitType>::UsesBinnedData, double>::type
+DecisionTree<FitnessFunction,
+             NumericSplitType,
+             CategoricalSplitType,
+             DimensionSelectionType,
+             ElemType,
+             NoRecursion>::NumericSplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::uvec& sortedIndices,
+    const arma::Col<unsigned char>& /* bins */,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& classProbabilities,
+    NumericAuxiliarySplitInfo& aux)
+{
+  if (sortedIndices.is_empty())
+  {
+    return SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+        labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+        classProbabilities, aux);
+  }
+
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+      sortedIndices, labels, numClasses, weights, minimumLeafSize,
+      minimumGainSplit, classProbabilities, aux);
+}
+
+//! Use the bins, if there are any.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights,
+         typename VecType,
+         typename WeightVecType,
+         typename SplitType>
+typename std::enable_if<
+    NumericSplitTraits<SplitType>::UsesBinnedData, double>::type
+DecisionTree<FitnessFunction,
+             NumericSplitType,
+             CategoricalSplitType,
+             DimensionSelectionType,
+             ElemType,
+             NoRecursion>::NumericSplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::uvec& /* sortedIndices */,
+    const arma::Col<unsigned char>& bins,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& classProbabilities,
+    NumericAuxiliarySplitInfo& aux)
+{
+  if (bins.is_empty())
+  {
+    return SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+        labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+        classProbabilities, aux);
+  }
+
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data, bins,
+      labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+      classProbabilities, aux);
+}
+
+//! The split type works on the data by itself.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights,
+         typename VecType,
+         typename WeightVecType,
+         typename SplitType>
+typename std::enable_if<
+    !NumericSplitTraits<SplitType>::UsesSortedIndices &&
+    !NumericSplitTraits<SplitType>::UsesBinnedData, double>::type
+DecisionTree<FitnessFunction,
+             NumericSplitType,
+             CategoricalSplitType,
+             DimensionSelectionType,
+             ElemType,
+             NoRecursion>::NumericSplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::uvec& /* sortedIndices */,
+    const arma::Col<unsigned char>& /* bins */,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& classProbabilities,
+    NumericAuxiliarySplitInfo& aux)
+{
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data, labels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit,
+      classProbabilities, aux);
+}
+
 //! Return the class.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -0,0 +1,201 @@
+/**
+ * @file flat_decision_tree.hpp
+ *
+ * A compiled, array-based form of a trained decision tree for fast
+ * classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "numeric_split_traits.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A FlatDecisionTree holds a trained DecisionTree as a few contiguous arrays
+ * instead of a tree of heap-allocated nodes, so that classifying a point only
+ * touches a small block of memory.  The nodes are packed in breadth-first
+ * order, so the children of a node are adjacent and the top levels of the
+ * tree, which every point visits, share a few cache lines.
+ *
+ * When a set of points is classified, the points are walked down the tree in
+ * small groups, one level at a time for the whole group, so that the loads of
+ * the different points are independent of each other.  The predictions are
+ * exactly those of the DecisionTree the FlatDecisionTree was built from.
+ *
+ * The numeric split type of the tree must split on a threshold (see
+ * NumericSplitTraits::UsesThreshold), and the categorical split type must send
+ * a point to the child whose index is the category of the point, like
+ * AllCategoricalSplit does.
+ *
+ * @code
+ * DecisionTree<> tree(data, labels, numClasses);
+ * FlatDecisionTree flatTree(tree);
+ * flatTree.Classify(testData, predictions, probabilities);
+ * @endcode
+ */
+class FlatDecisionTree
+{
+ public:
+  //! The number of points that are walked down the tree together.
+  static const size_t GroupSize = 8;
+
+  /**
+   * Create an empty FlatDecisionTree.  It must be built from a trained tree
+   * before it can classify points.
+   */
+  FlatDecisionTree() { /* Nothing to do. */ }
+
+  /**
+   * Build the FlatDecisionTree from the given trained decision tree.
+   *
+   * @param tree Trained decision tree.
+   */
+  template<typename TreeType>
+  explicit FlatDecisionTree(const TreeType& tree) { Build(tree); }
+
+  /**
+   * Build the FlatDecisionTree from the given trained decision tree, replacing
+   * anything it held before.
+   *
+   * @param tree Trained decision tree.
+   */
+  template<typename TreeType>
+  void Build(const TreeType& tree);
+
+  /**
+   * Return the index of the leaf that the given point falls into.
+   *
+   * @param point Point to find the leaf of.
+   */
+  template<typename VecType>
+  size_t Leaf(const VecType& point) const;
+
+  /**
+   * Find the leaf of the points in columns [begin, end) of the given data,
+   * walking the points down the tree in groups of GroupSize.  Only the
+   * elements [begin, end) of leaves are set, and it must be large enough to
+   * hold them.
+   *
+   * @param data Set of points to find the leaves of.
+   * @param begin Index of the first point.
+   * @param end Index one past the last point.
+   * @param leaves Vector to store the leaf indices in.
+   */
+  template<typename MatType>
+  void Leaves(const MatType& data,
+              const size_t begin,
+              const size_t end,
+              arma::Row<size_t>& leaves) const;
+
+  /**
+   * Find the leaf of every point in the given data.  Groups of points are
+   * processed in parallel when OpenMP is available.
+   *
+   * @param data Set of points to find the leaves of.
+   * @param leaves Vector to store the leaf indices in.
+   */
+  template<typename MatType>
+  void Leaves(const MatType& data, arma::Row<size_t>& leaves) const;
+
+  /**
+   * Classify the given point.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const
+  { return leafClasses[Leaf(point)]; }
+
+  /**
+   * Classify the given point and also return the class probabilities.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class of the point.
+   * @param probabilities This will be filled with class probabilities for the
+   *      point.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return the class probabilities of each
+   * point.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for each
+   *      point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of nodes.
+  size_t NumNodes() const { return children.size(); }
+  //! Get the number of leaves.
+  size_t NumLeaves() const { return leafClasses.size(); }
+  //! Get the number of classes.
+  size_t NumClasses() const { return leafProbabilities.n_rows; }
+
+  //! Get the split dimension of each non-leaf node, or the leaf index of each
+  //! leaf.
+  const std::vector<size_t>& Dimensions() const { return dimensions; }
+  //! Get the split threshold of each numeric non-leaf node.
+  const std::vector<double>& Thresholds() const { return thresholds; }
+  //! Get the index of the first child of each node (0 for leaves).
+  const std::vector<size_t>& Children() const { return children; }
+  //! Get whether each node splits on a categorical dimension.
+  const std::vector<unsigned char>& Categorical() const { return categorical; }
+  //! Get the majority class of each leaf.
+  const std::vector<size_t>& LeafClasses() const { return leafClasses; }
+  //! Get the class probabilities of each leaf, one leaf per column.
+  const arma::mat& LeafProbabilities() const { return leafProbabilities; }
+
+  /**
+   * Serialize the tree.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! The split dimension of each non-leaf node, or the leaf index of a leaf.
+  std::vector<size_t> dimensions;
+  //! The split threshold of each numeric non-leaf node.
+  std::vector<double> thresholds;
+  //! The index of the first child of each node, or 0 for a leaf.
+  std::vector<size_t> children;
+  //! Whether each node splits on a categorical dimension.
+  std::vector<unsigned char> categorical;
+  //! The majority class of each leaf.
+  std::vector<size_t> leafClasses;
+  //! The class probabilities of each leaf, one leaf per column.
+  arma::mat leafProbabilities;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_decision_tree_impl.hpp"
+
+#endif
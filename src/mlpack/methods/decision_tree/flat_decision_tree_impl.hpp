@@ -0,0 +1,187 @@
+/**
+ * @file flat_decision_tree_impl.hpp
+ *
+ * Implementation of the FlatDecisionTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+void FlatDecisionTree::Build(const TreeType& tree)
+{
+  static_assert(NumericSplitTraits<typename TreeType::NumericSplit>::
+      UsesThreshold, "FlatDecisionTree: the numeric split type of the tree "
+      "must split on a threshold");
+
+  dimensions.clear();
+  thresholds.clear();
+  children.clear();
+  categorical.clear();
+  leafClasses.clear();
+
+  // Visit the nodes in breadth-first order; the position of a node in the
+  // queue is its index, and the children of a node are queued together.
+  std::vector<const TreeType*> queue(1, &tree);
+  std::vector<const TreeType*> leaves;
+  for (size_t i = 0; i < queue.size(); ++i)
+  {
+    const TreeType& node = *queue[i];
+    if (node.NumChildren() == 0)
+    {
+      dimensions.push_back(leaves.size());
+      thresholds.push_back(0.0);
+      children.push_back(0);
+      categorical.push_back(0);
+      leafClasses.push_back(node.MajorityClass());
+      leaves.push_back(&node);
+      continue;
+    }
+
+    const bool isCategorical =
+        (node.SplitDimensionType() == data::Datatype::categorical);
+    dimensions.push_back(node.SplitDimension());
+    thresholds.push_back(isCategorical ? 0.0 : node.ClassProbabilities()[0]);
+    children.push_back(queue.size());
+    categorical.push_back(isCategorical ? 1 : 0);
+    for (size_t j = 0; j < node.NumChildren(); ++j)
+      queue.push_back(&node.Child(j));
+  }
+
+  leafProbabilities.set_size(leaves[0]->ClassProbabilities().n_elem,
+      leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+    leafProbabilities.col(i) = leaves[i]->ClassProbabilities();
+}
+
+template<typename VecType>
+size_t FlatDecisionTree::Leaf(const VecType& point) const
+{
+  size_t node = 0;
+  while (children[node] != 0)
+  {
+    const double value = point[dimensions[node]];
+    node = children[node] + (categorical[node] ? (size_t) value :
+        (size_t) !(value <= thresholds[node]));
+  }
+
+  return dimensions[node];
+}
+
+template<typename MatType>
+void FlatDecisionTree::Leaves(const MatType& data,
+                              const size_t begin,
+                              const size_t end,
+                              arma::Row<size_t>& leaves) const
+{
+  size_t nodes[GroupSize];
+  for (size_t i = begin; i < end; i += GroupSize)
+  {
+    const size_t count = std::min((size_t) GroupSize, end - i);
+    for (size_t j = 0; j < count; ++j)
+      nodes[j] = 0;
+
+    // Move every point of the group down one level per pass, until all of
+    // them are in a leaf.
+    bool active = (children[0] != 0);
+    while (active)
+    {
+      active = false;
+      for (size_t j = 0; j < count; ++j)
+      {
+        const size_t node = nodes[j];
+        if (children[node] == 0)
+          continue;
+
+        const double value = data(dimensions[node], i + j);
+        nodes[j] = children[node] + (categorical[node] ? (size_t) value :
+            (size_t) !(value <= thresholds[node]));
+        active |= (children[nodes[j]] != 0);
+      }
+    }
+
+    for (size_t j = 0; j < count; ++j)
+      leaves[i + j] = dimensions[nodes[j]];
+  }
+}
+
+template<typename MatType>
+void FlatDecisionTree::Leaves(const MatType& data,
+                              arma::Row<size_t>& leaves) const
+{
+  leaves.set_size(data.n_cols);
+
+  // Each thread takes a block of a few groups at a time.
+  const size_t blockSize = 16 * GroupSize;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+    Leaves(data, begin, end, leaves);
+  }
+}
+
+template<typename VecType>
+void FlatDecisionTree::Classify(const VecType& point,
+                                size_t& prediction,
+                                arma::vec& probabilities) const
+{
+  const size_t leaf = Leaf(point);
+  prediction = leafClasses[leaf];
+  probabilities = leafProbabilities.col(leaf);
+}
+
+template<typename MatType>
+void FlatDecisionTree::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  arma::Row<size_t> leaves;
+  Leaves(data, leaves);
+
+  predictions.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = leafClasses[leaves[i]];
+}
+
+template<typename MatType>
+void FlatDecisionTree::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions,
+                                arma::mat& probabilities) const
+{
+  arma::Row<size_t> leaves;
+  Leaves(data, leaves);
+
+  predictions.set_size(data.n_cols);
+  probabilities = leafProbabilities.cols(arma::conv_to<arma::uvec>::from(
+      leaves));
+  for (size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = leafClasses[leaves[i]];
+}
+
+template<typename Archive>
+void FlatDecisionTree::serialize(Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(dimensions);
+  ar & BOOST_SERIALIZATION_NVP(thresholds);
+  ar & BOOST_SERIALIZATION_NVP(children);
+  ar & BOOST_SERIALIZATION_NVP(categorical);
+  ar & BOOST_SERIALIZATION_NVP(leafClasses);
+  ar & BOOST_SERIALIZATION_NVP(leafProbabilities);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
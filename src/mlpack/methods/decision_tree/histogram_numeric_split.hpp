@@ -0,0 +1,176 @@
+/**
+ * @file histogram_numeric_split.hpp
+ *
+ * A tree splitter that finds the best binary numeric split between histogram
+ * bins.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "numeric_split_traits.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HistogramNumericSplit is a splitting function for decision trees that
+ * searches a numeric dimension for the best binary split, like the
+ * BestBinaryNumericSplit, but only considers splits between histogram bins.
+ * Every dimension is quantized once into at most 256 bins before the tree is
+ * trained, so at each node the split is found with one pass over the bins of
+ * the points to build the class histogram and one pass over the histogram,
+ * without sorting.
+ *
+ * If there are at most 256 distinct values in a dimension, every value gets
+ * its own bin and the split found is the same as the BestBinaryNumericSplit
+ * would find.  Otherwise the bin boundaries are put at quantiles of the data.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  template<typename ElemType>
+  class AuxiliarySplitInfo { };
+
+  //! The largest number of bins a dimension is quantized into.
+  static const size_t MaxBins = 256;
+
+  /**
+   * Quantize every dimension of the given data into at most MaxBins bins.  The
+   * bins are ordered like the values they hold.
+   *
+   * @param data Dataset to quantize.
+   * @param bins Matrix to store the bin of every point in, with one row per
+   *      point and one column per dimension.
+   */
+  template<typename MatType>
+  static void Bin(const MatType& data, arma::Mat<unsigned char>& bins);
+
+  /**
+   * Quantize every dimension of the given data into at most MaxBins bins, and
+   * return the boundaries of the bins: a value x is in bin b of dimension d if
+   * boundaries[d][b - 1] <= x < boundaries[d][b].
+   *
+   * @param data Dataset to quantize.
+   * @param bins Matrix to store the bin of every point in, with one row per
+   *      point and one column per dimension.
+   * @param boundaries Vector to store the smallest value of every bin but the
+   *      first in, for each dimension.
+   */
+  template<typename MatType>
+  static void Bin(
+      const MatType& data,
+      arma::Mat<unsigned char>& bins,
+      std::vector<arma::Col<typename MatType::elem_type>>& boundaries);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then classProbabilities
+   * and aux may be modified.  This quantizes the data of the node before
+   * searching it; the decision tree uses the overload below instead.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::Col<typename VecType::elem_type>& classProbabilities,
+      AuxiliarySplitInfo<typename VecType::elem_type>& aux);
+
+  /**
+   * Check if we can split a node, given the bins of its points, as computed by
+   * Bin().
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param bins The bin of each point in the dimension.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Col<unsigned char>& bins,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::Col<typename VecType::elem_type>& classProbabilities,
+      AuxiliarySplitInfo<typename VecType::elem_type>& aux);
+
+  /**
+   * Returns 2, since the binary split always has two children.
+   */
+  template<typename ElemType>
+  static size_t NumChildren(const arma::Col<ElemType>& /* classProbabilities */,
+                            const AuxiliarySplitInfo<ElemType>& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Given a point, calculate which child it should go to (left or right).
+   *
+   * @param point Point to calculate direction of.
+   * @param classProbabilities Auxiliary information for the split.
+   * @param aux (Unused) auxiliary information for the split.
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::Col<ElemType>& classProbabilities,
+      const AuxiliarySplitInfo<ElemType>& /* aux */);
+};
+
+//! The histogram numeric split works with binned data.
+template<typename FitnessFunction>
+class NumericSplitTraits<HistogramNumericSplit<FitnessFunction>>
+{
+ public:
+  static const bool UsesSortedIndices = false;
+  static const bool UsesBinnedData = true;
+  static const bool UsesThreshold = true;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_numeric_split_impl.hpp"
+
+#endif
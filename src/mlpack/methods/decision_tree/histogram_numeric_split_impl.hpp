@@ -0,0 +1,284 @@
+/**
+ * @file histogram_numeric_split_impl.hpp
+ *
+ * Implementation of the histogram numeric splitter.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<typename MatType>
+void HistogramNumericSplit<FitnessFunction>::Bin(
+    const MatType& data,
+    arma::Mat<unsigned char>& bins)
+{
+  std::vector<arma::Col<typename MatType::elem_type>> boundaries;
+  Bin(data, bins, boundaries);
+}
+
+template<typename FitnessFunction>
+template<typename MatType>
+void HistogramNumericSplit<FitnessFunction>::Bin(
+    const MatType& data,
+    arma::Mat<unsigned char>& bins,
+    std::vector<arma::Col<typename MatType::elem_type>>& boundaries)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  bins.set_size(data.n_cols, data.n_rows);
+  boundaries.resize(data.n_rows);
+
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    const arma::Col<ElemType> sorted = arma::sort(arma::vectorise(
+        data.row(d)));
+    const arma::Col<ElemType> distinct = arma::unique(sorted);
+
+    // Find the smallest value of every bin but the first.  If there are few
+    // enough distinct values, each of them gets its own bin; otherwise the
+    // boundaries are quantiles.
+    std::vector<ElemType> dimBoundaries;
+    if (distinct.n_elem <= MaxBins)
+    {
+      dimBoundaries.assign(distinct.begin() + 1, distinct.end());
+    }
+    else
+    {
+      for (size_t b = 1; b < MaxBins; ++b)
+      {
+        const ElemType boundary = sorted[b * sorted.n_elem / MaxBins];
+        if (boundary > sorted[0] &&
+            (dimBoundaries.empty() || boundary > dimBoundaries.back()))
+          dimBoundaries.push_back(boundary);
+      }
+    }
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      bins(i, d) = (unsigned char) (std::upper_bound(dimBoundaries.begin(),
+          dimBoundaries.end(), data(d, i)) - dimBoundaries.begin());
+    }
+
+    boundaries[d] = arma::conv_to<arma::Col<ElemType>>::from(dimBoundaries);
+  }
+}
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& aux)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the data of this node.
+  const arma::Row<typename VecType::elem_type> row =
+      arma::vectorise(data).t();
+  arma::Mat<unsigned char> bins;
+  Bin(row, bins);
+
+  return SplitIfBetter<UseWeights>(bestGain, data,
+      arma::Col<unsigned char>(bins.colptr(0), bins.n_rows, false, true),
+      labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+      classProbabilities, aux);
+}
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Col<unsigned char>& bins,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Build the histogram of the node: the number of points in each bin, and the
+  // number of points (or their weight) of each class in each bin.
+  arma::Col<size_t> binCounts(MaxBins, arma::fill::zeros);
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, MaxBins);
+    for (size_t i = 0; i < bins.n_elem; ++i)
+    {
+      ++binCounts[bins[i]];
+      classWeightSums(labels[i], bins[i]) += weights[i];
+    }
+  }
+  else
+  {
+    classCounts.zeros(numClasses, MaxBins);
+    for (size_t i = 0; i < bins.n_elem; ++i)
+    {
+      ++binCounts[bins[i]];
+      ++classCounts(labels[i], bins[i]);
+    }
+  }
+
+  // Loop through all boundaries between bins, choosing the best one.  Also,
+  // force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  size_t bestBin = 0;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  const size_t count = bins.n_elem;
+
+  arma::Col<size_t> leftCounts, rightCounts, totalCounts;
+  arma::vec leftWeights, rightWeights, totalWeights;
+  double totalWeight = 0.0;
+  if (UseWeights)
+  {
+    leftWeights.zeros(numClasses);
+    totalWeights = arma::sum(classWeightSums, 1);
+    totalWeight = arma::accu(totalWeights);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    totalCounts = arma::sum(classCounts, 1);
+    bestFoundGain *= count;
+  }
+
+  size_t leftCount = 0;
+  for (size_t bin = 0; bin < MaxBins - 1; ++bin)
+  {
+    // An empty bin gives the same split as the bin before it.
+    if (binCounts[bin] == 0)
+      continue;
+
+    leftCount += binCounts[bin];
+    if (UseWeights)
+      leftWeights += classWeightSums.col(bin);
+    else
+      leftCounts += classCounts.col(bin);
+
+    // Make sure that both children are large enough.
+    if (count - leftCount < minimum)
+      break;
+    if (leftCount < minimum)
+      continue;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    double gain;
+    if (UseWeights)
+    {
+      rightWeights = totalWeights - leftWeights;
+      const double totalLeftWeight = arma::accu(leftWeights);
+      const double totalRightWeight = totalWeight - totalLeftWeight;
+      const double leftGain = FitnessFunction::template EvaluatePtr<true>(
+          leftWeights.memptr(), numClasses, totalLeftWeight);
+      const double rightGain = FitnessFunction::template EvaluatePtr<true>(
+          rightWeights.memptr(), numClasses, totalRightWeight);
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      rightCounts = totalCounts - leftCounts;
+      const double leftGain = FitnessFunction::template EvaluatePtr<false>(
+          leftCounts.memptr(), numClasses, leftCount);
+      const double rightGain = FitnessFunction::template EvaluatePtr<false>(
+          rightCounts.memptr(), numClasses, count - leftCount);
+      gain = double(leftCount) * leftGain +
+          double(count - leftCount) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      bestFoundGain = gain;
+      bestBin = bin;
+      improved = true;
+      break;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      bestBin = bin;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  // The actual split value will be halfway between the largest value in the
+  // left bins and the smallest value in the right bins.
+  ElemType leftMax = std::numeric_limits<ElemType>::lowest();
+  ElemType rightMin = std::numeric_limits<ElemType>::max();
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (bins[i] <= bestBin)
+      leftMax = std::max(leftMax, (ElemType) data[i]);
+    else
+      rightMin = std::min(rightMin, (ElemType) data[i]);
+  }
+
+  classProbabilities.set_size(1);
+  classProbabilities[0] = (leftMax + rightMin) / 2.0;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= count;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
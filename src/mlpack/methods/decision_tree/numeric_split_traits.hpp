@@ -0,0 +1,59 @@
+/**
+ * @file numeric_split_traits.hpp
+ *
+ * Traits for the numeric split types of the decision tree, which tell the tree
+ * what kind of input a split type can work with.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_NUMERIC_SPLIT_TRAITS_HPP
+#define MLPACK_METHODS_DECISION_TREE_NUMERIC_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The NumericSplitTraits class provides compile-time information on a numeric
+ * split type.  The defaults below are safe for any split type; a split type
+ * that can do better should specialize this class.
+ *
+ * @tparam SplitType The numeric split type.
+ */
+template<typename SplitType>
+class NumericSplitTraits
+{
+ public:
+  /**
+   * Whether the split type has a SplitIfBetter() overload that takes the
+   * indices that sort the data of the node, right after the data.  If so,
+   * the decision tree sorts every dimension once before training and keeps the
+   * sorted indices up to date while it splits, instead of letting the split
+   * type sort the data at every node.
+   */
+  static const bool UsesSortedIndices = false;
+
+  /**
+   * Whether the split type quantizes the data into bins, and has a static
+   * Bin() method that computes the bin of every point in every dimension and a
+   * SplitIfBetter() overload that takes the bins of the node, right after the
+   * data.  If so, the decision tree bins the data once before training and
+   * keeps the bins next to the points while it splits.
+   */
+  static const bool UsesBinnedData = false;
+
+  /**
+   * Whether the split type always splits a node into two children, sending a
+   * point to the first child if its value is at most classProbabilities[0] and
+   * to the second child otherwise.  Trees with such numeric splits can be
+   * compiled into a FlatDecisionTree.
+   */
+  static const bool UsesThreshold = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
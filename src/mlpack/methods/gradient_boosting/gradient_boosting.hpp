@@ -0,0 +1,270 @@
+/**
+ * @file gradient_boosting.hpp
+ *
+ * Definition of the GradientBoosting class, which implements gradient boosted
+ * regression trees for regression and classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/decision_tree/histogram_numeric_split.hpp>
+#include <mlpack/methods/decision_tree/gini_gain.hpp>
+#include "gradient_boosting_tree.hpp"
+#include "squared_error_loss.hpp"
+#include "softmax_cross_entropy_loss.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Gradient boosting builds an additive model of regression trees.  Every
+ * iteration fits one tree per score of the model to the gradients of the loss
+ * (with second-order steps, as in XGBoost), and adds it to the model scaled by
+ * the learning rate.  The data is quantized into at most 256 bins per
+ * dimension once before training, and the trees are grown on the bins with
+ * histograms (see GradientBoostingTree).
+ *
+ * Each iteration may use a random subsample of the training points.  If a
+ * validation set is given, training stops once the loss on the validation set
+ * has not improved for a number of iterations, and the model is cut back to
+ * the iteration with the lowest validation loss.
+ *
+ * For regression, use the SquaredErrorLoss and Predict(); for classification,
+ * use the SoftmaxCrossEntropyLoss and Classify().
+ *
+ * A loss must implement the following methods:
+ *
+ * @code
+ * // Compute the initial scores of the model, one per output.
+ * void Initialize(const ResponsesType& responses, arma::vec& initialScores);
+ *
+ * // Compute the gradients and hessians of the loss for every score.
+ * void Gradients(const ResponsesType& responses,
+ *                const arma::mat& scores,
+ *                arma::mat& gradients,
+ *                arma::mat& hessians) const;
+ *
+ * // Return the mean loss of the given scores.
+ * double Evaluate(const ResponsesType& responses,
+ *                 const arma::mat& scores) const;
+ * @endcode
+ *
+ * and a loss used for classification must also implement
+ *
+ * @code
+ * // Compute the class probabilities from the scores.
+ * void Probabilities(const arma::mat& scores,
+ *                    arma::mat& probabilities) const;
+ * @endcode
+ *
+ * @tparam LossType The loss to minimize.
+ */
+template<typename LossType = SquaredErrorLoss>
+class GradientBoosting
+{
+ public:
+  /**
+   * Create the model without training it.
+   *
+   * @param numIterations Maximum number of boosting iterations.
+   * @param learningRate Factor to scale every tree with (shrinkage).
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param lambda L2 regularization of the leaf values.
+   * @param subsampleRatio Fraction of the training points to use for each
+   *      iteration.
+   * @param patience Number of iterations without improvement on the
+   *      validation set before training stops.
+   * @param loss Instantiated loss.
+   */
+  GradientBoosting(const size_t numIterations = 100,
+                   const double learningRate = 0.1,
+                   const size_t maximumDepth = 6,
+                   const size_t minimumLeafSize = 20,
+                   const double lambda = 1.0,
+                   const double subsampleRatio = 1.0,
+                   const size_t patience = 10,
+                   const LossType& loss = LossType());
+
+  /**
+   * Train the model on the given data and responses.  This overwrites any
+   * previous model.
+   *
+   * @param data Dataset to train on, one point per column.
+   * @param responses Responses (or labels) for each training point.
+   * @return The mean loss on the training set.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data, const ResponsesType& responses);
+
+  /**
+   * Train the model on the given data and responses, stopping early when the
+   * loss on the given validation set stops improving.  This overwrites any
+   * previous model.  The validation set must not be empty, and training fails
+   * if the validation loss is not finite.
+   *
+   * @param data Dataset to train on, one point per column.
+   * @param responses Responses (or labels) for each training point.
+   * @param validationData Validation dataset.
+   * @param validationResponses Responses (or labels) for each validation
+   *      point.
+   * @return The lowest mean loss on the validation set.
+   */
+  template<typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const MatType& validationData,
+               const ResponsesType& validationResponses);
+
+  /**
+   * Compute the scores of the model for every point in the given dataset.
+   * Blocks of points are walked through every tree, in parallel over the
+   * blocks.
+   *
+   * @param data Dataset to compute scores for.
+   * @param scores Matrix to store the scores in, one column per point.
+   */
+  template<typename MatType>
+  void Scores(const MatType& data, arma::mat& scores) const;
+
+  /**
+   * Predict the response of every point in the given dataset.  This is meant
+   * for regression losses, which have one score per point.
+   *
+   * @param data Dataset to predict for.
+   * @param predictions Vector to store the predicted responses in.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  /**
+   * Predict the class of every point in the given dataset.  This is meant for
+   * classification losses.
+   *
+   * @param data Dataset to classify.
+   * @param predictions Vector to store the predicted classes in.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the class of every point in the given dataset, and the class
+   * probabilities.  This is meant for classification losses.
+   *
+   * @param data Dataset to classify.
+   * @param predictions Vector to store the predicted classes in.
+   * @param probabilities Matrix to store the class probabilities in.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the maximum number of iterations.
+  size_t NumIterations() const { return numIterations; }
+  //! Modify the maximum number of iterations.
+  size_t& NumIterations() { return numIterations; }
+
+  //! Get the learning rate.
+  double LearningRate() const { return learningRate; }
+  //! Modify the learning rate.
+  double& LearningRate() { return learningRate; }
+
+  //! Get the maximum depth of each tree.
+  size_t MaximumDepth() const { return maximumDepth; }
+  //! Modify the maximum depth of each tree.
+  size_t& MaximumDepth() { return maximumDepth; }
+
+  //! Get the minimum number of points in each leaf.
+  size_t MinimumLeafSize() const { return minimumLeafSize; }
+  //! Modify the minimum number of points in each leaf.
+  size_t& MinimumLeafSize() { return minimumLeafSize; }
+
+  //! Get the L2 regularization of the leaf values.
+  double Lambda() const { return lambda; }
+  //! Modify the L2 regularization of the leaf values.
+  double& Lambda() { return lambda; }
+
+  //! Get the fraction of the training points used by each iteration.
+  double SubsampleRatio() const { return subsampleRatio; }
+  //! Modify the fraction of the training points used by each iteration.
+  double& SubsampleRatio() { return subsampleRatio; }
+
+  //! Get the number of iterations without improvement before stopping.
+  size_t Patience() const { return patience; }
+  //! Modify the number of iterations without improvement before stopping.
+  size_t& Patience() { return patience; }
+
+  //! Get the loss.
+  const LossType& Loss() const { return loss; }
+  //! Modify the loss.
+  LossType& Loss() { return loss; }
+
+  //! Get the number of scores of the model for each point.
+  size_t NumOutputs() const { return initialScores.n_elem; }
+
+  //! Get the number of trees in the model.
+  size_t NumTrees() const { return trees.size(); }
+  //! Get a tree of the model.  Tree i adds to score i % NumOutputs().
+  const GradientBoostingTree& Tree(const size_t i) const { return trees[i]; }
+
+  /**
+   * Serialize the model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  /**
+   * Train the model, with or without a validation set.
+   */
+  template<bool UseValidation, typename MatType, typename ResponsesType>
+  double Train(const MatType& data,
+               const ResponsesType& responses,
+               const MatType& validationData,
+               const ResponsesType& validationResponses);
+
+  /**
+   * Add the scores of the given tree to the given row of scores.
+   */
+  template<typename MatType>
+  static void AddScores(const GradientBoostingTree& tree,
+                        const MatType& data,
+                        const size_t output,
+                        arma::mat& scores);
+
+  //! The maximum number of iterations.
+  size_t numIterations;
+  //! The learning rate.
+  double learningRate;
+  //! The maximum depth of each tree.
+  size_t maximumDepth;
+  //! The minimum number of points in each leaf.
+  size_t minimumLeafSize;
+  //! The L2 regularization of the leaf values.
+  double lambda;
+  //! The fraction of the training points used by each iteration.
+  double subsampleRatio;
+  //! The number of iterations without improvement before stopping.
+  size_t patience;
+  //! The loss.
+  LossType loss;
+  //! The scores of the model before any tree.
+  arma::vec initialScores;
+  //! The trees, NumOutputs() per iteration.
+  std::vector<GradientBoostingTree> trees;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "gradient_boosting_impl.hpp"
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * @file gradient_boosting_impl.hpp
+ *
+ * Implementation of the GradientBoosting class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gradient_boosting.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename LossType>
+GradientBoosting<LossType>::GradientBoosting(const size_t numIterations,
+                                             const double learningRate,
+                                             const size_t maximumDepth,
+                                             const size_t minimumLeafSize,
+                                             const double lambda,
+                                             const double subsampleRatio,
+                                             const size_t patience,
+                                             const LossType& loss) :
+    numIterations(numIterations),
+    learningRate(learningRate),
+    maximumDepth(maximumDepth),
+    minimumLeafSize(minimumLeafSize),
+    lambda(lambda),
+    subsampleRatio(subsampleRatio),
+    patience(patience),
+    loss(loss)
+{
+  // Nothing to do.
+}
+
+template<typename LossType>
+template<typename MatType, typename ResponsesType>
+double GradientBoosting<LossType>::Train(const MatType& data,
+                                         const ResponsesType& responses)
+{
+  return Train<false>(data, responses, data, responses);
+}
+
+template<typename LossType>
+template<typename MatType, typename ResponsesType>
+double GradientBoosting<LossType>::Train(
+    const MatType& data,
+    const ResponsesType& responses,
+    const MatType& validationData,
+    const ResponsesType& validationResponses)
+{
+  return Train<true>(data, responses, validationData, validationResponses);
+}
+
+template<typename LossType>
+template<typename MatType>
+void GradientBoosting<LossType>::Scores(const MatType& data,
+                                        arma::mat& scores) const
+{
+  scores = arma::repmat(initialScores, 1, data.n_cols);
+
+  // Walk blocks of points through all the trees, so that both the points of
+  // a block and the tree being walked stay in cache.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  const size_t numOutputs = initialScores.n_elem;
+
+  #pragma omp parallel for
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      const size_t output = t % numOutputs;
+      for (size_t i = begin; i < end; ++i)
+        scores(output, i) += trees[t].Predict(data.col(i));
+    }
+  }
+}
+
+template<typename LossType>
+template<typename MatType>
+void GradientBoosting<LossType>::Predict(const MatType& data,
+                                         arma::rowvec& predictions) const
+{
+  arma::mat scores;
+  Scores(data, scores);
+  predictions = scores.row(0);
+}
+
+template<typename LossType>
+template<typename MatType>
+void GradientBoosting<LossType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename LossType>
+template<typename MatType>
+void GradientBoosting<LossType>::Classify(const MatType& data,
+                                          arma::Row<size_t>& predictions,
+                                          arma::mat& probabilities) const
+{
+  arma::mat scores;
+  Scores(data, scores);
+  loss.Probabilities(scores, probabilities);
+
+  predictions.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = probabilities.col(i).index_max();
+}
+
+template<typename LossType>
+template<typename Archive>
+void GradientBoosting<LossType>::serialize(Archive& ar,
+                                           const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(numIterations);
+  ar & BOOST_SERIALIZATION_NVP(learningRate);
+  ar & BOOST_SERIALIZATION_NVP(maximumDepth);
+  ar & BOOST_SERIALIZATION_NVP(minimumLeafSize);
+  ar & BOOST_SERIALIZATION_NVP(lambda);
+  ar & BOOST_SERIALIZATION_NVP(subsampleRatio);
+  ar & BOOST_SERIALIZATION_NVP(patience);
+  ar & BOOST_SERIALIZATION_NVP(loss);
+  ar & BOOST_SERIALIZATION_NVP(initialScores);
+  ar & BOOST_SERIALIZATION_NVP(trees);
+}
+
+template<typename LossType>
+template<bool UseValidation, typename MatType, typename ResponsesType>
+double GradientBoosting<LossType>::Train(
+    const MatType& data,
+    const ResponsesType& responses,
+    const MatType& validationData,
+    const ResponsesType& validationResponses)
+{
+  if (data.n_cols != responses.n_elem)
+  {
+    Log::Fatal << "GradientBoosting::Train(): number of points ("
+        << data.n_cols << ") does not match number of responses ("
+        << responses.n_elem << ")!" << std::endl;
+  }
+
+  if (UseValidation && validationData.n_cols == 0)
+  {
+    Log::Fatal << "GradientBoosting::Train(): the validation set must not be "
+        << "empty!" << std::endl;
+  }
+
+  if (UseValidation && validationData.n_cols != validationResponses.n_elem)
+  {
+    Log::Fatal << "GradientBoosting::Train(): number of validation points ("
+        << validationData.n_cols << ") does not match number of validation "
+        << "responses (" << validationResponses.n_elem << ")!" << std::endl;
+  }
+
+  if (subsampleRatio <= 0.0 || subsampleRatio > 1.0)
+  {
+    Log::Fatal << "GradientBoosting::Train(): subsample ratio must be in "
+        << "(0, 1]!" << std::endl;
+  }
+
+  trees.clear();
+
+  // Quantize the data once; every tree is grown on the bins.
+  arma::Mat<unsigned char> bins;
+  std::vector<arma::Col<typename MatType::elem_type>> boundaries;
+  HistogramNumericSplit<GiniGain>::Bin(data, bins, boundaries);
+
+  loss.Initialize(responses, initialScores);
+  const size_t numOutputs = initialScores.n_elem;
+
+  arma::mat scores = arma::repmat(initialScores, 1, data.n_cols);
+  arma::mat validationScores;
+  if (UseValidation)
+    validationScores = arma::repmat(initialScores, 1, validationData.n_cols);
+
+  const size_t sampleSize = std::max((size_t) 1,
+      (size_t) std::round(subsampleRatio * data.n_cols));
+  arma::uvec points = arma::regspace<arma::uvec>(0, data.n_cols - 1);
+
+  arma::mat gradients, hessians;
+  double bestLoss = DBL_MAX;
+  size_t bestIterations = 0;
+  for (size_t i = 0; i < numIterations; ++i)
+  {
+    loss.Gradients(responses, scores, gradients, hessians);
+
+    // Take a random subsample of the points, if needed.
+    if (sampleSize < data.n_cols)
+    {
+      points = arma::shuffle(arma::regspace<arma::uvec>(0, data.n_cols - 1));
+      points.resize(sampleSize);
+    }
+
+    for (size_t k = 0; k < numOutputs; ++k)
+    {
+      trees.push_back(GradientBoostingTree());
+      trees.back().Train(bins, boundaries, arma::rowvec(gradients.row(k)),
+          arma::rowvec(hessians.row(k)), points, maximumDepth,
+          minimumLeafSize, lambda, learningRate);
+
+      AddScores(trees.back(), data, k, scores);
+      if (UseValidation)
+        AddScores(trees.back(), validationData, k, validationScores);
+    }
+
+    if (UseValidation)
+    {
+      const double validationLoss = loss.Evaluate(validationResponses,
+          validationScores);
+      Log::Debug << "GradientBoosting::Train(): iteration " << i + 1
+          << ", validation loss " << validationLoss << "." << std::endl;
+
+      if (!std::isfinite(validationLoss))
+      {
+        Log::Fatal << "GradientBoosting::Train(): validation loss is not "
+            << "finite in iteration " << i + 1 << "!" << std::endl;
+      }
+
+      if (validationLoss < bestLoss)
+      {
+        bestLoss = validationLoss;
+        bestIterations = i + 1;
+      }
+      else if (i + 1 - bestIterations >= patience)
+      {
+        Log::Info << "GradientBoosting::Train(): validation loss has not "
+            << "improved for " << patience << " iterations; stopping after "
+            << "iteration " << bestIterations << "." << std::endl;
+        break;
+      }
+    }
+  }
+
+  if (!UseValidation)
+    return loss.Evaluate(responses, scores);
+
+  // Cut the model back to the best iteration.
+  trees.resize(bestIterations * numOutputs);
+  return bestLoss;
+}
+
+template<typename LossType>
+template<typename MatType>
+void GradientBoosting<LossType>::AddScores(const GradientBoostingTree& tree,
+                                           const MatType& data,
+                                           const size_t output,
+                                           arma::mat& scores)
+{
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    scores(output, i) += tree.Predict(data.col(i));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
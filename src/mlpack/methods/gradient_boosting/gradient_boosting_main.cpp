@@ -0,0 +1,335 @@
+/**
+ * @file gradient_boosting_main.cpp
+ *
+ * A program to build and evaluate gradient boosted trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/gradient_boosting/gradient_boosting.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+using namespace mlpack;
+using namespace mlpack::tree;
+using namespace mlpack::util;
+using namespace std;
+
+PROGRAM_INFO("Gradient boosted trees",
+    // Short description.
+    "An implementation of gradient boosted regression trees for regression and "
+    "classification.  Given a labeled dataset or a dataset with responses, a "
+    "model can be trained and saved for future use; or, a pre-trained model "
+    "can be used for prediction.",
+    // Long description.
+    "This program implements gradient boosting of regression trees, with "
+    "second-order steps and histogram-based tree growth.  A model can be "
+    "trained and saved for later use, or a model may be loaded and predictions "
+    "for points may be generated."
+    "\n\n"
+    "The training set is specified with the " +
+    PRINT_PARAM_STRING("training") + " parameter.  For classification, the "
+    "labels of the training points are given with the " +
+    PRINT_PARAM_STRING("labels") + " parameter, and should be in the range [0, "
+    "num_classes - 1].  For regression, the responses of the training points "
+    "are given with the " + PRINT_PARAM_STRING("responses") + " parameter "
+    "instead."
+    "\n\n"
+    "The " + PRINT_PARAM_STRING("num_iterations") + " parameter controls the "
+    "maximum number of boosting iterations; for classification, each iteration "
+    "adds one tree per class.  Each tree is scaled by the " +
+    PRINT_PARAM_STRING("learning_rate") + ".  The " +
+    PRINT_PARAM_STRING("maximum_depth") + " and " +
+    PRINT_PARAM_STRING("minimum_leaf_size") + " parameters limit the size of "
+    "each tree, and the " + PRINT_PARAM_STRING("lambda") + " parameter "
+    "regularizes the values of the leaves.  If " +
+    PRINT_PARAM_STRING("subsample_ratio") + " is less than 1, each iteration "
+    "uses a random subsample of that fraction of the training points."
+    "\n\n"
+    "If a validation set is given with the " +
+    PRINT_PARAM_STRING("validation") + " parameter (and its labels or "
+    "responses with " + PRINT_PARAM_STRING("validation_labels") + " or " +
+    PRINT_PARAM_STRING("validation_responses") + "), training stops once the "
+    "loss on the validation set has not improved for " +
+    PRINT_PARAM_STRING("patience") + " iterations, and the model is cut back "
+    "to the best iteration."
+    "\n\n"
+    "When a model is trained, the " + PRINT_PARAM_STRING("output_model") + " "
+    "output parameter may be used to save the trained model.  A model may be "
+    "loaded for predictions with the " + PRINT_PARAM_STRING("input_model") +
+    " parameter.  Test data may be specified with the " +
+    PRINT_PARAM_STRING("test") + " parameter.  For a classification model, "
+    "the predicted classes and class probabilities are saved with the " +
+    PRINT_PARAM_STRING("predictions") + " and " +
+    PRINT_PARAM_STRING("probabilities") + " output parameters, and if " +
+    PRINT_PARAM_STRING("test_labels") + " is given the accuracy is printed.  "
+    "For a regression model, the predicted responses are saved with the " +
+    PRINT_PARAM_STRING("predicted_responses") + " output parameter."
+    "\n\n"
+    "For example, to train a classification model with 50 iterations on the "
+    "dataset contained in " + PRINT_DATASET("data") + " with labels " +
+    PRINT_DATASET("labels") + ", saving the model to " +
+    PRINT_MODEL("gb_model") + ", one could call"
+    "\n\n" +
+    PRINT_CALL("gradient_boosting", "training", "data", "labels", "labels",
+        "num_iterations", 50, "output_model", "gb_model") +
+    "\n\n"
+    "Then, to use that model to classify points in " +
+    PRINT_DATASET("test_set") + ", saving the predictions to " +
+    PRINT_DATASET("predictions") + ", one could call "
+    "\n\n" +
+    PRINT_CALL("gradient_boosting", "input_model", "gb_model", "test",
+        "test_set", "predictions", "predictions"),
+    SEE_ALSO("@random_forest", "#random_forest"),
+    SEE_ALSO("@decision_tree", "#decision_tree"),
+    SEE_ALSO("Gradient boosting on Wikipedia",
+        "https://en.wikipedia.org/wiki/Gradient_boosting"),
+    SEE_ALSO("XGBoost: A Scalable Tree Boosting System (pdf)",
+        "https://arxiv.org/pdf/1603.02754.pdf"),
+    SEE_ALSO("mlpack::tree::GradientBoosting C++ class documentation",
+        "@doxygen/classmlpack_1_1tree_1_1GradientBoosting.html"));
+
+PARAM_MATRIX_IN("training", "Training dataset.", "t");
+PARAM_UROW_IN("labels", "Labels for the training dataset, for "
+    "classification.", "l");
+PARAM_ROW_IN("responses", "Responses for the training dataset, for "
+    "regression.", "r");
+PARAM_MATRIX_IN("validation", "Validation dataset for early stopping.", "v");
+PARAM_UROW_IN("validation_labels", "Labels for the validation dataset.", "V");
+PARAM_ROW_IN("validation_responses", "Responses for the validation dataset.",
+    "R");
+PARAM_MATRIX_IN("test", "Test dataset to produce predictions for.", "T");
+PARAM_UROW_IN("test_labels", "Test dataset labels, if accuracy calculation is "
+    "desired.", "L");
+
+PARAM_INT_IN("num_iterations", "Maximum number of boosting iterations.", "N",
+    100);
+PARAM_DOUBLE_IN("learning_rate", "Learning rate (shrinkage) of each tree.",
+    "e", 0.1);
+PARAM_INT_IN("maximum_depth", "Maximum depth of each tree (0 means no limit).",
+    "D", 6);
+PARAM_INT_IN("minimum_leaf_size", "Minimum number of points in each leaf "
+    "node.", "n", 20);
+PARAM_DOUBLE_IN("lambda", "L2 regularization of the leaf values.", "A", 1.0);
+PARAM_DOUBLE_IN("subsample_ratio", "Fraction of the training points used by "
+    "each iteration.", "S", 1.0);
+PARAM_INT_IN("patience", "Number of iterations without improvement on the "
+    "validation set before training stops.", "p", 10);
+
+PARAM_UROW_OUT("predictions", "Predicted classes for each point in the test "
+    "set.", "P");
+PARAM_MATRIX_OUT("probabilities", "Predicted class probabilities for each "
+    "point in the test set.", "B");
+PARAM_ROW_OUT("predicted_responses", "Predicted responses for each point in "
+    "the test set.", "o");
+
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
+
+/**
+ * This is the class that we will serialize.  It holds either a classification
+ * or a regression model.
+ */
+class GradientBoostingModel
+{
+ public:
+  //! Whether the model is a regression model.
+  bool regression;
+  //! The classification model.
+  GradientBoosting<SoftmaxCrossEntropyLoss> classifier;
+  //! The regression model.
+  GradientBoosting<SquaredErrorLoss> regressor;
+
+  // Create the model.
+  GradientBoostingModel() : regression(false) { /* Nothing to do. */ }
+
+  // Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(regression);
+    if (regression)
+      ar & BOOST_SERIALIZATION_NVP(regressor);
+    else
+      ar & BOOST_SERIALIZATION_NVP(classifier);
+  }
+};
+
+PARAM_MODEL_IN(GradientBoostingModel, "input_model", "Pre-trained gradient "
+    "boosting model to use for prediction.", "m");
+PARAM_MODEL_OUT(GradientBoostingModel, "output_model", "Model to save trained "
+    "gradient boosting model to.", "M");
+
+// Set the hyperparameters of the given model from the parameters.
+template<typename ModelType>
+void SetParameters(ModelType& model)
+{
+  model.NumIterations() = (size_t) CLI::GetParam<int>("num_iterations");
+  model.LearningRate() = CLI::GetParam<double>("learning_rate");
+  model.MaximumDepth() = (size_t) CLI::GetParam<int>("maximum_depth");
+  model.MinimumLeafSize() = (size_t) CLI::GetParam<int>("minimum_leaf_size");
+  model.Lambda() = CLI::GetParam<double>("lambda");
+  model.SubsampleRatio() = CLI::GetParam<double>("subsample_ratio");
+  model.Patience() = (size_t) CLI::GetParam<int>("patience");
+}
+
+static void mlpackMain()
+{
+  // Initialize random seed if needed.
+  if (CLI::GetParam<int>("seed") != 0)
+    math::RandomSeed((size_t) CLI::GetParam<int>("seed"));
+  else
+    math::RandomSeed((size_t) std::time(NULL));
+
+  // Check for incompatible input parameters.
+  RequireOnlyOnePassed({ "training", "input_model" }, true);
+
+  RequireAtLeastOnePassed({ "test", "output_model" }, false,
+      "the trained model will not be used or saved");
+
+  if (CLI::HasParam("training"))
+  {
+    RequireOnlyOnePassed({ "labels", "responses" }, true, "must pass either "
+        "labels or responses when training set given");
+  }
+
+  ReportIgnoredParam({{ "training", false }}, "validation");
+  ReportIgnoredParam({{ "validation", false }}, "validation_labels");
+  ReportIgnoredParam({{ "validation", false }}, "validation_responses");
+  ReportIgnoredParam({{ "test", false }}, "test_labels");
+  ReportIgnoredParam({{ "test", false }}, "predictions");
+  ReportIgnoredParam({{ "test", false }}, "probabilities");
+  ReportIgnoredParam({{ "test", false }}, "predicted_responses");
+
+  RequireParamValue<int>("num_iterations", [](int x) { return x > 0; }, true,
+      "number of iterations must be positive");
+  RequireParamValue<double>("learning_rate", [](double x) { return x > 0.0; },
+      true, "learning rate must be positive");
+  RequireParamValue<int>("maximum_depth", [](int x) { return x >= 0; }, true,
+      "maximum depth must not be negative");
+  RequireParamValue<int>("minimum_leaf_size", [](int x) { return x > 0; }, true,
+      "minimum leaf size must be greater than 0");
+  RequireParamValue<double>("lambda", [](double x) { return x >= 0.0; }, true,
+      "lambda must be nonnegative");
+  RequireParamValue<double>("subsample_ratio",
+      [](double x) { return x > 0.0 && x <= 1.0; }, true,
+      "subsample ratio must be in (0, 1]");
+  RequireParamValue<int>("patience", [](int x) { return x > 0; }, true,
+      "patience must be positive");
+
+  GradientBoostingModel* model;
+  if (CLI::HasParam("training"))
+  {
+    Timer::Start("gb_training");
+    model = new GradientBoostingModel();
+
+    arma::mat data = std::move(CLI::GetParam<arma::mat>("training"));
+    model->regression = CLI::HasParam("responses");
+    if (model->regression)
+    {
+      SetParameters(model->regressor);
+      arma::rowvec responses =
+          std::move(CLI::GetParam<arma::rowvec>("responses"));
+      if (CLI::HasParam("validation"))
+      {
+        RequireAtLeastOnePassed({ "validation_responses" }, true, "must pass "
+            "validation responses when validation set given");
+        arma::mat validationData =
+            std::move(CLI::GetParam<arma::mat>("validation"));
+        arma::rowvec validationResponses =
+            std::move(CLI::GetParam<arma::rowvec>("validation_responses"));
+        const double validationLoss = model->regressor.Train(data, responses,
+            validationData, validationResponses);
+        Log::Info << "Mean squared error on validation set: "
+            << validationLoss << "." << endl;
+      }
+      else
+      {
+        const double trainingLoss = model->regressor.Train(data, responses);
+        Log::Info << "Mean squared error on training set: " << trainingLoss
+            << "." << endl;
+      }
+    }
+    else
+    {
+      SetParameters(model->classifier);
+      arma::Row<size_t> labels =
+          std::move(CLI::GetParam<arma::Row<size_t>>("labels"));
+      if (CLI::HasParam("validation"))
+      {
+        RequireAtLeastOnePassed({ "validation_labels" }, true, "must pass "
+            "validation labels when validation set given");
+        arma::mat validationData =
+            std::move(CLI::GetParam<arma::mat>("validation"));
+        arma::Row<size_t> validationLabels =
+            std::move(CLI::GetParam<arma::Row<size_t>>("validation_labels"));
+        model->classifier.Loss().NumClasses() = std::max(arma::max(labels),
+            arma::max(validationLabels)) + 1;
+        const double validationLoss = model->classifier.Train(data, labels,
+            validationData, validationLabels);
+        Log::Info << "Cross-entropy on validation set: " << validationLoss
+            << "." << endl;
+      }
+      else
+      {
+        const double trainingLoss = model->classifier.Train(data, labels);
+        Log::Info << "Cross-entropy on training set: " << trainingLoss << "."
+            << endl;
+      }
+    }
+    Timer::Stop("gb_training");
+  }
+  else
+  {
+    // Then we must be loading a model.
+    model = CLI::GetParam<GradientBoostingModel*>("input_model");
+  }
+
+  if (CLI::HasParam("test"))
+  {
+    arma::mat testData = std::move(CLI::GetParam<arma::mat>("test"));
+    Timer::Start("gb_prediction");
+
+    if (model->regression)
+    {
+      ReportIgnoredParam("test_labels", "the model is a regression model");
+      ReportIgnoredParam("predictions", "the model is a regression model");
+      ReportIgnoredParam("probabilities", "the model is a regression model");
+
+      arma::rowvec predictions;
+      model->regressor.Predict(testData, predictions);
+      CLI::GetParam<arma::rowvec>("predicted_responses") =
+          std::move(predictions);
+    }
+    else
+    {
+      ReportIgnoredParam("predicted_responses", "the model is a "
+          "classification model");
+
+      arma::Row<size_t> predictions;
+      arma::mat probabilities;
+      model->classifier.Classify(testData, predictions, probabilities);
+
+      // Did we want to calculate test accuracy?
+      if (CLI::HasParam("test_labels"))
+      {
+        arma::Row<size_t> testLabels =
+            std::move(CLI::GetParam<arma::Row<size_t>>("test_labels"));
+
+        const size_t correct = arma::accu(predictions == testLabels);
+
+        Log::Info << correct << " of " << testLabels.n_elem << " correct on "
+            << "test set (" << (double(correct) / double(testLabels.n_elem) *
+            100) << ")." << endl;
+      }
+
+      CLI::GetParam<arma::mat>("probabilities") = std::move(probabilities);
+      CLI::GetParam<arma::Row<size_t>>("predictions") = std::move(predictions);
+    }
+    Timer::Stop("gb_prediction");
+  }
+
+  // Save the output model.
+  CLI::GetParam<GradientBoostingModel*>("output_model") = model;
+}
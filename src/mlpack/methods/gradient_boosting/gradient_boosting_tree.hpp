@@ -0,0 +1,166 @@
+/**
+ * @file gradient_boosting_tree.hpp
+ *
+ * Definition of the GradientBoostingTree class, the regression tree that
+ * GradientBoosting fits at every iteration.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A regression tree fit to the gradients and hessians of a loss, as in
+ * second-order gradient boosting.  The tree is grown on binned data (see
+ * HistogramNumericSplit::Bin()): every node builds a histogram of the gradient
+ * and hessian sums of its points in every dimension, in parallel over the
+ * dimensions, and splits between the bins that give the largest decrease of
+ * the regularized loss.  Only the smaller child of a split builds its own
+ * histogram; the histogram of the larger child is the difference between the
+ * histograms of the parent and the smaller child.
+ *
+ * The tree is stored flat: one entry per node in each of a few arrays, with
+ * the two children of a node next to each other.  This keeps prediction to a
+ * short loop over contiguous memory.
+ */
+class GradientBoostingTree
+{
+ public:
+  /**
+   * Create an empty tree, which predicts 0.
+   */
+  GradientBoostingTree();
+
+  /**
+   * Grow the tree on the given binned data.  The value of each leaf is the
+   * step that minimizes the second-order approximation of the loss, scaled by
+   * the learning rate.
+   *
+   * @param bins Bin of every point, with one row per point and one column per
+   *      dimension.
+   * @param boundaries Boundaries of the bins of each dimension.
+   * @param gradients Gradient of the loss for every point.
+   * @param hessians Hessian of the loss for every point.
+   * @param points Indices of the points to grow the tree on.  They are
+   *      reordered.
+   * @param maximumDepth Maximum depth of the tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param lambda L2 regularization of the leaf values.
+   * @param learningRate Factor to scale the leaf values with.
+   */
+  template<typename ElemType>
+  void Train(const arma::Mat<unsigned char>& bins,
+             const std::vector<arma::Col<ElemType>>& boundaries,
+             const arma::rowvec& gradients,
+             const arma::rowvec& hessians,
+             arma::uvec& points,
+             const size_t maximumDepth,
+             const size_t minimumLeafSize,
+             const double lambda,
+             const double learningRate);
+
+  /**
+   * Return the value of the leaf the given point falls into.
+   *
+   * @param point Point to predict for.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const
+  {
+    size_t node = 0;
+    while (children[node] != 0)
+    {
+      node = children[node] +
+          ((point[dimensions[node]] < thresholds[node]) ? 0 : 1);
+    }
+
+    return values[node];
+  }
+
+  //! Get the number of nodes in the tree.
+  size_t NumNodes() const { return values.size(); }
+
+  //! Get the split dimension of each node.
+  const std::vector<size_t>& Dimensions() const { return dimensions; }
+  //! Get the split threshold of each node; points below it go left.
+  const std::vector<double>& Thresholds() const { return thresholds; }
+  //! Get the index of the left child of each node (0 for a leaf); the right
+  //! child follows it.
+  const std::vector<size_t>& Children() const { return children; }
+  //! Get the value of each node.
+  const std::vector<double>& Values() const { return values; }
+
+  /**
+   * Serialize the tree.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! The gradient and hessian sums and the number of points in every bin of
+  //! every dimension, for the points of one node.
+  struct Histogram
+  {
+    arma::mat gradients;
+    arma::mat hessians;
+    arma::Mat<size_t> counts;
+  };
+
+  /**
+   * Build the histogram of the points [begin, begin + count) of the given
+   * indices.
+   */
+  static void BuildHistogram(const arma::Mat<unsigned char>& bins,
+                             const arma::rowvec& gradients,
+                             const arma::rowvec& hessians,
+                             const arma::uvec& points,
+                             const size_t begin,
+                             const size_t count,
+                             Histogram& histogram);
+
+  /**
+   * Grow the given node, which holds the points [begin, begin + count) of the
+   * given indices and has the given histogram.  The histogram is used as
+   * scratch space.
+   */
+  template<typename ElemType>
+  void Grow(const size_t node,
+            const arma::Mat<unsigned char>& bins,
+            const std::vector<arma::Col<ElemType>>& boundaries,
+            const arma::rowvec& gradients,
+            const arma::rowvec& hessians,
+            arma::uvec& points,
+            const size_t begin,
+            const size_t count,
+            const size_t depth,
+            Histogram& histogram,
+            const size_t maximumDepth,
+            const size_t minimumLeafSize,
+            const double lambda,
+            const double learningRate);
+
+  //! The dimension each node splits on.
+  std::vector<size_t> dimensions;
+  //! The threshold of each node.
+  std::vector<double> thresholds;
+  //! The index of the left child of each node, or 0 for a leaf.
+  std::vector<size_t> children;
+  //! The value of each node.
+  std::vector<double> values;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "gradient_boosting_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file gradient_boosting_tree_impl.hpp
+ *
+ * Implementation of the GradientBoostingTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_IMPL_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gradient_boosting_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline GradientBoostingTree::GradientBoostingTree() :
+    dimensions(1, 0),
+    thresholds(1, 0.0),
+    children(1, 0),
+    values(1, 0.0)
+{
+  // Nothing to do.
+}
+
+template<typename ElemType>
+void GradientBoostingTree::Train(
+    const arma::Mat<unsigned char>& bins,
+    const std::vector<arma::Col<ElemType>>& boundaries,
+    const arma::rowvec& gradients,
+    const arma::rowvec& hessians,
+    arma::uvec& points,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double lambda,
+    const double learningRate)
+{
+  // Start with a single leaf.
+  dimensions.assign(1, 0);
+  thresholds.assign(1, 0.0);
+  children.assign(1, 0);
+  values.assign(1, 0.0);
+
+  Histogram histogram;
+  BuildHistogram(bins, gradients, hessians, points, 0, points.n_elem,
+      histogram);
+
+  Grow(0, bins, boundaries, gradients, hessians, points, 0, points.n_elem, 1,
+      histogram, maximumDepth, std::max(minimumLeafSize, (size_t) 1), lambda,
+      learningRate);
+}
+
+inline void GradientBoostingTree::BuildHistogram(
+    const arma::Mat<unsigned char>& bins,
+    const arma::rowvec& gradients,
+    const arma::rowvec& hessians,
+    const arma::uvec& points,
+    const size_t begin,
+    const size_t count,
+    Histogram& histogram)
+{
+  // The bins are unsigned chars, so there are at most 256 of them.
+  histogram.gradients.zeros(256, bins.n_cols);
+  histogram.hessians.zeros(256, bins.n_cols);
+  histogram.counts.zeros(256, bins.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) bins.n_cols; ++d)
+  {
+    const unsigned char* column = bins.colptr(d);
+    double* gradientSums = histogram.gradients.colptr(d);
+    double* hessianSums = histogram.hessians.colptr(d);
+    size_t* counts = histogram.counts.colptr(d);
+    for (size_t i = begin; i < begin + count; ++i)
+    {
+      const size_t point = points[i];
+      const unsigned char bin = column[point];
+      gradientSums[bin] += gradients[point];
+      hessianSums[bin] += hessians[point];
+      ++counts[bin];
+    }
+  }
+}
+
+template<typename ElemType>
+void GradientBoostingTree::Grow(
+    const size_t node,
+    const arma::Mat<unsigned char>& bins,
+    const std::vector<arma::Col<ElemType>>& boundaries,
+    const arma::rowvec& gradients,
+    const arma::rowvec& hessians,
+    arma::uvec& points,
+    const size_t begin,
+    const size_t count,
+    const size_t depth,
+    Histogram& histogram,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double lambda,
+    const double learningRate)
+{
+  // Every point is in some bin of the first dimension, so the sums of the
+  // node can be taken from there.
+  const double gradientSum = arma::accu(histogram.gradients.col(0));
+  const double hessianSum = arma::accu(histogram.hessians.col(0));
+  values[node] = -learningRate * gradientSum / (hessianSum + lambda);
+
+  if ((maximumDepth != 0 && depth >= maximumDepth) ||
+      count < 2 * minimumLeafSize)
+    return;
+
+  // Find the best split of every dimension.  The gain of a split is the
+  // decrease of the regularized loss, up to a constant factor.
+  const double parentScore = gradientSum * gradientSum /
+      (hessianSum + lambda);
+  arma::vec gains(bins.n_cols, arma::fill::zeros);
+  arma::Col<size_t> splitBins(bins.n_cols, arma::fill::zeros);
+
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) bins.n_cols; ++d)
+  {
+    double leftGradient = 0.0;
+    double leftHessian = 0.0;
+    size_t leftCount = 0;
+    for (size_t bin = 0; bin < 255; ++bin)
+    {
+      // An empty bin gives the same split as the bin before it.
+      if (histogram.counts(bin, d) == 0)
+        continue;
+
+      leftGradient += histogram.gradients(bin, d);
+      leftHessian += histogram.hessians(bin, d);
+      leftCount += histogram.counts(bin, d);
+
+      // Make sure that both children are large enough.
+      if (count - leftCount < minimumLeafSize)
+        break;
+      if (leftCount < minimumLeafSize)
+        continue;
+
+      const double rightGradient = gradientSum - leftGradient;
+      const double rightHessian = hessianSum - leftHessian;
+      const double gain = leftGradient * leftGradient /
+          (leftHessian + lambda) + rightGradient * rightGradient /
+          (rightHessian + lambda) - parentScore;
+      if (gain > gains[d])
+      {
+        gains[d] = gain;
+        splitBins[d] = bin;
+      }
+    }
+  }
+
+  // If no split decreases the loss, this node is a leaf.
+  const size_t bestDim = gains.index_max();
+  if (gains[bestDim] <= 0.0)
+    return;
+
+  const size_t splitBin = splitBins[bestDim];
+  dimensions[node] = bestDim;
+  thresholds[node] = boundaries[bestDim][splitBin];
+
+  // Move the points of the left child to the front.
+  const unsigned char* column = bins.colptr(bestDim);
+  arma::uword* middle = std::partition(points.memptr() + begin,
+      points.memptr() + begin + count,
+      [column, splitBin](const arma::uword point)
+      { return column[point] <= splitBin; });
+  const size_t leftCount = middle - (points.memptr() + begin);
+  const size_t rightCount = count - leftCount;
+
+  // Add the children next to each other.
+  const size_t left = values.size();
+  children[node] = left;
+  dimensions.resize(left + 2, 0);
+  thresholds.resize(left + 2, 0.0);
+  children.resize(left + 2, 0);
+  values.resize(left + 2, 0.0);
+
+  // Build the histogram of the smaller child, and turn the histogram of this
+  // node into the histogram of the larger child.
+  Histogram smaller;
+  const bool leftSmaller = (leftCount <= rightCount);
+  BuildHistogram(bins, gradients, hessians, points,
+      leftSmaller ? begin : begin + leftCount,
+      leftSmaller ? leftCount : rightCount, smaller);
+  histogram.gradients -= smaller.gradients;
+  histogram.hessians -= smaller.hessians;
+  histogram.counts -= smaller.counts;
+
+  Grow(left, bins, boundaries, gradients, hessians, points, begin, leftCount,
+      depth + 1, leftSmaller ? smaller : histogram, maximumDepth,
+      minimumLeafSize, lambda, learningRate);
+  Grow(left + 1, bins, boundaries, gradients, hessians, points,
+      begin + leftCount, rightCount, depth + 1,
+      leftSmaller ? histogram : smaller, maximumDepth, minimumLeafSize,
+      lambda, learningRate);
+}
+
+template<typename Archive>
+void GradientBoostingTree::serialize(Archive& ar,
+                                     const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(dimensions);
+  ar & BOOST_SERIALIZATION_NVP(thresholds);
+  ar & BOOST_SERIALIZATION_NVP(children);
+  ar & BOOST_SERIALIZATION_NVP(values);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file softmax_cross_entropy_loss.hpp
+ *
+ * The softmax cross-entropy loss for multiclass gradient boosting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_SOFTMAX_CROSS_ENTROPY_LOSS_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_SOFTMAX_CROSS_ENTROPY_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The softmax cross-entropy loss, for multiclass classification with
+ * GradientBoosting.  The model has one score per class for every point, and
+ * the class probabilities are the softmax of the scores.  For the probability
+ * p of a class, the gradient of the loss with respect to the score of the class
+ * is p - 1 if the point has that class and p otherwise; the hessian is taken
+ * as p (1 - p).
+ */
+class SoftmaxCrossEntropyLoss
+{
+ public:
+  /**
+   * Create the loss.
+   *
+   * @param numClasses Number of classes.  If 0, it is taken from the labels
+   *      when training.
+   */
+  SoftmaxCrossEntropyLoss(const size_t numClasses = 0) :
+      numClasses(numClasses)
+  { /* Nothing to do. */ }
+
+  /**
+   * Compute the initial scores of the model, which are the logarithms of the
+   * (smoothed) class frequencies.
+   *
+   * @param labels Labels of the training points.
+   * @param initialScores Vector to store the initial scores in.
+   */
+  void Initialize(const arma::Row<size_t>& labels, arma::vec& initialScores)
+  {
+    if (numClasses == 0)
+      numClasses = arma::max(labels) + 1;
+
+    arma::vec counts(numClasses, arma::fill::zeros);
+    for (size_t i = 0; i < labels.n_elem; ++i)
+    {
+      if (labels[i] >= numClasses)
+      {
+        Log::Fatal << "SoftmaxCrossEntropyLoss::Initialize(): label "
+            << labels[i] << " is not less than the number of classes ("
+            << numClasses << ")!" << std::endl;
+      }
+
+      ++counts[labels[i]];
+    }
+
+    initialScores = arma::log((counts + 1) / double(labels.n_elem +
+        numClasses));
+  }
+
+  /**
+   * Compute the gradient and the hessian of the loss with respect to every
+   * score of every point.
+   *
+   * @param labels Labels of the training points.
+   * @param scores Current scores of the training points.
+   * @param gradients Matrix to store the gradients in.
+   * @param hessians Matrix to store the hessians in.
+   */
+  void Gradients(const arma::Row<size_t>& labels,
+                 const arma::mat& scores,
+                 arma::mat& gradients,
+                 arma::mat& hessians) const
+  {
+    Probabilities(scores, gradients);
+    hessians = arma::clamp(gradients % (1.0 - gradients), 1e-16, 1.0);
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      gradients(labels[i], i) -= 1.0;
+  }
+
+  /**
+   * Return the mean cross-entropy of the given scores.
+   *
+   * @param labels Labels of the points.
+   * @param scores Scores of the points.
+   */
+  double Evaluate(const arma::Row<size_t>& labels, const arma::mat& scores)
+      const
+  {
+    arma::mat probabilities;
+    Probabilities(scores, probabilities);
+
+    double loss = 0.0;
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      loss -= std::log(std::max(probabilities(labels[i], i), 1e-300));
+
+    return loss / labels.n_elem;
+  }
+
+  /**
+   * Compute the class probabilities from the given scores.
+   *
+   * @param scores Scores of the points, one column per point.
+   * @param probabilities Matrix to store the class probabilities in.
+   */
+  void Probabilities(const arma::mat& scores, arma::mat& probabilities) const
+  {
+    // Subtract the largest score of each point to avoid overflow.
+    probabilities = arma::exp(scores.each_row() - arma::max(scores, 0));
+    probabilities.each_row() /= arma::sum(probabilities, 0);
+  }
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+  //! Modify the number of classes.
+  size_t& NumClasses() { return numClasses; }
+
+  //! Serialize the loss.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(numClasses);
+  }
+
+ private:
+  //! The number of classes.
+  size_t numClasses;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
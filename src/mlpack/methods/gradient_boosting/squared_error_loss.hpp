@@ -0,0 +1,77 @@
+/**
+ * @file squared_error_loss.hpp
+ *
+ * The squared error loss for gradient boosting regression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_SQUARED_ERROR_LOSS_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_SQUARED_ERROR_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The squared error loss, for regression with GradientBoosting.  The model has
+ * one score per point, which is the predicted response.  For a response y and
+ * a score s the loss is (s - y)^2 / 2, so the gradient is s - y and the
+ * hessian is 1.
+ */
+class SquaredErrorLoss
+{
+ public:
+  /**
+   * Compute the initial score of the model, which is the mean response.
+   *
+   * @param responses Responses of the training points.
+   * @param initialScores Vector to store the initial score in.
+   */
+  void Initialize(const arma::rowvec& responses, arma::vec& initialScores)
+  {
+    initialScores.set_size(1);
+    initialScores[0] = arma::mean(responses);
+  }
+
+  /**
+   * Compute the gradient and the hessian of the loss with respect to the
+   * score of every point.
+   *
+   * @param responses Responses of the training points.
+   * @param scores Current scores of the training points.
+   * @param gradients Matrix to store the gradients in.
+   * @param hessians Matrix to store the hessians in.
+   */
+  void Gradients(const arma::rowvec& responses,
+                 const arma::mat& scores,
+                 arma::mat& gradients,
+                 arma::mat& hessians) const
+  {
+    gradients = scores - responses;
+    hessians.ones(1, responses.n_elem);
+  }
+
+  /**
+   * Return the mean squared error of the given scores.
+   *
+   * @param responses Responses of the points.
+   * @param scores Scores of the points.
+   */
+  double Evaluate(const arma::rowvec& responses, const arma::mat& scores) const
+  {
+    return arma::mean(arma::square(scores.row(0) - responses));
+  }
+
+  //! Serialize the loss (there is nothing to save).
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const unsigned int /* version */) { }
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file flat_random_forest.hpp
+ *
+ * A compiled, array-based form of a trained random forest for fast
+ * classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/decision_tree/flat_decision_tree.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A FlatRandomForest holds every tree of a trained RandomForest as a
+ * FlatDecisionTree.  To classify a set of points, the points are split into
+ * blocks that are processed in parallel, and every tree is run on a whole
+ * block before the next tree, so the nodes of a tree are reused while they
+ * are in cache.  The predictions and probabilities are exactly those of the
+ * RandomForest the FlatRandomForest was built from.
+ *
+ * @code
+ * RandomForest<> rf(data, labels, numClasses);
+ * FlatRandomForest flatForest(rf);
+ * flatForest.Classify(testData, predictions, probabilities);
+ * @endcode
+ */
+class FlatRandomForest
+{
+ public:
+  //! The number of points in a block.
+  static const size_t BlockSize = 64;
+
+  /**
+   * Create an empty FlatRandomForest.  It must be built from a trained forest
+   * before it can classify points.
+   */
+  FlatRandomForest() { /* Nothing to do. */ }
+
+  /**
+   * Build the FlatRandomForest from the given trained random forest.
+   *
+   * @param forest Trained random forest.
+   */
+  template<typename ForestType>
+  explicit FlatRandomForest(const ForestType& forest) { Build(forest); }
+
+  /**
+   * Build the FlatRandomForest from the given trained random forest, replacing
+   * anything it held before.
+   *
+   * @param forest Trained random forest.
+   */
+  template<typename ForestType>
+  void Build(const ForestType& forest);
+
+  /**
+   * Classify the given point.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point and also return the class probabilities.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class of the point.
+   * @param probabilities This will be filled with class probabilities for the
+   *      point.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return the class probabilities of each
+   * point.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for each
+   *      point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Access a tree in the forest.
+  const FlatDecisionTree& Tree(const size_t i) const { return trees[i]; }
+
+  /**
+   * Serialize the forest.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! The trees in the forest.
+  std::vector<FlatDecisionTree> trees;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_random_forest_impl.hpp"
+
+#endif
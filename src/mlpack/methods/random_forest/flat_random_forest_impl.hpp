@@ -0,0 +1,128 @@
+/**
+ * @file flat_random_forest_impl.hpp
+ *
+ * Implementation of the FlatRandomForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_RANDOM_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_random_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename ForestType>
+void FlatRandomForest::Build(const ForestType& forest)
+{
+  trees.resize(forest.NumTrees());
+  for (size_t i = 0; i < forest.NumTrees(); ++i)
+    trees[i].Build(forest.Tree(i));
+}
+
+template<typename VecType>
+size_t FlatRandomForest::Classify(const VecType& point) const
+{
+  // Pass off to another Classify() overload.
+  size_t predictedClass;
+  arma::vec probabilities;
+  Classify(point, predictedClass, probabilities);
+
+  return predictedClass;
+}
+
+template<typename VecType>
+void FlatRandomForest::Classify(const VecType& point,
+                                size_t& prediction,
+                                arma::vec& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    probabilities.clear();
+    prediction = 0;
+
+    throw std::invalid_argument("FlatRandomForest::Classify(): no random "
+        "forest built!");
+  }
+
+  probabilities.zeros(trees[0].NumClasses());
+  for (size_t i = 0; i < trees.size(); ++i)
+    probabilities += trees[i].LeafProbabilities().col(trees[i].Leaf(point));
+
+  // Find maximum element after renormalizing probabilities.
+  probabilities /= trees.size();
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+
+  // Set prediction.
+  prediction = (size_t) maxIndex;
+}
+
+template<typename MatType>
+void FlatRandomForest::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void FlatRandomForest::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions,
+                                arma::mat& probabilities) const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("FlatRandomForest::Classify(): no random "
+        "forest built!");
+  }
+
+  probabilities.zeros(trees[0].NumClasses(), data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  // Every block only touches its own part of the leaves.
+  arma::Row<size_t> leaves(data.n_cols);
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize, (size_t) data.n_cols);
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      trees[t].Leaves(data, begin, end, leaves);
+      for (size_t i = begin; i < end; ++i)
+        probabilities.col(i) += trees[t].LeafProbabilities().col(leaves[i]);
+    }
+
+    // Find maximum element after renormalizing probabilities.
+    for (size_t i = begin; i < end; ++i)
+    {
+      probabilities.col(i) /= trees.size();
+      arma::uword maxIndex = 0;
+      probabilities.col(i).max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
+  }
+}
+
+template<typename Archive>
+void FlatRandomForest::serialize(Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(trees);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -256,7 +256,8 @@ static void mlpackMain()
     // Get predictions and probabilities.
     arma::Row<size_t> predictions;
     arma::mat probabilities;
-    rfModel->rf.Classify(testData, predictions, probabilities);
+    FlatRandomForest(rfModel->rf).Classify(testData, predictions,
+        probabilities);
 
     // Did we want to calculate test accuracy?
     if (CLI::HasParam("test_labels"))
@@ -14,7 +14,7 @@
 #define MLPACK_METHODS_RL_ASYNC_LEARNING_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
-#include "queue"
+#include <atomic>
 
 namespace mlpack {
 namespace rl {
@@ -68,22 +68,28 @@ void AsyncLearning<
   NetworkType learningNetwork = std::move(this->learningNetwork);
   if (learningNetwork.Parameters().is_empty())
     learningNetwork.ResetParameters();
-  NetworkType targetNetwork = learningNetwork;
-  size_t totalSteps = 0;
+  std::atomic<size_t> totalSteps(0);
   PolicyType policy = this->policy;
-  bool stop = false;
+  std::atomic<bool> stop(false);
 
-  // Set up worker pool, worker 0 will be deterministic for evaluation.
+  // Set up worker pool, worker 0 will be deterministic for evaluation.  Each
+  // worker keeps its own copy of the target network, so no network is shared
+  // for prediction.  The pool is reserved up front so that the workers are
+  // never relocated once they are initialized.
   std::vector<WorkerType> workers;
+  workers.reserve(config.NumWorkers() + 1);
   for (size_t i = 0; i <= config.NumWorkers(); ++i)
   {
     workers.push_back(WorkerType(updater, environment, config, !i));
     workers.back().Initialize(learningNetwork);
   }
-  // Set up task queue corresponding to worker pool.
-  std::queue<size_t> tasks;
-  for (size_t i = 0; i <= config.NumWorkers(); ++i)
-    tasks.push(i);
+
+  // Instead of a locked task queue every worker has an atomic flag that marks
+  // whether a thread is currently running it.  A thread claims a worker with
+  // a single compare-and-swap and otherwise moves on to the next one.
+  std::vector<std::atomic<bool> > busy(workers.size());
+  for (size_t i = 0; i < busy.size(); ++i)
+    busy[i] = false;
 
   /**
    * Compute the number of threads for the for-loop. In general, we should use
@@ -95,8 +101,8 @@ void AsyncLearning<
   numThreads++;
   Log::Debug << numThreads << " threads will be used in total." << std::endl;
 
-  #pragma omp parallel for shared(stop, workers, tasks, learningNetwork, \
-      targetNetwork, totalSteps, policy)
+  #pragma omp parallel for shared(stop, workers, busy, learningNetwork, \
+      totalSteps, policy)
   for (omp_size_t i = 0; i < numThreads; ++i)
   {
     #pragma omp critical
@@ -106,34 +112,32 @@ void AsyncLearning<
             " started." << std::endl;
       #endif
     }
-    size_t task = std::numeric_limits<size_t>::max();
+    // Threads start at different workers to avoid contending for the same
+    // flag; the scan visits every worker in turn, so the evaluation worker
+    // keeps running even when there are fewer threads than workers.
+    size_t task = i % workers.size();
     while (!stop)
     {
-      // Assign task to current thread from queue.
-      #pragma omp critical
+      // Try to claim the current worker, and move on to the next one if
+      // another thread is running it.
+      bool expected = false;
+      if (!busy[task].compare_exchange_strong(expected, true))
       {
-        if (task != std::numeric_limits<size_t>::max())
-          tasks.push(task);
-
-        if (!tasks.empty())
-        {
-          task = tasks.front();
-          tasks.pop();
-        }
-      };
-
-      // This may happen when threads are more than workers.
-      if (task == std::numeric_limits<size_t>::max())
+        task = (task + 1) % workers.size();
         continue;
+      }
 
       // Get corresponding worker.
       WorkerType& worker = workers[task];
       double episodeReturn;
-      if (worker.Step(learningNetwork, targetNetwork, totalSteps,
-          policy, episodeReturn) && !task)
+      if (worker.Step(learningNetwork, totalSteps, policy, episodeReturn) &&
+          !task)
       {
         stop = measure(episodeReturn);
       }
+
+      busy[task] = false;
+      task = (task + 1) % workers.size();
     }
   }
 
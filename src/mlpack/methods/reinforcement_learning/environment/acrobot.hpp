@@ -210,6 +210,22 @@ class Acrobot
     return State((arma::randu<arma::colvec>(4) - 0.5) / 5.0);
   }
 
+  /**
+   * Random initialization of the state space, drawn from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    stepsPerformed = 0;
+    std::uniform_real_distribution<> uniform(-0.1, 0.1);
+    arma::colvec data(4);
+    data.imbue([&]() { return uniform(generator); });
+    return State(data);
+  }
+
   /**
    * This function checks if the acrobot has reached the terminal state.
    *
@@ -181,6 +181,62 @@ class CartPole
     return 1.0;
   }
 
+  /**
+   * Dynamics of Cart Pole for a batch of states, one encoded state per
+   * column.  All states are advanced with the same vectorized expressions.
+   * Like the single state Sample(), an episode that reaches maxSteps is
+   * terminal and its last step is rewarded with doneReward.
+   *
+   * @param states The current states.
+   * @param actions The action for each state.
+   * @param stepsPerformed The number of steps performed in the episode of
+   *     each state, including this one.
+   * @param nextStates The next states.
+   * @param rewards The reward of each transition.
+   * @param terminal Whether each next state is terminal.
+   */
+  void Sample(const arma::mat& states,
+              const std::vector<Action>& actions,
+              const arma::urowvec& stepsPerformed,
+              arma::mat& nextStates,
+              arma::rowvec& rewards,
+              arma::urowvec& terminal) const
+  {
+    arma::rowvec force(actions.size());
+    for (size_t i = 0; i < actions.size(); ++i)
+      force[i] = actions[i] ? forceMag : -forceMag;
+
+    // Calculate acceleration.
+    const arma::rowvec cosTheta = arma::cos(states.row(2));
+    const arma::rowvec sinTheta = arma::sin(states.row(2));
+    const arma::rowvec temp = (force + poleMassLength *
+        arma::square(states.row(3)) % sinTheta) / totalMass;
+    const arma::rowvec thetaAcc = (gravity * sinTheta - cosTheta % temp) /
+        (length * (4.0 / 3.0 - massPole * arma::square(cosTheta) / totalMass));
+    const arma::rowvec xAcc = temp - poleMassLength * thetaAcc % cosTheta /
+        totalMass;
+
+    // Update states.
+    nextStates.set_size(State::dimension, states.n_cols);
+    nextStates.row(0) = states.row(0) + tau * states.row(1);
+    nextStates.row(1) = states.row(1) + tau * xAcc;
+    nextStates.row(2) = states.row(2) + tau * states.row(3);
+    nextStates.row(3) = states.row(3) + tau * thetaAcc;
+
+    // The agent is not rewarded for the step in which it fails.
+    terminal = (arma::abs(nextStates.row(0)) > xThreshold) ||
+        (arma::abs(nextStates.row(2)) > thetaThresholdRadians);
+    rewards.ones(states.n_cols);
+    rewards.elem(arma::find(terminal)).zeros();
+
+    if (maxSteps != 0)
+    {
+      const arma::uvec finished = arma::find(stepsPerformed >= maxSteps);
+      terminal.elem(finished).ones();
+      rewards.elem(finished).fill(doneReward);
+    }
+  }
+
   /**
    * Dynamics of Cart Pole. Get reward based on current state and current
    * action.
@@ -206,6 +262,23 @@ class CartPole
     return State((arma::randu<arma::colvec>(4) - 0.5) / 10.0);
   }
 
+  /**
+   * Draw the initial state like InitialSample(), but from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   * @return Initial state for each episode.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    stepsPerformed = 0;
+    std::uniform_real_distribution<> uniform(-0.05, 0.05);
+    arma::colvec data(4);
+    data.imbue([&]() { return uniform(generator); });
+    return State(data);
+  }
+
   /**
    * This function checks if the cart has reached the terminal state.
    *
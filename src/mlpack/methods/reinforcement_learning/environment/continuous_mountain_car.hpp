@@ -191,6 +191,23 @@ class ContinuousMountainCar
     return state;
   }
 
+  /**
+   * Draw the initial state like InitialSample(), but from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   * @return Initial state for each episode.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    State state;
+    stepsPerformed = 0;
+    state.Velocity() = 0.0;
+    state.Position() = std::uniform_real_distribution<>(-0.6, -0.4)(generator);
+    return state;
+  }
+
   /**
    * Whether given state is a terminal state.
    *
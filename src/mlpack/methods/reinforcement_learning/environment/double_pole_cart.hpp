@@ -287,6 +287,23 @@ class DoublePoleCart
     return State((arma::randu<arma::vec>(6) - 0.5) / 10.0);
   }
 
+  /**
+   * Draw the initial state like InitialSample(), but from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   * @return Initial state for each episode.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    stepsPerformed = 0;
+    std::uniform_real_distribution<> uniform(-0.05, 0.05);
+    arma::colvec data(6);
+    data.imbue([&]() { return uniform(generator); });
+    return State(data);
+  }
+
   /**
    * This function checks if the car has reached the terminal state.
    *
@@ -158,6 +158,58 @@ class MountainCar
     return -1;
   }
 
+  /**
+   * Dynamics of Mountain Car for a batch of states, one encoded state per
+   * column.  All states are advanced with the same vectorized expressions.
+   * Like the single state Sample(), an episode that reaches maxSteps is
+   * terminal and its last step is not rewarded.
+   *
+   * @param states The current states.
+   * @param actions The action for each state.
+   * @param stepsPerformed The number of steps performed in the episode of
+   *     each state, including this one.
+   * @param nextStates The next states.
+   * @param rewards The reward of each transition.
+   * @param terminal Whether each next state is terminal.
+   */
+  void Sample(const arma::mat& states,
+              const std::vector<Action>& actions,
+              const arma::urowvec& stepsPerformed,
+              arma::mat& nextStates,
+              arma::rowvec& rewards,
+              arma::urowvec& terminal) const
+  {
+    arma::rowvec direction(actions.size());
+    for (size_t i = 0; i < actions.size(); ++i)
+      direction[i] = (double) actions[i] - 1.0;
+
+    nextStates.set_size(State::dimension, states.n_cols);
+    nextStates.row(0) = arma::clamp(states.row(0) + 0.001 * direction -
+        0.0025 * arma::cos(3 * states.row(1)), velocityMin, velocityMax);
+    nextStates.row(1) = arma::clamp(states.row(1) + nextStates.row(0),
+        positionMin, positionMax);
+
+    // The car stops at the left boundary.
+    for (size_t i = 0; i < nextStates.n_cols; ++i)
+    {
+      if (nextStates(1, i) == positionMin && nextStates(0, i) < 0)
+        nextStates(0, i) = 0.0;
+    }
+
+    terminal = (nextStates.row(1) >= positionGoal);
+    rewards.set_size(states.n_cols);
+    rewards.fill(-1);
+    rewards.elem(arma::find(terminal)).fill(doneReward);
+
+    // Do not reward the agent if time ran out.
+    if (maxSteps != 0)
+    {
+      const arma::uvec finished = arma::find(stepsPerformed >= maxSteps);
+      terminal.elem(finished).ones();
+      rewards.elem(finished).zeros();
+    }
+  }
+
   /**
    * Dynamics of Mountain Car. Get reward based on current state and current
    * action.
@@ -187,6 +239,23 @@ class MountainCar
     return state;
   }
 
+  /**
+   * Draw the initial state like InitialSample(), but from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   * @return Initial state for each episode.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    State state;
+    stepsPerformed = 0;
+    state.Velocity() = 0.0;
+    state.Position() = std::uniform_real_distribution<>(-0.6, -0.4)(generator);
+    return state;
+  }
+
   /**
    * This function checks if the car has reached the terminal state.
    *
@@ -184,6 +184,24 @@ class Pendulum
     return state;
   }
 
+  /**
+   * Draw the initial state like InitialSample(), but from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   * @return Initial state for each episode.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    State state;
+    state.Theta() = std::uniform_real_distribution<>(-M_PI, M_PI)(generator);
+    state.AngularVelocity() =
+        std::uniform_real_distribution<>(-1.0, 1.0)(generator);
+    stepsPerformed = 0;
+    return state;
+  }
+
   /**
    * This function calculates the normalized angle for a particular theta.
    *
@@ -64,6 +64,18 @@ class RewardClipping
     return environment.InitialSample();
   }
 
+  /**
+   * Returns the initial state the environment draws from the given random
+   * number generator.
+   *
+   * @param generator Random number generator to draw from.
+   */
+  template<typename GeneratorType>
+  State InitialSample(GeneratorType& generator)
+  {
+    return environment.InitialSample(generator);
+  }
+
   /**
    * Checks whether given state is a terminal state.
    * Returns the value by calling the environment method.
@@ -0,0 +1,244 @@
+/**
+ * @file vector_environment.hpp
+ *
+ * Vectorized wrapper for RL environments, which advances several copies of
+ * an environment in lockstep.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTOR_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTOR_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace rl {
+
+HAS_MEM_FUNC(Sample, HasBatchSampleCheck);
+
+/**
+ * Run a number of copies of an environment side by side.  The states of all
+ * copies are kept in one matrix with one encoded state per column, so an
+ * agent can select the actions of all copies with a single forward pass.
+ * Copies whose episode ends are restarted right away, so every call to Step()
+ * advances all of them.
+ *
+ * If the environment provides a batched Sample() overload of the form
+ *
+ * @code
+ * void Sample(const arma::mat& states,
+ *             const std::vector<Action>& actions,
+ *             const arma::urowvec& stepsPerformed,
+ *             arma::mat& nextStates,
+ *             arma::rowvec& rewards,
+ *             arma::urowvec& terminal) const;
+ * @endcode
+ *
+ * the transitions of all copies are computed with one call, otherwise every
+ * copy is sampled on its own.  The batched overload is given the number of
+ * steps of each episode, so that it applies the maximum number of steps of
+ * the environment just like the single state Sample() does.
+ *
+ * @tparam EnvironmentType A type of Environment that is being wrapped.
+ */
+template<typename EnvironmentType>
+class VectorEnvironment
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  /**
+   * Create the given number of copies of the environment and start an episode
+   * in each of them.  Episodes are restarted after the MaxSteps() of the
+   * environment.
+   *
+   * @param numEnvironments The number of environment copies.
+   * @param environment The environment to copy.
+   */
+  VectorEnvironment(const size_t numEnvironments,
+                    const EnvironmentType& environment = EnvironmentType()) :
+      VectorEnvironment(numEnvironments, environment, environment.MaxSteps())
+  { /* Nothing to do here. */ }
+
+  /**
+   * Create the given number of copies of the environment and start an episode
+   * in each of them.
+   *
+   * @param numEnvironments The number of environment copies.
+   * @param environment The environment to copy.
+   * @param stepLimit The number of steps after which an episode is restarted.
+   *     If the value is 0, there is no limit.
+   */
+  VectorEnvironment(const size_t numEnvironments,
+                    const EnvironmentType& environment,
+                    const size_t stepLimit) :
+      environments(numEnvironments, environment),
+      stepLimit(stepLimit)
+  {
+    if (numEnvironments == 0)
+    {
+      Log::Fatal << "VectorEnvironment: the number of environments must be "
+          << "positive!" << std::endl;
+    }
+
+    Reset();
+  }
+
+  /**
+   * Start a new episode in every copy.
+   */
+  void Reset()
+  {
+    const arma::colvec initial = environments[0].InitialSample().Encode();
+    states.set_size(initial.n_elem, environments.size());
+    states.col(0) = initial;
+    for (size_t i = 1; i < environments.size(); ++i)
+      states.col(i) = environments[i].InitialSample().Encode();
+
+    steps.zeros(environments.size());
+    returns.zeros(environments.size());
+    finishedReturns.clear();
+  }
+
+  /**
+   * Advance every copy by one step with the given actions.  The next states
+   * are returned before any copy is restarted, so that the transitions can be
+   * stored for replay.
+   *
+   * @param actions The action for each copy.
+   * @param rewards The reward of each transition.
+   * @param nextStates The state each copy reached, one per column.
+   * @param terminal Whether each copy reached a terminal state.
+   */
+  void Step(const std::vector<Action>& actions,
+            arma::rowvec& rewards,
+            arma::mat& nextStates,
+            arma::urowvec& terminal)
+  {
+    if (actions.size() != environments.size())
+    {
+      Log::Fatal << "VectorEnvironment::Step(): expected "
+          << environments.size() << " actions, but got " << actions.size()
+          << "!" << std::endl;
+    }
+
+    steps += 1;
+    Sample(actions, rewards, nextStates, terminal);
+
+    states = nextStates;
+    returns += rewards;
+
+    // Restart the copies whose episode has ended.
+    finishedReturns.clear();
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      if (terminal[i] || (stepLimit != 0 && steps[i] >= stepLimit))
+      {
+        finishedReturns.push_back(returns[i]);
+        states.col(i) = environments[i].InitialSample().Encode();
+        steps[i] = 0;
+        returns[i] = 0;
+      }
+    }
+  }
+
+  //! Get the current states, one encoded state per column.
+  const arma::mat& States() const { return states; }
+
+  //! Get the current state of the given copy.
+  State CurrentState(const size_t i) const
+  {
+    return State(arma::colvec(states.col(i)));
+  }
+
+  //! Get the returns of the episodes that ended during the last Step().
+  const std::vector<double>& FinishedReturns() const { return finishedReturns; }
+
+  //! Get the number of environment copies.
+  size_t NumEnvironments() const { return environments.size(); }
+
+  //! Get the given environment copy.
+  const EnvironmentType& Environment(const size_t i) const
+  { return environments[i]; }
+  //! Modify the given environment copy.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the step limit of an episode.
+  size_t StepLimit() const { return stepLimit; }
+  //! Modify the step limit of an episode.
+  size_t& StepLimit() { return stepLimit; }
+
+ private:
+  //! Signature of the batched Sample() overload.
+  template<typename T>
+  using BatchSampleSignature = void(T::*)(const arma::mat&,
+      const std::vector<typename T::Action>&, const arma::urowvec&,
+      arma::mat&, arma::rowvec&, arma::urowvec&) const;
+
+  //! Sample all copies with one call if the environment supports batches.
+  template<typename T = EnvironmentType>
+  typename std::enable_if<
+      HasBatchSampleCheck<T, BatchSampleSignature<T>>::value, void>::type
+  Sample(const std::vector<Action>& actions,
+         arma::rowvec& rewards,
+         arma::mat& nextStates,
+         arma::urowvec& terminal)
+  {
+    environments[0].Sample(states, actions, steps, nextStates, rewards,
+        terminal);
+  }
+
+  //! Sample every copy on its own.
+  template<typename T = EnvironmentType>
+  typename std::enable_if<
+      !HasBatchSampleCheck<T, BatchSampleSignature<T>>::value, void>::type
+  Sample(const std::vector<Action>& actions,
+         arma::rowvec& rewards,
+         arma::mat& nextStates,
+         arma::urowvec& terminal)
+  {
+    rewards.set_size(environments.size());
+    nextStates.set_size(states.n_rows, states.n_cols);
+    terminal.set_size(environments.size());
+
+    State nextState;
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards[i] = environments[i].Sample(CurrentState(i), actions[i],
+          nextState);
+      nextStates.col(i) = nextState.Encode();
+      terminal[i] = environments[i].IsTerminal(nextState);
+    }
+  }
+
+  //! Locally-stored environment copies.
+  std::vector<EnvironmentType> environments;
+
+  //! Locally-stored current states, one per column.
+  arma::mat states;
+
+  //! Locally-stored number of steps in the current episode of each copy.
+  arma::urowvec steps;
+
+  //! Locally-stored return of the current episode of each copy.
+  arma::rowvec returns;
+
+  //! Locally-stored returns of the episodes ended in the last step.
+  std::vector<double> finishedReturns;
+
+  //! Locally-stored step limit of an episode.
+  size_t stepLimit;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -57,6 +57,28 @@ class AggregatedPolicy
     return policies[selected].Sample(actionValue, false);
   }
 
+  /**
+   * Sample an action based on given action values, drawing the child policy
+   * and its action from the given random number generator.
+   *
+   * @param actionValue Values for each action.
+   * @param generator Random number generator to draw from.
+   * @param deterministic Always select the action greedily.
+   * @return Sampled action.
+   */
+  template<typename GeneratorType>
+  ActionType Sample(const arma::colvec& actionValue,
+                    GeneratorType& generator,
+                    bool deterministic = false)
+  {
+    if (deterministic)
+      return policies.front().Sample(actionValue, generator, true);
+    const arma::vec& probabilities = sampler.Probabilities();
+    std::discrete_distribution<size_t> select(probabilities.begin(),
+        probabilities.end());
+    return policies[select(generator)].Sample(actionValue, generator, false);
+  }
+
   /**
    * Exploration probability will anneal at each step.
    */
@@ -74,6 +74,35 @@ class GreedyPolicy
         arma::as_scalar(arma::find(actionValue == actionValue.max(), 1)));
   }
 
+  /**
+   * Sample an action based on given action values, drawing the exploration
+   * from the given random number generator instead of the mlpack one.  This
+   * lets several copies of the policy sample from different threads.
+   *
+   * @param actionValue Values for each action.
+   * @param generator Random number generator to draw from.
+   * @param deterministic Always select the action greedily.
+   * @return Sampled action.
+   */
+  template<typename GeneratorType>
+  ActionType Sample(const arma::colvec& actionValue,
+                    GeneratorType& generator,
+                    bool deterministic = false)
+  {
+    std::uniform_real_distribution<> uniform;
+
+    // Select the action randomly.
+    if (!deterministic && uniform(generator) < epsilon)
+    {
+      std::uniform_int_distribution<size_t> actions(0, ActionType::size - 1);
+      return static_cast<ActionType>(actions(generator));
+    }
+
+    // Select the action greedily.
+    return static_cast<ActionType>(
+        arma::as_scalar(arma::find(actionValue == actionValue.max(), 1)));
+  }
+
   /**
    * Exploration probability will anneal at each step.
    */
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "environment/vector_environment.hpp"
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
 #include "training_config.hpp"
@@ -95,12 +96,49 @@ class QLearning
    */
   double Step();
 
+  /**
+   * Execute a step in each copy of a vectorized environment.  The actions of
+   * all copies are selected with one batched forward pass, every transition
+   * is stored for replay and a single learning step follows.  Episodes that
+   * end are restarted by the environment wrapper.
+   *
+   * @param environments The environment copies to advance.
+   * @return Sum of the rewards of all copies for the step.
+   */
+  double Step(VectorEnvironment<EnvironmentType>& environments);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
    */
   double Episode();
 
+  /**
+   * Train the agent with separate actor and learner threads.  Each of
+   * config.NumWorkers() actor threads owns a copy of the environment, the
+   * behavior policy and the network, and generates experience into a shared
+   * queue.  The calling thread acts as the learner: it moves the queued
+   * transitions into the replay memory, trains the learning network and
+   * publishes its weights to the actors every config.PublishInterval()
+   * updates.
+   *
+   * The learner performs one update per config.UpdateInterval() environment
+   * steps after the exploration steps, and the actors block once they are
+   * config.ActorLead() steps ahead of that rate, so neither side can outrun
+   * the other.
+   *
+   * Every actor draws its actions and initial states from its own random
+   * number generator, seeded from math::randGen before the threads start, so
+   * the behavior policy must provide Sample(actionValue, generator) and the
+   * environment InitialSample(generator).
+   *
+   * @param measure The measurement instance, called by the learner with the
+   *     return of every finished episode.  Training stops when it returns
+   *     true.
+   */
+  template<typename MeasureType>
+  void TrainActorLearner(MeasureType& measure);
+
   /**
    * @return Total steps from beginning.
    */
@@ -126,7 +164,33 @@ class QLearning
   //! Modify the learning network.
   NetworkType& Network() { return learningNetwork; }
 
+  //! Get the number of steps taken by the actors in the last actor-learner run.
+  size_t ActorSteps() const { return actorSteps; }
+  //! Get the number of learner updates in the last actor-learner run.
+  size_t LearnerUpdates() const { return learnerUpdates; }
+  //! Get the actor throughput of the last actor-learner run in steps/second.
+  double ActorStepsPerSecond() const
+  { return (elapsedTime > 0) ? actorSteps / elapsedTime : 0.0; }
+  //! Get the learner throughput of the last actor-learner run in
+  //! updates/second.
+  double LearnerUpdatesPerSecond() const
+  { return (elapsedTime > 0) ? learnerUpdates / elapsedTime : 0.0; }
+  //! Get the total time in seconds the actors were blocked by the learner.
+  double ActorWaitTime() const { return actorWaitTime; }
+  //! Get the time in seconds the learner waited for experience.
+  double LearnerWaitTime() const { return learnerWaitTime; }
+
  private:
+  //! A transition generated by an actor and not yet stored for replay.
+  struct Transition
+  {
+    StateType state;
+    ActionType action;
+    double reward;
+    StateType nextState;
+    bool isEnd;
+  };
+
   /**
    * Select the best action based on given action value.
    * @param actionValues Action values.
@@ -134,6 +198,11 @@ class QLearning
    */
   arma::Col<size_t> BestAction(const arma::mat& actionValues);
 
+  /**
+   * Sample a batch from the replay memory and update the learning network.
+   */
+  void TrainAgent();
+
   //! Locally-stored hyper-parameters.
   TrainingConfig config;
 
@@ -166,6 +235,36 @@ class QLearning
 
   //! Locally-stored flag indicating training mode or test mode.
   bool deterministic;
+
+  //! Locally-stored encoded states sampled from the replay memory.
+  arma::mat sampledStates;
+
+  //! Locally-stored actions sampled from the replay memory.
+  arma::icolvec sampledActions;
+
+  //! Locally-stored rewards sampled from the replay memory.
+  arma::colvec sampledRewards;
+
+  //! Locally-stored encoded next states sampled from the replay memory.
+  arma::mat sampledNextStates;
+
+  //! Locally-stored termination flags sampled from the replay memory.
+  arma::icolvec isTerminal;
+
+  //! Number of actor steps in the last actor-learner run.
+  size_t actorSteps;
+
+  //! Number of learner updates in the last actor-learner run.
+  size_t learnerUpdates;
+
+  //! Duration of the last actor-learner run in seconds.
+  double elapsedTime;
+
+  //! Total time the actors were blocked in the last actor-learner run.
+  double actorWaitTime;
+
+  //! Time the learner waited for experience in the last actor-learner run.
+  double learnerWaitTime;
 };
 
 } // namespace rl
@@ -14,6 +14,13 @@
 
 #include "q_learning.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+
 namespace mlpack {
 namespace rl {
 
@@ -46,7 +53,12 @@ QLearning<
     replayMethod(std::move(replayMethod)),
     environment(std::move(environment)),
     totalSteps(0),
-    deterministic(false)
+    deterministic(false),
+    actorSteps(0),
+    learnerUpdates(0),
+    elapsedTime(0),
+    actorWaitTime(0),
+    learnerWaitTime(0)
 {
   // Set up q-learning network.
   if (learningNetwork.Parameters().is_empty())
@@ -147,15 +159,93 @@ double QLearning<
   if (deterministic || totalSteps < config.ExplorationSteps())
     return reward;
 
-  // Start experience replay.
+  TrainAgent();
+
+  return reward;
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Step(VectorEnvironment<EnvironmentType>& environments)
+{
+  // Get the action values of all copies with a single forward pass.
+  const arma::mat states = environments.States();
+  arma::mat actionValues;
+  learningNetwork.Predict(states, actionValues);
+
+  // Select an action for each copy according to the behavior policy.
+  std::vector<ActionType> actions(actionValues.n_cols);
+  for (size_t i = 0; i < actionValues.n_cols; ++i)
+    actions[i] = policy.Sample(actionValues.unsafe_col(i), deterministic);
+
+  // Advance all copies at once.
+  arma::rowvec rewards;
+  arma::mat nextStates;
+  arma::urowvec terminal;
+  environments.Step(actions, rewards, nextStates, terminal);
+
+  // Store the transitions for replay.
+  for (size_t i = 0; i < states.n_cols; ++i)
+  {
+    replayMethod.Store(StateType(arma::colvec(states.col(i))), actions[i],
+        rewards[i], StateType(arma::colvec(nextStates.col(i))),
+        terminal[i]);
+  }
+
+  // Update current state.
+  state = environments.CurrentState(0);
+
+  if (deterministic)
+    return arma::accu(rewards);
+
+  if (totalSteps >= config.ExplorationSteps())
+    TrainAgent();
+
+  // Every copy counts as a step for the target network and the policy.
+  for (size_t i = 0; i < states.n_cols; ++i)
+  {
+    totalSteps++;
+
+    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+      targetNetwork = learningNetwork;
 
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  arma::icolvec sampledActions;
-  arma::colvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::icolvec isTerminal;
+    if (totalSteps > config.ExplorationSteps())
+      policy.Anneal();
+  }
+
+  return arma::accu(rewards);
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::TrainAgent()
+{
+  // Start experience replay.
 
+  // Sample from previous experience.  The sample buffers are members, so
+  // that their memory is reused from one step to the next.
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
@@ -210,8 +300,6 @@ double QLearning<
   updatePolicy->Update(learningNetwork.Parameters(), config.StepSize(),
       gradients);
   #endif
-
-  return reward;
 }
 
 template <
@@ -263,6 +351,242 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+template<typename MeasureType>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::TrainActorLearner(MeasureType& measure)
+{
+  const size_t numActors = config.NumWorkers();
+  if (numActors == 0)
+  {
+    Log::Fatal << "QLearning::TrainActorLearner(): the number of workers must "
+        << "be positive!" << std::endl;
+  }
+
+  const size_t explorationSteps = config.ExplorationSteps();
+  const size_t updateInterval = std::max(config.UpdateInterval(), (size_t) 1);
+  const size_t publishInterval = std::max(config.PublishInterval(),
+      (size_t) 1);
+  const size_t actorLead = config.ActorLead();
+
+  actorSteps = 0;
+  learnerUpdates = 0;
+  actorWaitTime = 0;
+  learnerWaitTime = 0;
+
+  // The queue of new experience and the step counters are shared between the
+  // actors and the learner, and are guarded by this mutex.
+  std::mutex mutex;
+  std::condition_variable experienceReady;
+  std::condition_variable learnerProgress;
+  std::vector<Transition> pending;
+  std::vector<double> finishedReturns;
+  bool stop = false;
+
+  // The weights the learner published last.  The actors only take the lock
+  // when the version has changed.
+  std::mutex publishMutex;
+  arma::mat publishedParameters = learningNetwork.Parameters();
+  std::atomic<size_t> publishedVersion(0);
+
+  // Give every actor its own network, policy and environment.  The copies are
+  // made here, before any thread touches the originals.
+  std::vector<NetworkType> networks(numActors, learningNetwork);
+  for (size_t i = 0; i < numActors; ++i)
+    networks[i].LinkParameters();
+  std::vector<BehaviorPolicyType> policies(numActors, policy);
+  std::vector<EnvironmentType> environments(numActors, environment);
+  std::vector<double> waitTimes(numActors, 0.0);
+
+  // The actors must not touch the mlpack generator, which the learner uses
+  // for replay sampling.  Each one draws from its own generator instead,
+  // seeded here from the mlpack generator so that math::RandomSeed() still
+  // fixes the experience of every actor.
+  std::vector<std::mt19937> generators;
+  generators.reserve(numActors);
+  for (size_t i = 0; i < numActors; ++i)
+    generators.emplace_back(math::randGen());
+
+  auto act = [&](const size_t id)
+  {
+    NetworkType& network = networks[id];
+    BehaviorPolicyType& actorPolicy = policies[id];
+    EnvironmentType& actorEnvironment = environments[id];
+    std::mt19937& generator = generators[id];
+
+    size_t version = 0;
+    StateType actorState = actorEnvironment.InitialSample(generator);
+    size_t steps = 0;
+    double episodeReturn = 0.0;
+    arma::colvec actionValue;
+    while (true)
+    {
+      // Pick up the latest weights of the learner.
+      if (publishedVersion.load() != version)
+      {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        network.Parameters() = publishedParameters;
+        version = publishedVersion.load();
+      }
+
+      network.Predict(actorState.Encode(), actionValue);
+      const ActionType action = actorPolicy.Sample(actionValue, generator);
+
+      StateType nextState;
+      const double reward = actorEnvironment.Sample(actorState, action,
+          nextState);
+      const bool isEnd = actorEnvironment.IsTerminal(nextState);
+      episodeReturn += reward;
+      steps++;
+      const bool episodeEnd = isEnd ||
+          (config.StepLimit() && steps >= config.StepLimit());
+
+      bool explored;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Wait while the actors are too far ahead of the learner.
+        auto ahead = [&]()
+        {
+          return actorSteps >= explorationSteps +
+              learnerUpdates * updateInterval + actorLead;
+        };
+        if (!stop && ahead())
+        {
+          const auto start = std::chrono::steady_clock::now();
+          learnerProgress.wait(lock, [&]() { return stop || !ahead(); });
+          waitTimes[id] += std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - start).count();
+        }
+
+        if (stop)
+          break;
+
+        pending.push_back(Transition{ actorState, action, reward, nextState,
+            isEnd });
+        if (episodeEnd)
+          finishedReturns.push_back(episodeReturn);
+        explored = (++actorSteps > explorationSteps);
+      }
+      experienceReady.notify_one();
+
+      if (explored)
+        actorPolicy.Anneal();
+
+      if (episodeEnd)
+      {
+        actorState = actorEnvironment.InitialSample(generator);
+        steps = 0;
+        episodeReturn = 0.0;
+      }
+      else
+      {
+        actorState = nextState;
+      }
+    }
+  };
+
+  // The learner may make one update per updateInterval stored steps once the
+  // exploration steps have passed.  Only the learner changes totalSteps and
+  // learnerUpdates, so it can read them without the lock.
+  auto canUpdate = [&]()
+  {
+    return totalSteps >= explorationSteps &&
+        learnerUpdates * updateInterval <= totalSteps - explorationSteps;
+  };
+
+  const auto startTime = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> actors;
+  actors.reserve(numActors);
+  for (size_t i = 0; i < numActors; ++i)
+    actors.emplace_back(act, i);
+
+  std::vector<Transition> transitions;
+  std::vector<double> returns;
+  bool done = false;
+  while (!done)
+  {
+    // Take all queued experience, waiting for some if there is nothing else
+    // to do.
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (pending.empty() && !canUpdate())
+      {
+        const auto start = std::chrono::steady_clock::now();
+        experienceReady.wait(lock, [&]() { return !pending.empty(); });
+        learnerWaitTime += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+      }
+
+      transitions.swap(pending);
+      returns.swap(finishedReturns);
+    }
+
+    for (const Transition& t : transitions)
+    {
+      replayMethod.Store(t.state, t.action, t.reward, t.nextState, t.isEnd);
+
+      // Update target network.
+      if (++totalSteps % config.TargetNetworkSyncInterval() == 0)
+        targetNetwork = learningNetwork;
+    }
+    transitions.clear();
+
+    for (const double episodeReturn : returns)
+    {
+      if (measure(episodeReturn))
+      {
+        done = true;
+        break;
+      }
+    }
+    returns.clear();
+
+    if (done || !canUpdate())
+      continue;
+
+    TrainAgent();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      learnerUpdates++;
+    }
+    learnerProgress.notify_all();
+
+    if (learnerUpdates % publishInterval == 0)
+    {
+      std::lock_guard<std::mutex> lock(publishMutex);
+      publishedParameters = learningNetwork.Parameters();
+      publishedVersion++;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  learnerProgress.notify_all();
+
+  for (std::thread& actor : actors)
+    actor.join();
+
+  elapsedTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - startTime).count();
+  for (size_t i = 0; i < numActors; ++i)
+    actorWaitTime += waitTimes[i];
+}
+
 } // namespace rl
 } // namespace mlpack
 
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RL_PRIORITIZED_REPLAY_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 #include "sumtree.hpp"
 
 namespace mlpack {
@@ -125,17 +126,31 @@ class PrioritizedReplay
    */
   arma::ucolvec SampleProportional()
   {
-    arma::ucolvec idxes(batchSize);
-    double totalSum = idxSum.Sum(0, (full ? capacity : position));
-    double sumPerRange = totalSum / batchSize;
-    for (size_t bt = 0; bt < batchSize; bt++)
-    {
-      const double mass = arma::randu() * sumPerRange + bt * sumPerRange;
-      idxes(bt) = idxSum.FindPrefixSum(mass);
-    }
+    arma::ucolvec idxes;
+    SampleProportional(idxes);
     return idxes;
   }
 
+  /**
+   * Sample some experience according to their priorities into the given
+   * vector; the memory of the vector is reused if it has the right size.
+   *
+   * @param idxes The indices to be chosen.
+   */
+  void SampleProportional(arma::ucolvec& idxes)
+  {
+    const double totalSum = idxSum.Sum(0, (full ? capacity : position));
+    const double sumPerRange = totalSum / batchSize;
+
+    // Draw one mass from each of the equally sized ranges and search the tree
+    // for all of them at once.
+    masses.set_size(batchSize);
+    for (size_t bt = 0; bt < batchSize; bt++)
+      masses(bt) = math::Random() * sumPerRange + bt * sumPerRange;
+
+    idxSum.FindPrefixSums(masses, idxes);
+  }
+
   /**
    * Sample some experience according to their priorities.
    *
@@ -152,7 +167,7 @@ class PrioritizedReplay
               arma::mat& sampledNextStates,
               arma::icolvec& isTerminal)
   {
-    sampledIndices = SampleProportional();
+    SampleProportional(sampledIndices);
     BetaAnneal();
 
     sampledStates = states.cols(sampledIndices);
@@ -164,11 +179,12 @@ class PrioritizedReplay
     // Calculate the weights of sampled transitions.
 
     size_t numSample = full ? capacity : position;
-    weights = arma::rowvec(sampledIndices.n_rows);
+    const double totalSum = idxSum.Sum();
+    weights.set_size(sampledIndices.n_rows);
 
     for (size_t i = 0; i < sampledIndices.n_rows; i++)
     {
-      double p_sample = idxSum.Get(sampledIndices(i)) / idxSum.Sum();
+      double p_sample = idxSum.Get(sampledIndices(i)) / totalSum;
       weights(i) = pow(numSample * p_sample, -beta);
     }
     weights /= weights.max();
@@ -182,9 +198,9 @@ class PrioritizedReplay
    */
   void UpdatePriorities(arma::ucolvec& indices, arma::colvec& priorities)
   {
-      arma::colvec alphaPri = alpha * priorities;
+      alphaPriorities = alpha * priorities;
       maxPriority = std::max(maxPriority, arma::max(priorities));
-      idxSum.BatchUpdate(indices, alphaPri);
+      idxSum.BatchUpdate(indices, alphaPriorities);
   }
 
   /**
@@ -213,18 +229,17 @@ class PrioritizedReplay
    * @param nextActionValues Agent's next action.
    * @param gradients The model's gradients.
    */
-  void Update(arma::mat target,
-              arma::icolvec sampledActions,
-              arma::mat nextActionValues,
+  void Update(const arma::mat& target,
+              const arma::icolvec& sampledActions,
+              const arma::mat& nextActionValues,
               arma::mat& gradients)
   {
-    arma::colvec tdError(target.n_cols);
+    tdError.set_size(target.n_cols);
     for (size_t i = 0; i < target.n_cols; i ++)
     {
-      tdError(i) = nextActionValues(sampledActions(i), i) -
-          target(sampledActions(i), i);
+      tdError(i) = std::abs(nextActionValues(sampledActions(i), i) -
+          target(sampledActions(i), i));
     }
-    tdError = arma::abs(tdError);
     UpdatePriorities(sampledIndices, tdError);
 
     // Update the gradient
@@ -284,6 +299,15 @@ class PrioritizedReplay
 
   //! Locally-stored the weights of sampled transitions.
   arma::rowvec weights;
+
+  //! Locally-stored masses drawn for the sampled transitions.
+  arma::colvec masses;
+
+  //! Locally-stored absolute TD errors of the sampled transitions.
+  arma::colvec tdError;
+
+  //! Locally-stored scaled priorities of the sampled transitions.
+  arma::colvec alphaPriorities;
 };
 
 } // namespace rl
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RL_REPLAY_RANDOM_REPLAY_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace rl {
@@ -121,9 +122,13 @@ class RandomReplay
               arma::mat& sampledNextStates,
               arma::icolvec& isTerminal)
   {
+    // Draw the indices into the stored vector; together with the output
+    // matrices of the caller, whose memory is reused when the size matches,
+    // no memory is allocated in the steady state.
     size_t upperBound = full ? capacity : position;
-    arma::uvec sampledIndices = arma::randi<arma::uvec>(
-        batchSize, arma::distr_param(0, upperBound - 1));
+    sampledIndices.set_size(batchSize);
+    for (size_t i = 0; i < batchSize; ++i)
+      sampledIndices[i] = math::RandInt(upperBound);
 
     sampledStates = states.cols(sampledIndices);
     sampledActions = actions.elem(sampledIndices);
@@ -150,9 +155,9 @@ class RandomReplay
    * @param nextActionValues Agent's next action
    * @param gradients The model's gradients
    */
-  void Update(arma::mat /* target */,
-              arma::icolvec /* sampledActions */,
-              arma::mat /* nextActionValues */,
+  void Update(const arma::mat& /* target */,
+              const arma::icolvec& /* sampledActions */,
+              const arma::mat& /* nextActionValues */,
               arma::mat& /* gradients */)
   {
     /* Do nothing for random replay. */
@@ -185,6 +190,9 @@ class RandomReplay
 
   //! Locally-stored indicator that whether the memory is full or not
   bool full;
+
+  //! Locally-stored indices of the sampled transitions.
+  arma::uvec sampledIndices;
 };
 
 } // namespace rl
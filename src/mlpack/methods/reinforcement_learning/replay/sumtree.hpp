@@ -74,14 +74,29 @@ class SumTree
    */
   void BatchUpdate(const arma::ucolvec& indices, const arma::Col<T>& data)
   {
+    nodes.clear();
     for (size_t i = 0; i < indices.n_rows; i++)
     {
       element[indices[i] + capacity] = data[i];
+      nodes.push_back((indices[i] + capacity) / 2);
     }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
+
+    // Only refresh the ancestors of the changed leaves, bottom-up.  A parent
+    // always has a smaller index than its children, so handling the nodes in
+    // descending order refreshes the children first.
+    while (!nodes.empty())
     {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      std::sort(nodes.begin(), nodes.end(), std::greater<size_t>());
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+      if (nodes.back() == 0)
+        nodes.pop_back();
+
+      for (size_t i = 0; i < nodes.size(); ++i)
+      {
+        element[nodes[i]] = element[2 * nodes[i]] +
+            element[2 * nodes[i] + 1];
+        nodes[i] /= 2;
+      }
     }
   }
 
@@ -178,12 +193,58 @@ class SumTree
     return idx - capacity;
   }
 
+  /**
+   * Find the prefix sum index of every given mass at once; see
+   * FindPrefixSum().  All searches descend the tree together level by level,
+   * so the upper levels are shared in cache by the whole batch.
+   *
+   * @param masses The upper bounds of segment array sums.
+   * @param indices The found array indices, one per mass.
+   */
+  void FindPrefixSums(const arma::Col<T>& masses, arma::ucolvec& indices)
+  {
+    remaining = masses;
+    indices.ones(masses.n_elem);
+
+    bool descending = (capacity > 1);
+    while (descending)
+    {
+      descending = false;
+      for (size_t i = 0; i < indices.n_elem; ++i)
+      {
+        arma::uword& idx = indices[i];
+        if (idx >= capacity)
+          continue;
+
+        if (element[2 * idx] > remaining[i])
+        {
+          idx = 2 * idx;
+        }
+        else
+        {
+          remaining[i] -= element[2 * idx];
+          idx = 2 * idx + 1;
+        }
+
+        descending |= (idx < capacity);
+      }
+    }
+
+    indices -= capacity;
+  }
+
  private:
   //! The capacity of the data array.
   size_t capacity;
 
   //! Double size of capacity, maintain the segment sum of data.
   std::vector<T> element;
+
+  //! Locally-stored nodes to refresh during a batch update.
+  std::vector<size_t> nodes;
+
+  //! Locally-stored remaining masses during a batched prefix sum search.
+  arma::Col<T> remaining;
 };
 
 } // namespace rl
@@ -25,7 +25,9 @@ class TrainingConfig
       stepLimit(0),
       explorationSteps(1),
       gradientLimit(40),
-      doubleQLearning(false)
+      doubleQLearning(false),
+      actorLead(1000),
+      publishInterval(10)
   { /* Nothing to do here. */ }
 
   TrainingConfig(
@@ -46,7 +48,9 @@ class TrainingConfig
       stepSize(stepSize),
       discount(discount),
       gradientLimit(gradientLimit),
-      doubleQLearning(doubleQLearning)
+      doubleQLearning(doubleQLearning),
+      actorLead(1000),
+      publishInterval(10)
   { /* Nothing to do here. */ }
 
   //! Get the amount of workers.
@@ -98,10 +102,21 @@ class TrainingConfig
   //! Modify the indicator of double q-learning.
   bool& DoubleQLearning() { return doubleQLearning; }
 
+  //! Get the number of steps the actors may run ahead of the learner.
+  size_t ActorLead() const { return actorLead; }
+  //! Modify the number of steps the actors may run ahead of the learner.
+  size_t& ActorLead() { return actorLead; }
+
+  //! Get the number of learner updates between weight publications.
+  size_t PublishInterval() const { return publishInterval; }
+  //! Modify the number of learner updates between weight publications.
+  size_t& PublishInterval() { return publishInterval; }
+
  private:
   /**
    * Locally-stored number of workers.
-   * This is valid only for async RL agent.
+   * This is valid for async RL agent and for the actors of the actor-learner
+   * q-learning agent.
    */
   size_t numWorkers;
 
@@ -109,7 +124,8 @@ class TrainingConfig
    * Locally-stored update interval.
    * Update interval is similar to batch size,
    * however the update is done one by one.
-   * This is valid only for async RL agent.
+   * For the actor-learner q-learning agent this is the number of environment
+   * steps per learner update.
    */
   size_t updateInterval;
 
@@ -155,6 +171,21 @@ class TrainingConfig
    * This is valid only for q-learning agent.
    */
   bool doubleQLearning;
+
+  /**
+   * Locally-stored number of environment steps the actors may collect beyond
+   * what the learner has consumed.  Actors block once they are this far
+   * ahead, which bounds the amount of unconsumed experience.
+   * This is valid only for actor-learner q-learning agent.
+   */
+  size_t actorLead;
+
+  /**
+   * Locally-stored number of learner updates between two publications of the
+   * learning network weights to the actors.
+   * This is valid only for actor-learner q-learning agent.
+   */
+  size_t publishInterval;
 };
 
 } // namespace rl
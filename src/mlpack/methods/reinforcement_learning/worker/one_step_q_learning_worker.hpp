@@ -15,6 +15,8 @@
 
 #include <mlpack/methods/reinforcement_learning/training_config.hpp>
 
+#include <atomic>
+
 namespace mlpack {
 namespace rl {
 
@@ -60,7 +62,8 @@ class OneStepQLearningWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetEpoch(0)
   { Reset(); }
 
   /**
@@ -81,8 +84,13 @@ class OneStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      targetNetwork(other.targetNetwork),
+      targetEpoch(other.targetEpoch),
       state(other.state)
   {
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
+
     #if ENS_VERSION_MAJOR >= 2
     updatePolicy = new typename UpdaterType::template
         Policy<arma::mat, arma::mat>(updater,
@@ -111,8 +119,13 @@ class OneStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      targetNetwork(std::move(other.targetNetwork)),
+      targetEpoch(other.targetEpoch),
       state(std::move(other.state))
   {
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
+
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
 
@@ -146,6 +159,10 @@ class OneStepQLearningWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    targetNetwork = other.targetNetwork;
+    targetEpoch = other.targetEpoch;
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
     state = other.state;
 
     #if ENS_VERSION_MAJOR >= 2
@@ -183,6 +200,10 @@ class OneStepQLearningWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    targetNetwork = std::move(other.targetNetwork);
+    targetEpoch = other.targetEpoch;
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
     state = std::move(other.state);
 
     #if ENS_VERSION_MAJOR >= 2
@@ -225,15 +246,19 @@ class OneStepQLearningWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build the local network and the local target network.  Both are
+    // synchronized later on by copying the parameters in place.
     network = learningNetwork;
+    network.LinkParameters();
+    targetNetwork = network;
+    targetNetwork.LinkParameters();
+    targetEpoch = 0;
   }
 
   /**
    * The agent will execute one step.
    *
    * @param learningNetwork The shared learning network.
-   * @param targetNetwork The shared target network.
    * @param totalSteps The shared counter for total steps.
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
@@ -241,8 +266,7 @@ class OneStepQLearningWorker
    * @return Indicate whether current episode ends after this step.
    */
   bool Step(NetworkType& learningNetwork,
-            NetworkType& targetNetwork,
-            size_t& totalSteps,
+            std::atomic<size_t>& totalSteps,
             PolicyType& policy,
             double& totalReward)
   {
@@ -265,15 +289,14 @@ class OneStepQLearningWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        network.Parameters() = learningNetwork.Parameters();
         return true;
       }
       state = nextState;
       return false;
     }
 
-    #pragma omp atomic
-    totalSteps++;
+    totalSteps.fetch_add(1);
 
     pending[pendingIndex] = std::make_tuple(state, action, reward, nextState);
     pendingIndex++;
@@ -289,11 +312,7 @@ class OneStepQLearningWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        targetNetwork.Predict(std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = actionValue.max();
         if (terminal && i == pending.size() - 1)
           targetActionValue = 0;
@@ -328,17 +347,22 @@ class OneStepQLearningWorker
           config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
+      // Sync the local network with the global network.  The shared
+      // parameters are read without locking (Hogwild!); a concurrent update
+      // may be partially visible, which the algorithm tolerates.
+      network.Parameters() = learningNetwork.Parameters();
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
-    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+    // Refresh the local target network once the shared step counter enters a
+    // new synchronization interval.
+    const size_t epoch = totalSteps.load() /
+        config.TargetNetworkSyncInterval();
+    if (epoch != targetEpoch)
     {
-      #pragma omp critical
-      { targetNetwork = learningNetwork; }
+      targetNetwork.Parameters() = learningNetwork.Parameters();
+      targetEpoch = epoch;
     }
 
     policy.Anneal();
@@ -395,6 +419,12 @@ class OneStepQLearningWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local target network of the worker.
+  NetworkType targetNetwork;
+
+  //! Synchronization interval the local target network belongs to.
+  size_t targetEpoch;
+
   //! Current state of the agent.
   StateType state;
 };
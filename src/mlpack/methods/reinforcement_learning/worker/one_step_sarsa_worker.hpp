@@ -15,6 +15,8 @@
 
 #include <mlpack/methods/reinforcement_learning/training_config.hpp>
 
+#include <atomic>
+
 namespace mlpack {
 namespace rl {
 
@@ -61,7 +63,8 @@ class OneStepSarsaWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetEpoch(0)
   { Reset(); }
 
   /**
@@ -82,9 +85,14 @@ class OneStepSarsaWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      targetNetwork(other.targetNetwork),
+      targetEpoch(other.targetEpoch),
       state(other.state),
       action(other.action)
   {
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
+
     Reset();
 
     #if ENS_VERSION_MAJOR >= 2
@@ -113,9 +121,14 @@ class OneStepSarsaWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      targetNetwork(std::move(other.targetNetwork)),
+      targetEpoch(other.targetEpoch),
       state(std::move(other.state)),
       action(std::move(other.action))
   {
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
+
     #if ENS_VERSION_MAJOR >= 2
     other.updatePolicy = NULL;
 
@@ -149,6 +162,10 @@ class OneStepSarsaWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    targetNetwork = other.targetNetwork;
+    targetEpoch = other.targetEpoch;
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
     state = other.state;
     action = other.action;
 
@@ -187,6 +204,10 @@ class OneStepSarsaWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    targetNetwork = std::move(other.targetNetwork);
+    targetEpoch = other.targetEpoch;
+    network.LinkParameters();
+    targetNetwork.LinkParameters();
     state = std::move(other.state);
     action = std::move(other.action);
 
@@ -230,15 +251,19 @@ class OneStepSarsaWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build the local network and the local target network.  Both are
+    // synchronized later on by copying the parameters in place.
     network = learningNetwork;
+    network.LinkParameters();
+    targetNetwork = network;
+    targetNetwork.LinkParameters();
+    targetEpoch = 0;
   }
 
   /**
    * The agent will execute one step.
    *
    * @param learningNetwork The shared learning network.
-   * @param targetNetwork The shared target network.
    * @param totalSteps The shared counter for total steps.
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
@@ -246,8 +271,7 @@ class OneStepSarsaWorker
    * @return Indicate whether current episode ends after this step.
    */
   bool Step(NetworkType& learningNetwork,
-            NetworkType& targetNetwork,
-            size_t& totalSteps,
+            std::atomic<size_t>& totalSteps,
             PolicyType& policy,
             double& totalReward)
   {
@@ -277,7 +301,7 @@ class OneStepSarsaWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        network.Parameters() = learningNetwork.Parameters();
         return true;
       }
       state = nextState;
@@ -285,8 +309,7 @@ class OneStepSarsaWorker
       return false;
     }
 
-    #pragma omp atomic
-    totalSteps++;
+    totalSteps.fetch_add(1);
 
     pending[pendingIndex++] =
         std::make_tuple(state, action, reward, nextState, nextAction);
@@ -302,11 +325,7 @@ class OneStepSarsaWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        targetNetwork.Predict(std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = 0;
         if (!(terminal && i == pending.size() - 1))
           targetActionValue = actionValue[std::get<4>(transition)];
@@ -341,17 +360,22 @@ class OneStepSarsaWorker
           config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
+      // Sync the local network with the global network.  The shared
+      // parameters are read without locking (Hogwild!); a concurrent update
+      // may be partially visible, which the algorithm tolerates.
+      network.Parameters() = learningNetwork.Parameters();
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
-    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+    // Refresh the local target network once the shared step counter enters a
+    // new synchronization interval.
+    const size_t epoch = totalSteps.load() /
+        config.TargetNetworkSyncInterval();
+    if (epoch != targetEpoch)
     {
-      #pragma omp critical
-      { targetNetwork = learningNetwork; }
+      targetNetwork.Parameters() = learningNetwork.Parameters();
+      targetEpoch = epoch;
     }
 
     policy.Anneal();
@@ -410,6 +434,12 @@ class OneStepSarsaWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local target network of the worker.
+  NetworkType targetNetwork;
+
+  //! Synchronization interval the local target network belongs to.
+  size_t targetEpoch;
+
   //! Current state of the agent.
   StateType state;
 
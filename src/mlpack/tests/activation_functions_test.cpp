@@ -804,6 +804,25 @@ BOOST_AUTO_TEST_CASE(MishFunctionTest)
                                        desiredDerivatives);
 }
 
+/**
+ * Test that the Mish function and its derivative stay finite for inputs whose
+ * exponential overflows.
+ */
+BOOST_AUTO_TEST_CASE(MishFunctionLargeInputTest)
+{
+  const arma::colvec input("-800 -400 400 800");
+  arma::colvec activations, derivatives;
+  MishFunction::Fn(input, activations);
+  MishFunction::Deriv(input, derivatives);
+
+  BOOST_REQUIRE(activations.is_finite());
+  BOOST_REQUIRE(derivatives.is_finite());
+  BOOST_REQUIRE_SMALL(activations(0), 1e-10);
+  BOOST_REQUIRE_CLOSE(activations(3), 800.0, 1e-5);
+  BOOST_REQUIRE_SMALL(derivatives(1), 1e-10);
+  BOOST_REQUIRE_CLOSE(derivatives(2), 1.0, 1e-5);
+}
+
 /**
  * Basic test of the LiSHT function.
  */
@@ -427,6 +427,32 @@ BOOST_AUTO_TEST_CASE(GradientLinearLayerTest)
   BOOST_REQUIRE_LE(CheckGradient(function), 1e-4);
 }
 
+/**
+ * Test that the Linear layer gives the same output and gradient for a sparse
+ * input as for the dense version of the input.
+ */
+BOOST_AUTO_TEST_CASE(SparseLinearLayerTest)
+{
+  Linear<> module(100, 7);
+  module.Parameters().randu();
+  module.Reset();
+
+  arma::sp_mat sparseInput = arma::sprandu<arma::sp_mat>(100, 5, 0.05);
+  arma::mat input(sparseInput);
+  arma::mat error = arma::randu<arma::mat>(7, 5);
+
+  arma::mat output, sparseOutput;
+  module.Forward(input, output);
+  module.Forward(sparseInput, sparseOutput);
+  CheckMatrices(output, sparseOutput);
+
+  arma::mat gradient(module.Parameters().n_elem, 1);
+  arma::mat sparseGradient(module.Parameters().n_elem, 1);
+  module.Gradient(input, error, gradient);
+  module.Gradient(sparseInput, error, sparseGradient);
+  CheckMatrices(gradient, sparseGradient);
+}
+
 /**
  * Simple linear no bias module test.
  */
@@ -447,6 +473,102 @@ BOOST_AUTO_TEST_CASE(SimpleLinearNoBiasLayerTest)
   BOOST_REQUIRE_EQUAL(arma::accu(delta), 0);
 }
 
+/**
+ * Make sure that the output of the QuantizedLinear layer is close to the
+ * output of the Linear layer it was created from.
+ */
+BOOST_AUTO_TEST_CASE(QuantizedLinearLayerTest)
+{
+  const size_t inSize = 20;
+  const size_t outSize = 10;
+
+  arma::mat output, quantizedOutput, input, delta;
+  Linear<> module(inSize, outSize);
+  module.Parameters().randn();
+  module.Reset();
+
+  const arma::mat weight(module.Parameters().memptr(), outSize, inSize);
+  const arma::mat bias(module.Parameters().memptr() + weight.n_elem, outSize,
+      1);
+
+  // The input is in [0, 1], so an input scale of 1 / 127 covers the range.
+  QuantizedLinear<> quantizedModule(weight, bias, 1.0 / 127.0);
+  BOOST_REQUIRE_EQUAL(quantizedModule.InputSize(), inSize);
+  BOOST_REQUIRE_EQUAL(quantizedModule.OutputSize(), outSize);
+
+  input = arma::randu(inSize, 8);
+  module.Forward(input, output);
+  quantizedModule.Forward(input, quantizedOutput);
+
+  // Each weight and input is off by at most half of its quantization step.
+  const double maxWeight = arma::max(arma::max(arma::abs(weight)));
+  const double tolerance = inSize * 1.01 * maxWeight / 127.0;
+  BOOST_REQUIRE_LE(arma::max(arma::max(arma::abs(output - quantizedOutput))),
+      tolerance);
+
+  // The dequantized weights are off by at most half of the quantization step.
+  BOOST_REQUIRE_LE(arma::max(arma::max(arma::abs(weight -
+      quantizedModule.Weight()))), maxWeight / 254.0 + 1e-10);
+
+  // Test the Backward function.
+  module.Backward(input, output, delta);
+  arma::mat quantizedDelta;
+  quantizedModule.Backward(input, output, quantizedDelta);
+  BOOST_REQUIRE_EQUAL(quantizedDelta.n_rows, inSize);
+  BOOST_REQUIRE_EQUAL(quantizedDelta.n_cols, input.n_cols);
+}
+
+/**
+ * Make sure that the output of the QuantizedConvolution layer is close to the
+ * output of the Convolution layer it was created from.
+ */
+BOOST_AUTO_TEST_CASE(QuantizedConvolutionLayerTest)
+{
+  const size_t inSize = 2;
+  const size_t outSize = 3;
+  const size_t filterSize = 3 * 3 * inSize;
+
+  arma::mat output, quantizedOutput, input, delta, quantizedDelta;
+  Convolution<> module(inSize, outSize, 3, 3, 2, 2, 1, 1, 7, 7);
+  module.Parameters().randn();
+  module.Reset();
+
+  const arma::mat weight(module.Parameters().memptr(), filterSize, outSize);
+  const arma::mat bias(module.Parameters().memptr() + weight.n_elem, outSize,
+      1);
+
+  // The input is in [0, 1], so an input scale of 1 / 127 covers the range.
+  QuantizedConvolution<> quantizedModule(weight, bias, inSize, 3, 3, 2, 2,
+      std::make_tuple(1, 1), std::make_tuple(1, 1), 7, 7, 1.0 / 127.0);
+
+  input = arma::randu(7 * 7 * inSize, 4);
+  module.Forward(input, output);
+  quantizedModule.Forward(input, quantizedOutput);
+  BOOST_REQUIRE_EQUAL(quantizedModule.OutputWidth(), module.OutputWidth());
+  BOOST_REQUIRE_EQUAL(quantizedModule.OutputHeight(), module.OutputHeight());
+  BOOST_REQUIRE_EQUAL(quantizedOutput.n_rows, output.n_rows);
+  BOOST_REQUIRE_EQUAL(quantizedOutput.n_cols, output.n_cols);
+
+  // Each weight and input is off by at most half of its quantization step.
+  const double maxWeight = arma::max(arma::max(arma::abs(weight)));
+  const double tolerance = filterSize * 1.01 * maxWeight / 127.0;
+  BOOST_REQUIRE_LE(arma::max(arma::max(arma::abs(output - quantizedOutput))),
+      tolerance);
+
+  // The backward pass uses the dequantized filters, which are off by at most
+  // half of the quantization step, and every input takes the error of at most
+  // 3 * 3 positions of every filter.
+  module.Backward(input, output, delta);
+  quantizedModule.Backward(input, output, quantizedDelta);
+  BOOST_REQUIRE_EQUAL(quantizedDelta.n_rows, input.n_rows);
+  BOOST_REQUIRE_EQUAL(quantizedDelta.n_cols, input.n_cols);
+
+  const double deltaTolerance = outSize * 3 * 3 * arma::max(arma::max(
+      arma::abs(output))) * (maxWeight / 254.0 + 1e-10);
+  BOOST_REQUIRE_LE(arma::max(arma::max(arma::abs(delta - quantizedDelta))),
+      deltaTolerance);
+}
+
 /**
  * Simple padding layer test.
  */
@@ -840,6 +962,51 @@ BOOST_AUTO_TEST_CASE(GradientLSTMLayerTest)
   BOOST_REQUIRE_LE(CheckGradient(function), 1e-4);
 }
 
+/**
+ * LSTM layer numerical gradient test with a batch of multiple sequences, to
+ * check the stacked gate computation of all columns at once.
+ */
+BOOST_AUTO_TEST_CASE(GradientBatchLSTMLayerTest)
+{
+  // LSTM function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction()
+    {
+      input = arma::randu(1, 3, 5);
+      target.ones(1, 3, 5);
+      const size_t rho = 5;
+
+      model = new RNN<NegativeLogLikelihood<> >(rho);
+      model->Predictors() = input;
+      model->Responses() = target;
+      model->Add<IdentityLayer<> >();
+      model->Add<Linear<> >(1, 10);
+      model->Add<LSTM<> >(10, 3, rho);
+      model->Add<LogSoftMax<> >();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 3);
+      model->Gradient(model->Parameters(), 0, gradient, 3);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    RNN<NegativeLogLikelihood<> >* model;
+    arma::cube input, target;
+  } function;
+
+  BOOST_REQUIRE_LE(CheckGradient(function), 1e-4);
+}
+
 /**
  * Test the FastLSTM layer with a user defined rho parameter and without.
  */
@@ -1478,6 +1645,34 @@ BOOST_AUTO_TEST_CASE(SimpleLookupLayerTest)
   BOOST_REQUIRE_CLOSE(arma::accu(gradient), arma::accu(error), 1e-3);
 }
 
+/**
+ * Test that the Lookup gradient accumulates repeated indices, and that the
+ * columns of the previous pass are cleared when the gradient is reused.
+ */
+BOOST_AUTO_TEST_CASE(LookupLayerSparseGradientTest)
+{
+  Lookup<> module(10, 4);
+  module.Parameters().randu();
+
+  arma::mat input("2; 5; 2");
+  arma::mat error = arma::randu<arma::mat>(4, 3);
+  arma::mat gradient;
+  module.Gradient(input, error, gradient);
+
+  arma::mat expected = arma::zeros<arma::mat>(4, 10);
+  expected.col(1) = error.col(0) + error.col(2);
+  expected.col(4) = error.col(1);
+  CheckMatrices(gradient, expected);
+
+  input = arma::mat("7");
+  error = arma::randu<arma::mat>(4, 1);
+  module.Gradient(input, error, gradient);
+
+  expected.zeros();
+  expected.col(6) = error.col(0);
+  CheckMatrices(gradient, expected);
+}
+
 /**
  * Simple LogSoftMax module test.
  */
@@ -1588,6 +1783,31 @@ BOOST_AUTO_TEST_CASE(BatchNormTest)
   CheckMatrices(output, result, 1e-1);
 }
 
+/**
+ * Test that the BatchNorm running statistics over several batches match the
+ * statistics of the concatenated data.
+ */
+BOOST_AUTO_TEST_CASE(BatchNormRunningStatisticsTest)
+{
+  arma::mat input = arma::randn(5, 23);
+  arma::mat output;
+
+  BatchNorm<> model(input.n_rows);
+  model.Reset();
+  model.Forward(arma::mat(input.cols(0, 9)), output);
+  model.Forward(arma::mat(input.cols(10, 10)), output);
+  model.Forward(arma::mat(input.cols(11, 22)), output);
+
+  CheckMatrices(model.TrainingMean(), arma::mat(arma::mean(input, 1)), 1e-6);
+  CheckMatrices(model.TrainingVariance(), arma::mat(arma::var(input, 1, 1)),
+      1e-6);
+
+  // The normalized output has zero mean and unit variance per feature.
+  model.Forward(input, output);
+  CheckMatrices(arma::mat(arma::mean(output, 1)), arma::zeros(5, 1), 1e-8);
+  CheckMatrices(arma::mat(arma::var(output, 1, 1)), arma::ones(5, 1), 1e-4);
+}
+
 /**
  * BatchNorm layer numerical gradient test.
  */
@@ -2931,6 +3151,147 @@ BOOST_AUTO_TEST_CASE(ConvolutionLayerPaddingTest)
   module2.Backward(input, output, delta);
 }
 
+/**
+ * Make sure that the batched im2col implementation of the Convolution layer
+ * produces the same results as the slice-wise naive implementation.
+ */
+BOOST_AUTO_TEST_CASE(Im2ColConvolutionLayerTest)
+{
+  arma::mat input = arma::randu<arma::mat>(2 * 7 * 7, 3);
+
+  Convolution<> im2colModule(2, 3, 3, 3, 1, 1, 1, 1, 7, 7);
+  Convolution<NaiveConvolution<ValidConvolution>,
+              NaiveConvolution<FullConvolution>,
+              NaiveConvolution<ValidConvolution> > naiveModule(2, 3, 3, 3, 1,
+      1, 1, 1, 7, 7);
+
+  im2colModule.Parameters() = arma::randn<arma::mat>(2 * 3 * 3 * 3 + 3, 1);
+  naiveModule.Parameters() = im2colModule.Parameters();
+  im2colModule.Reset();
+  naiveModule.Reset();
+
+  // Test the Forward function.
+  arma::mat im2colOutput, naiveOutput;
+  im2colModule.Forward(input, im2colOutput);
+  naiveModule.Forward(input, naiveOutput);
+  CheckMatrices(im2colOutput, naiveOutput, 1e-6);
+
+  // Test the Backward function.
+  arma::mat error = arma::randu<arma::mat>(naiveOutput.n_rows,
+      naiveOutput.n_cols);
+  arma::mat im2colDelta, naiveDelta;
+  im2colModule.Backward(input, error, im2colDelta);
+  naiveModule.Backward(input, error, naiveDelta);
+  CheckMatrices(im2colDelta, naiveDelta, 1e-6);
+
+  // Test the Gradient function.
+  arma::mat im2colGradient, naiveGradient;
+  im2colModule.Gradient(input, error, im2colGradient);
+  naiveModule.Gradient(input, error, naiveGradient);
+  CheckMatrices(im2colGradient, naiveGradient, 1e-6);
+
+  // As in a recurrent network, the gradient may be asked for an input other
+  // than the one of the last forward pass.
+  arma::mat nextInput = arma::randu<arma::mat>(2 * 7 * 7, 3);
+  im2colModule.Forward(nextInput, im2colOutput);
+  naiveModule.Forward(nextInput, naiveOutput);
+  im2colModule.Gradient(input, error, im2colGradient);
+  naiveModule.Gradient(input, error, naiveGradient);
+  CheckMatrices(im2colGradient, naiveGradient, 1e-6);
+}
+
+/**
+ * Make sure that the batched im2col implementation of the TransposedConvolution
+ * layer produces the same results as the slice-wise naive implementation.
+ */
+BOOST_AUTO_TEST_CASE(Im2ColTransposedConvolutionLayerTest)
+{
+  typedef TransposedConvolution<NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<ValidConvolution> > NaiveTransposedConvolution;
+
+  // Without padding and stride, and with both (which adds a row and a column
+  // of zeros to the output).
+  for (size_t stride = 1; stride <= 2; ++stride)
+  {
+    const size_t pad = stride - 1;
+    const size_t inputSize = (stride == 1) ? 4 : 3;
+    TransposedConvolution<> im2colModule(2, 3, 3, 3, stride, stride, pad, pad,
+        inputSize, inputSize, 6, 6);
+    NaiveTransposedConvolution naiveModule(2, 3, 3, 3, stride, stride, pad,
+        pad, inputSize, inputSize, 6, 6);
+
+    arma::mat input = arma::randu<arma::mat>(2 * inputSize * inputSize, 3);
+
+    im2colModule.Parameters() = arma::randn<arma::mat>(2 * 3 * 3 * 3 + 3, 1);
+    naiveModule.Parameters() = im2colModule.Parameters();
+    im2colModule.Reset();
+    naiveModule.Reset();
+
+    // Test the Forward function.
+    arma::mat im2colOutput, naiveOutput;
+    im2colModule.Forward(input, im2colOutput);
+    naiveModule.Forward(input, naiveOutput);
+    CheckMatrices(im2colOutput, naiveOutput, 1e-6);
+
+    // Test the Backward function.
+    arma::mat error = arma::randu<arma::mat>(naiveOutput.n_rows,
+        naiveOutput.n_cols);
+    arma::mat im2colDelta, naiveDelta;
+    im2colModule.Backward(input, error, im2colDelta);
+    naiveModule.Backward(input, error, naiveDelta);
+    CheckMatrices(im2colDelta, naiveDelta, 1e-6);
+
+    // Test the Gradient function.
+    arma::mat im2colGradient, naiveGradient;
+    im2colModule.Gradient(input, error, im2colGradient);
+    naiveModule.Gradient(input, error, naiveGradient);
+    CheckMatrices(im2colGradient, naiveGradient, 1e-6);
+  }
+}
+
+/**
+ * Convolution layer numerical gradient test with stride and padding.
+ */
+BOOST_AUTO_TEST_CASE(GradientStridedConvolutionLayerTest)
+{
+  // Add function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction()
+    {
+      input = arma::randu<arma::mat>(2 * 7 * 7, 1);
+      target = arma::mat("1");
+
+      model = new FFN<NegativeLogLikelihood<>, RandomInitialization>();
+      model->Predictors() = input;
+      model->Responses() = target;
+      model->Add<IdentityLayer<> >();
+      model->Add<Convolution<> >(2, 3, 3, 3, 2, 2, 1, 1, 7, 7);
+      model->Add<LogSoftMax<> >();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 1);
+      model->Gradient(model->Parameters(), 0, gradient, 1);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood<>, RandomInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  BOOST_REQUIRE_LE(CheckGradient(function), 1e-4);
+}
+
 /**
  * Test that the padding options in Transposed Convolution layer.
  */
@@ -3117,4 +3478,72 @@ BOOST_AUTO_TEST_CASE(MaxPoolingTestCase)
   BOOST_REQUIRE_EQUAL(output.n_elem, 4);
   BOOST_REQUIRE_EQUAL(output.n_cols, 1);
 }
+
+/**
+ * Pool a batch of multi-channel inputs with the given layer and make sure
+ * every column matches the result of pooling that sample on its own.
+ */
+template<typename PoolingType>
+void CheckBatchPooling(PoolingType& batchModule, PoolingType& singleModule)
+{
+  arma::mat input = arma::randu(6 * 5 * 3, 4);
+  arma::mat output, gy, g;
+
+  batchModule.InputWidth() = singleModule.InputWidth() = 6;
+  batchModule.InputHeight() = singleModule.InputHeight() = 5;
+
+  batchModule.Forward(input, output);
+  gy = arma::randu(output.n_rows, output.n_cols);
+  batchModule.Backward(input, gy, g);
+
+  BOOST_REQUIRE_EQUAL(g.n_rows, input.n_rows);
+  BOOST_REQUIRE_EQUAL(g.n_cols, input.n_cols);
+
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    arma::mat singleInput = input.col(i);
+    arma::mat singleOutput, singleGy, singleG;
+    singleModule.Forward(singleInput, singleOutput);
+    CheckMatrices(arma::mat(output.col(i)), singleOutput, 1e-10);
+
+    singleGy = gy.col(i);
+    singleModule.Backward(singleInput, singleGy, singleG);
+    CheckMatrices(arma::mat(g.col(i)), singleG, 1e-10);
+  }
+}
+
+/**
+ * Test that the pooling layers handle batches of multi-channel inputs
+ * the same way as single samples.
+ */
+BOOST_AUTO_TEST_CASE(BatchPoolingTest)
+{
+  MaxPooling<> maxBatch(2, 2, 2, 2), maxSingle(2, 2, 2, 2);
+  CheckBatchPooling(maxBatch, maxSingle);
+
+  MaxPooling<> maxOverlapBatch(3, 2, 1, 1), maxOverlapSingle(3, 2, 1, 1);
+  CheckBatchPooling(maxOverlapBatch, maxOverlapSingle);
+
+  MeanPooling<> meanBatch(2, 2, 2, 2), meanSingle(2, 2, 2, 2);
+  CheckBatchPooling(meanBatch, meanSingle);
+
+  // Check the max pooling result against a direct computation.
+  arma::mat input = arma::randu(4 * 4, 1);
+  arma::mat output;
+  MaxPooling<> module(2, 2, 2, 2);
+  module.InputWidth() = 4;
+  module.InputHeight() = 4;
+  module.Forward(input, output);
+
+  arma::mat image(input.memptr(), 4, 4, false, true);
+  for (size_t j = 0; j < 2; ++j)
+  {
+    for (size_t i = 0; i < 2; ++i)
+    {
+      const arma::mat window = image.submat(2 * i, 2 * j, 2 * i + 1,
+          2 * j + 1);
+      BOOST_REQUIRE_CLOSE(output(i + 2 * j), window.max(), 1e-10);
+    }
+  }
+}
 BOOST_AUTO_TEST_SUITE_END();
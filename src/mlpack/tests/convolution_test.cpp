@@ -16,6 +16,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -149,6 +151,14 @@ BOOST_AUTO_TEST_CASE(ValidConvolution2DTest)
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col lowering.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -186,6 +196,14 @@ BOOST_AUTO_TEST_CASE(FullConvolution2DTest)
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col lowering.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -231,6 +249,10 @@ BOOST_AUTO_TEST_CASE(ValidConvolution3DTest)
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -280,6 +302,10 @@ BOOST_AUTO_TEST_CASE(FullConvolution3DTest)
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -322,6 +348,10 @@ BOOST_AUTO_TEST_CASE(ValidConvolutionBatchTest)
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -368,6 +398,119 @@ BOOST_AUTO_TEST_CASE(FullConvolutionBatchTest)
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+}
+
+/**
+ * Make sure that the im2col convolution matches the naive convolution if the
+ * stride and the dilation are larger than one.
+ */
+BOOST_AUTO_TEST_CASE(Im2ColStrideDilationConvolutionTest)
+{
+  arma::mat input = arma::randu<arma::mat>(11, 11);
+  arma::mat filter = arma::randu<arma::mat>(3, 3);
+
+  for (size_t stride = 1; stride <= 3; ++stride)
+  {
+    for (size_t dilation = 1; dilation <= 2; ++dilation)
+    {
+      arma::mat naiveOutput, im2colOutput;
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter,
+          naiveOutput, stride, stride, dilation, dilation);
+      Im2ColConvolution<ValidConvolution>::Convolution(input, filter,
+          im2colOutput, stride, stride, dilation, dilation);
+
+      CheckMatrices(naiveOutput, im2colOutput, 1e-6);
+
+      NaiveConvolution<FullConvolution>::Convolution(input, filter,
+          naiveOutput, stride, stride, dilation, dilation);
+      Im2ColConvolution<FullConvolution>::Convolution(input, filter,
+          im2colOutput, stride, stride, dilation, dilation);
+
+      CheckMatrices(naiveOutput, im2colOutput, 1e-6);
+    }
+  }
+}
+
+/**
+ * Test that the Winograd convolution matches the naive convolution for even
+ * and odd output sizes, and falls back for unsupported shapes.
+ */
+BOOST_AUTO_TEST_CASE(WinogradConvolutionTest)
+{
+  for (size_t rows = 3; rows <= 8; ++rows)
+  {
+    for (size_t cols = 3; cols <= 8; ++cols)
+    {
+      arma::mat input = arma::randu<arma::mat>(rows, cols);
+      arma::mat filter = arma::randu<arma::mat>(3, 3);
+
+      arma::mat naiveOutput, winogradOutput;
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter,
+          naiveOutput);
+      WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+          winogradOutput);
+      CheckMatrices(naiveOutput, winogradOutput, 1e-6);
+
+      NaiveConvolution<FullConvolution>::Convolution(input, filter,
+          naiveOutput);
+      WinogradConvolution<FullConvolution>::Convolution(input, filter,
+          winogradOutput);
+      CheckMatrices(naiveOutput, winogradOutput, 1e-6);
+    }
+  }
+
+  // A 5x5 filter, and a 3x3 filter with stride 2, use the fallback rule.
+  arma::mat input = arma::randu<arma::mat>(11, 11);
+  arma::mat filter = arma::randu<arma::mat>(5, 5);
+  arma::mat naiveOutput, winogradOutput;
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, naiveOutput);
+  WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+      winogradOutput);
+  CheckMatrices(naiveOutput, winogradOutput, 1e-6);
+
+  filter = arma::randu<arma::mat>(3, 3);
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, naiveOutput,
+      2, 2);
+  WinogradConvolution<ValidConvolution>::Convolution(input, filter,
+      winogradOutput, 2, 2);
+  CheckMatrices(naiveOutput, winogradOutput, 1e-6);
+
+  // The cube interface writes into the slices of the output.
+  arma::cube inputCube = arma::randu<arma::cube>(6, 7, 3);
+  arma::cube filterCube = arma::randu<arma::cube>(3, 3, 3);
+  arma::cube naiveCube, winogradCube;
+  NaiveConvolution<ValidConvolution>::Convolution(inputCube, filterCube,
+      naiveCube);
+  WinogradConvolution<ValidConvolution>::Convolution(inputCube, filterCube,
+      winogradCube);
+  CheckMatrices(naiveCube, winogradCube, 1e-6);
+}
+
+/**
+ * Col2Im() has to be the adjoint of Im2Col(), i.e. <Im2Col(x), y> has to be
+ * equal to <x, Col2Im(y)> for any x and y.
+ */
+BOOST_AUTO_TEST_CASE(Im2ColCol2ImAdjointTest)
+{
+  // Two points with three channels each.
+  arma::cube input = arma::randu<arma::cube>(9, 8, 6);
+  arma::mat cols;
+  Im2ColConvolution<ValidConvolution>::Im2Col(input, 3, 3, 2, cols, 2, 1, 1,
+      2);
+
+  BOOST_REQUIRE_EQUAL(cols.n_rows, 3 * 2 * 3);
+  BOOST_REQUIRE_EQUAL(cols.n_cols, 4 * 6 * 2);
+
+  arma::mat y = arma::randu<arma::mat>(cols.n_rows, cols.n_cols);
+  arma::cube folded(input.n_rows, input.n_cols, input.n_slices);
+  Im2ColConvolution<ValidConvolution>::Col2Im(y, 3, 3, 2, folded, 2, 1, 1, 2);
+
+  BOOST_REQUIRE_CLOSE(arma::accu(cols % y), arma::accu(input % folded),
+      1e-8);
 }
 
 BOOST_AUTO_TEST_SUITE_END();
@@ -1246,4 +1246,282 @@ BOOST_AUTO_TEST_CASE(DifferentMaximumDepthTest)
   BOOST_REQUIRE_EQUAL(d2.Child(1).NumChildren(), 2);
 }
 
+/**
+ * A BestBinaryNumericSplit that does not use presorted data, so the decision
+ * tree lets it sort the data at every node.
+ */
+template<typename FitnessFunction>
+class UnsortedBinaryNumericSplit :
+    public BestBinaryNumericSplit<FitnessFunction> { };
+
+/**
+ * Make sure that training on presorted data gives the same tree as sorting
+ * the data at every node.
+ */
+BOOST_AUTO_TEST_CASE(PresortedTrainingTest)
+{
+  arma::mat dataset(8, 2000, arma::fill::randu);
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    labels[i] = (dataset(1, i) + dataset(4, i) > 1.0) ? 1 : 0;
+    if (dataset(6, i) > 0.8)
+      labels[i] = 2;
+  }
+  arma::rowvec weights(dataset.n_cols, arma::fill::randu);
+
+  DecisionTree<> d;
+  DecisionTree<GiniGain, UnsortedBinaryNumericSplit> u;
+  const double entropy = d.Train(dataset, labels, 3, 5);
+  const double unsortedEntropy = u.Train(dataset, labels, 3, 5);
+  BOOST_REQUIRE_CLOSE(entropy, unsortedEntropy, 1e-5);
+
+  DecisionTree<> wd;
+  DecisionTree<GiniGain, UnsortedBinaryNumericSplit> wu;
+  wd.Train(dataset, labels, 3, weights, 5);
+  wu.Train(dataset, labels, 3, weights, 5);
+
+  arma::mat testData(8, 500, arma::fill::randu);
+  arma::Row<size_t> predictions, unsortedPredictions;
+  arma::mat probabilities, unsortedProbabilities;
+  d.Classify(testData, predictions, probabilities);
+  u.Classify(testData, unsortedPredictions, unsortedProbabilities);
+
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL(predictions[i], unsortedPredictions[i]);
+  for (size_t i = 0; i < probabilities.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(probabilities[i], unsortedProbabilities[i], 1e-5);
+
+  wd.Classify(testData, predictions);
+  wu.Classify(testData, unsortedPredictions);
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL(predictions[i], unsortedPredictions[i]);
+}
+
+/**
+ * Make sure that the HistogramNumericSplit finds a perfect split.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitSimpleSplitTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities,
+      aux);
+  const double weightedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made, and that it is perfect.
+  BOOST_REQUIRE_GT(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+  BOOST_REQUIRE_SMALL(gain, 1e-5);
+
+  // The splitting point should be between 4 and 5.
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 1);
+  BOOST_REQUIRE_GT(classProbabilities[0], 0.4);
+  BOOST_REQUIRE_LT(classProbabilities[0], 0.5);
+}
+
+/**
+ * Make sure that HistogramNumericSplit::Bin() keeps the order of the values,
+ * and uses no more than 256 bins.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitBinTest)
+{
+  arma::mat data(2, 5000, arma::fill::randu);
+  data.row(1) = arma::floor(10 * data.row(1));
+
+  arma::Mat<unsigned char> bins;
+  HistogramNumericSplit<GiniGain>::Bin(data, bins);
+
+  BOOST_REQUIRE_EQUAL(bins.n_rows, data.n_cols);
+  BOOST_REQUIRE_EQUAL(bins.n_cols, data.n_rows);
+
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    const arma::uvec order = arma::sort_index(data.row(d));
+    for (size_t i = 1; i < order.n_elem; ++i)
+      BOOST_REQUIRE_LE(bins(order[i - 1], d), bins(order[i], d));
+  }
+
+  // The second dimension has ten distinct values, so each gets its own bin.
+  for (size_t i = 0; i < data.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL((size_t) bins(i, 1), (size_t) data(1, i));
+}
+
+/**
+ * Test that a decision tree with the HistogramNumericSplit generalizes
+ * reasonably.
+ */
+BOOST_AUTO_TEST_CASE(HistogramGeneralizationTest)
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::rowvec weights(labels.n_cols, arma::fill::ones);
+
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+  DecisionTree<GiniGain, HistogramNumericSplit> wd(inputData, labels, 3,
+      weights, 10);
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    BOOST_FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Row<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    BOOST_FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testData.n_cols);
+  const double correct = double(arma::accu(predictions == trueTestLabels)) /
+      predictions.n_elem;
+  BOOST_REQUIRE_GT(correct, 0.75);
+
+  wd.Classify(testData, predictions);
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testData.n_cols);
+  const double wdCorrect = double(arma::accu(predictions == trueTestLabels)) /
+      predictions.n_elem;
+  BOOST_REQUIRE_GT(wdCorrect, 0.75);
+}
+
+/**
+ * Make sure that a FlatDecisionTree gives the same predictions and
+ * probabilities as the numeric decision tree it was built from.
+ */
+BOOST_AUTO_TEST_CASE(FlatDecisionTreeTest)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    BOOST_FAIL("Cannot load dataset vc2.csv");
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    BOOST_FAIL("Cannot load dataset vc2_test.csv");
+
+  DecisionTree<> tree(dataset, labels, 3, 5);
+  FlatDecisionTree flatTree(tree);
+  BOOST_REQUIRE_EQUAL(flatTree.NumClasses(), 3);
+  BOOST_REQUIRE_GT(flatTree.NumLeaves(), 1);
+
+  // The root of the flat tree must split like the root of the tree.
+  BOOST_REQUIRE_EQUAL(flatTree.Dimensions()[0], tree.SplitDimension());
+  BOOST_REQUIRE_EQUAL(flatTree.Children()[0], 1);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  tree.Classify(testDataset, predictions, probabilities);
+  flatTree.Classify(testDataset, flatPredictions, flatProbabilities);
+
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  // The single-point overloads must agree too.
+  for (size_t i = 0; i < testDataset.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL(flatTree.Classify(testDataset.col(i)), predictions[i]);
+}
+
+/**
+ * Make sure that a FlatDecisionTree gives the same predictions as a decision
+ * tree with categorical splits.
+ */
+BOOST_AUTO_TEST_CASE(FlatDecisionTreeCategoricalTest)
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+
+  DecisionTree<> tree(trainingData, di, trainingLabels, 5, 10);
+  FlatDecisionTree flatTree(tree);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  tree.Classify(testData, predictions, probabilities);
+  flatTree.Classify(testData, flatPredictions, flatProbabilities);
+
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+}
+
+/**
+ * Make sure that a FlatDecisionTree built from a tree that is only a leaf
+ * predicts the majority class.
+ */
+BOOST_AUTO_TEST_CASE(FlatDecisionTreeLeafTest)
+{
+  arma::mat dataset(3, 20, arma::fill::randu);
+  arma::Row<size_t> labels(20);
+  labels.fill(1);
+
+  // The minimum leaf size keeps the tree from splitting.
+  DecisionTree<> tree(dataset, labels, 2, 20);
+  BOOST_REQUIRE_EQUAL(tree.NumChildren(), 0);
+
+  FlatDecisionTree flatTree(tree);
+  BOOST_REQUIRE_EQUAL(flatTree.NumNodes(), 1);
+
+  arma::Row<size_t> predictions;
+  flatTree.Classify(dataset, predictions);
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(predictions[i], 1);
+}
+
+/**
+ * Make sure that a serialized FlatDecisionTree gives the same predictions.
+ */
+BOOST_AUTO_TEST_CASE(FlatDecisionTreeSerializationTest)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    BOOST_FAIL("Cannot load dataset vc2.csv");
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  DecisionTree<> tree(dataset, labels, 3, 5);
+  FlatDecisionTree flatTree(tree);
+
+  arma::Row<size_t> beforePredictions;
+  arma::mat beforeProbabilities;
+  flatTree.Classify(dataset, beforePredictions, beforeProbabilities);
+
+  FlatDecisionTree xmlTree, textTree, binaryTree;
+  SerializeObjectAll(flatTree, xmlTree, textTree, binaryTree);
+
+  arma::Row<size_t> xmlPredictions, textPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, textProbabilities, binaryProbabilities;
+  xmlTree.Classify(dataset, xmlPredictions, xmlProbabilities);
+  textTree.Classify(dataset, textPredictions, textProbabilities);
+  binaryTree.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(beforePredictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+  CheckMatrices(beforeProbabilities, xmlProbabilities, textProbabilities,
+      binaryProbabilities);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -15,6 +15,7 @@
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/quantize.hpp>
 
 #include <ensmallen.hpp>
 
@@ -395,6 +396,292 @@ BOOST_AUTO_TEST_CASE(FFNMiscTest)
   movedModel = std::move(copiedModel);
 }
 
+/**
+ * Make sure that copied and moved networks use their own layers, also after
+ * the source network was used and destroyed.
+ */
+BOOST_AUTO_TEST_CASE(FFNCopyPredictTest)
+{
+  arma::mat input = arma::randu<arma::mat>(5, 10);
+  arma::mat predictions, copiedPredictions, movedPredictions;
+
+  FFN<MeanSquaredError<> >* model = new FFN<MeanSquaredError<> >();
+  model->Add<Linear<> >(5, 8);
+  model->Add<SigmoidLayer<> >();
+  model->Add<Linear<> >(8, 2);
+  model->Predict(input, predictions);
+
+  FFN<MeanSquaredError<> > copiedModel(*model);
+  FFN<MeanSquaredError<> > movedModel(std::move(*model));
+  delete model;
+
+  copiedModel.Predict(input, copiedPredictions);
+  movedModel.Predict(input, movedPredictions);
+
+  CheckMatrices(predictions, copiedPredictions);
+  CheckMatrices(predictions, movedPredictions);
+
+  // Adding a layer has to be picked up by the next pass.
+  copiedModel.Add<SigmoidLayer<> >();
+  copiedModel.Predict(input, copiedPredictions);
+  CheckMatrices(arma::mat(1.0 / (1.0 + arma::exp(-predictions))),
+      copiedPredictions);
+
+  // So does replacing a layer through Model().
+  boost::apply_visitor(DeleteVisitor(), copiedModel.Model().back());
+  copiedModel.Model().back() = new IdentityLayer<>();
+  copiedModel.Predict(input, copiedPredictions);
+  CheckMatrices(predictions, copiedPredictions);
+}
+
+/**
+ * Make sure that PredictOne() returns the same predictions as Predict().
+ */
+BOOST_AUTO_TEST_CASE(FFNPredictOneTest)
+{
+  arma::mat input = arma::randu<arma::mat>(5, 10);
+  arma::mat predictions;
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(5, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Predict(input, predictions);
+
+  arma::colvec prediction;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    model.PredictOne(input.col(i), prediction);
+
+    BOOST_REQUIRE_EQUAL(prediction.n_elem, 2);
+    CheckMatrices(prediction, predictions.col(i));
+  }
+}
+
+/**
+ * Make sure that the predictions and the gradient of a network that computes
+ * its products in single precision are close to the double precision ones.
+ */
+BOOST_AUTO_TEST_CASE(FFNMixedPrecisionTest)
+{
+  arma::mat input = arma::randu<arma::mat>(10, 32);
+  arma::mat target = arma::randu<arma::mat>(3, 32);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 16);
+  model.Add<SigmoidLayer<> >();
+  model.Add<LinearNoBias<> >(16, 3);
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.ResetParameters();
+
+  arma::mat predictions, gradient;
+  model.Predict(input, predictions);
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 32);
+
+  model.MixedPrecision() = true;
+
+  arma::mat mixedPredictions, mixedGradient;
+  model.Predict(input, mixedPredictions);
+  const double mixedObjective = model.EvaluateWithGradient(model.Parameters(),
+      0, mixedGradient, 32);
+
+  BOOST_REQUIRE_CLOSE(objective, mixedObjective, 1e-2);
+  BOOST_REQUIRE_LE(arma::max(arma::vectorise(
+      arma::abs(predictions - mixedPredictions))), 1e-4);
+  BOOST_REQUIRE_LE(arma::max(arma::vectorise(
+      arma::abs(gradient - mixedGradient))), 1e-4);
+
+  // The single precision copy of the weights follows the parameters.
+  model.Parameters() *= 0.5;
+  model.Predict(input, mixedPredictions);
+  model.MixedPrecision() = false;
+  model.Predict(input, predictions);
+  BOOST_REQUIRE_LE(arma::max(arma::vectorise(
+      arma::abs(predictions - mixedPredictions))), 1e-4);
+
+  // So does a forward pass over a range of layers.
+  arma::mat output, mixedOutput;
+  model.MixedPrecision() = true;
+  model.Forward(input, mixedOutput, 0, 2);
+  model.Parameters() *= 2.0;
+  model.Forward(input, mixedOutput, 0, 2);
+  model.MixedPrecision() = false;
+  model.Forward(input, output, 0, 2);
+  BOOST_REQUIRE_LE(arma::max(arma::vectorise(
+      arma::abs(output - mixedOutput))), 1e-4);
+}
+
+/**
+ * Test that gradient checkpointing yields the same objective and gradient as
+ * the regular training pass, for all checkpoint intervals.
+ */
+BOOST_AUTO_TEST_CASE(FFNCheckpointTest)
+{
+  arma::mat input = arma::randu<arma::mat>(10, 32);
+  arma::mat target = arma::randu<arma::mat>(3, 32);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 16);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(16, 8);
+  model.Add<TanHLayer<> >();
+  model.Add<LinearNoBias<> >(8, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.ResetParameters();
+
+  arma::mat gradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 8,
+      gradient, 16);
+
+  for (size_t interval = 1; interval <= 8; ++interval)
+  {
+    model.CheckpointInterval() = interval;
+
+    arma::mat checkpointGradient;
+    const double checkpointObjective = model.EvaluateWithGradient(
+        model.Parameters(), 8, checkpointGradient, 16);
+
+    BOOST_REQUIRE_CLOSE(objective, checkpointObjective, 1e-5);
+    CheckMatrices(gradient, checkpointGradient, 1e-5);
+  }
+
+  // The outputs that were released must not affect the next prediction.
+  arma::mat predictions, checkpointPredictions;
+  model.CheckpointInterval() = 0;
+  model.Predict(input, predictions);
+  model.CheckpointInterval() = 3;
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient, 32);
+  model.Predict(input, checkpointPredictions);
+  CheckMatrices(predictions, checkpointPredictions);
+
+  // Dropout and BatchNorm lie inside a segment, but must not be recomputed:
+  // Dropout would draw a new mask and BatchNorm would update its statistics
+  // twice.
+  BatchNorm<>* batchNorm = new BatchNorm<>(16);
+  BatchNorm<>* checkpointBatchNorm = new BatchNorm<>(16);
+  FFN<MeanSquaredError<> > stateful, checkpointStateful;
+  auto addLayers = [](FFN<MeanSquaredError<> >& network,
+                      BatchNorm<>* batchNormLayer)
+  {
+    network.Add<Linear<> >(10, 16);
+    network.Add(batchNormLayer);
+    network.Add<SigmoidLayer<> >();
+    network.Add<Linear<> >(16, 8);
+    network.Add<Dropout<> >(0.3);
+    network.Add<TanHLayer<> >();
+    network.Add<Linear<> >(8, 3);
+  };
+  addLayers(stateful, batchNorm);
+  addLayers(checkpointStateful, checkpointBatchNorm);
+  stateful.Predictors() = checkpointStateful.Predictors() = input;
+  stateful.Responses() = checkpointStateful.Responses() = target;
+  stateful.ResetParameters();
+  checkpointStateful.ResetParameters();
+  checkpointStateful.Parameters() = stateful.Parameters();
+  checkpointStateful.CheckpointInterval() = 3;
+
+  math::RandomSeed(5);
+  const double statefulObjective = stateful.EvaluateWithGradient(
+      stateful.Parameters(), 0, gradient, 32);
+  math::RandomSeed(5);
+  arma::mat checkpointGradient;
+  const double checkpointObjective = checkpointStateful.EvaluateWithGradient(
+      checkpointStateful.Parameters(), 0, checkpointGradient, 32);
+
+  BOOST_REQUIRE_CLOSE(statefulObjective, checkpointObjective, 1e-5);
+  CheckMatrices(gradient, checkpointGradient, 1e-5);
+  CheckMatrices(batchNorm->TrainingMean(), checkpointBatchNorm->TrainingMean(),
+      1e-5);
+  CheckMatrices(batchNorm->TrainingVariance(),
+      checkpointBatchNorm->TrainingVariance(), 1e-5);
+}
+
+/**
+ * Test that training and prediction on sparse data give the same results as on
+ * the dense version of the data.
+ */
+BOOST_AUTO_TEST_CASE(FFNSparseInputTest)
+{
+  arma::sp_mat sparseInput = arma::sprandu<arma::sp_mat>(200, 64, 0.02);
+  arma::mat input(sparseInput);
+  arma::mat target = arma::randu<arma::mat>(2, 64);
+
+  FFN<MeanSquaredError<> > model, sparseModel;
+  model.Add<Linear<> >(200, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  sparseModel.Add<Linear<> >(200, 8);
+  sparseModel.Add<SigmoidLayer<> >();
+  sparseModel.Add<Linear<> >(8, 2);
+  model.ResetParameters();
+  sparseModel.ResetParameters();
+  sparseModel.Parameters() = model.Parameters();
+
+  // Run a prediction first, so that Train() keeps the parameters.
+  arma::mat predictions, sparsePredictions;
+  model.Predict(input, predictions);
+  sparseModel.Predict(sparseInput, sparsePredictions);
+  CheckMatrices(predictions, sparsePredictions);
+
+  ens::StandardSGD opt(0.1, 8, 64 * 3, -1, false);
+  model.Train(input, target, opt);
+  sparseModel.Train(sparseInput, target, opt);
+
+  CheckMatrices(model.Parameters(), sparseModel.Parameters());
+
+  model.Predict(input, predictions);
+  sparseModel.Predict(sparseInput, sparsePredictions);
+  CheckMatrices(predictions, sparsePredictions);
+}
+
+/**
+ * Test that training on the chunks of a DataLoader gives the same model as
+ * training on the whole dataset in memory.
+ */
+BOOST_AUTO_TEST_CASE(FFNDataLoaderTest)
+{
+  arma::mat input = arma::randu<arma::mat>(6, 64);
+  arma::mat target = arma::randu<arma::mat>(2, 64);
+  data::Save("ffn_data_loader_input.bin", input, true, false);
+  data::Save("ffn_data_loader_target.bin", target, true, false);
+
+  FFN<MeanSquaredError<> > model, streamModel;
+  model.Add<Linear<> >(6, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  streamModel.Add<Linear<> >(6, 8);
+  streamModel.Add<SigmoidLayer<> >();
+  streamModel.Add<Linear<> >(8, 2);
+  model.ResetParameters();
+  streamModel.ResetParameters();
+  streamModel.Parameters() = model.Parameters();
+
+  // Run a prediction first, so that Train() keeps the parameters.
+  arma::mat predictions, streamPredictions;
+  model.Predict(input, predictions);
+  streamModel.Predict(input, streamPredictions);
+
+  // Two passes over the whole dataset, so the loader has to be restarted.
+  ens::StandardSGD opt(0.1, 8, 128, -1, false);
+  const double objective = model.Train(input, target, opt);
+
+  data::DataLoader loader("ffn_data_loader_input.bin",
+      "ffn_data_loader_target.bin", 32, false);
+  ens::StandardSGD streamOpt(0.1, 8, 128, -1, false);
+  const double streamObjective = streamModel.Train(loader, streamOpt);
+
+  CheckMatrices(model.Parameters(), streamModel.Parameters());
+  BOOST_REQUIRE_CLOSE(objective, streamObjective, 1e-5);
+
+  remove("ffn_data_loader_input.bin");
+  remove("ffn_data_loader_target.bin");
+}
+
 /**
  * Test that serialization works ok.
  */
@@ -443,6 +730,107 @@ BOOST_AUTO_TEST_CASE(SerializationTest)
       binaryPredictions);
 }
 
+/**
+ * Make sure that a quantized network predicts almost the same as the original
+ * network, and that it can be serialized.
+ */
+BOOST_AUTO_TEST_CASE(QuantizeSerializationTest)
+{
+  arma::mat input = arma::randu<arma::mat>(10, 50);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 16);
+  model.Add<SigmoidLayer<> >();
+  model.Add<LinearNoBias<> >(16, 8);
+  model.Add<PReLU<> >();
+  model.Add<Linear<> >(8, 3);
+
+  arma::mat predictions;
+  model.Predict(input, predictions);
+
+  Quantize(model, input);
+
+  // Only the parameter of the PReLU layer is left.
+  BOOST_REQUIRE_EQUAL(model.Parameters().n_elem, 1);
+
+  arma::mat quantizedPredictions;
+  model.Predict(input, quantizedPredictions);
+  BOOST_REQUIRE_LE(arma::max(arma::max(arma::abs(predictions -
+      quantizedPredictions))), 0.1);
+
+  FFN<MeanSquaredError<> > xmlModel, textModel, binaryModel;
+  xmlModel.Add<Linear<> >(10, 10); // Layer that will get removed.
+
+  SerializeObjectAll(model, xmlModel, textModel, binaryModel);
+
+  arma::mat xmlPredictions, textPredictions, binaryPredictions;
+  xmlModel.Predict(input, xmlPredictions);
+  textModel.Predict(input, textPredictions);
+  binaryModel.Predict(input, binaryPredictions);
+
+  CheckMatrices(quantizedPredictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Make sure that a quantized convolutional network predicts almost the same
+ * as the original network.
+ */
+BOOST_AUTO_TEST_CASE(QuantizeConvolutionTest)
+{
+  arma::mat input = arma::randu<arma::mat>(6 * 6, 30);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Convolution<> >(1, 4, 3, 3, 1, 1, 1, 1, 6, 6);
+  model.Add<PReLU<> >();
+  model.Add<Linear<> >(6 * 6 * 4, 3);
+
+  arma::mat predictions;
+  model.Predict(input, predictions);
+
+  Quantize(model, input);
+
+  // Only the parameter of the PReLU layer is left.
+  BOOST_REQUIRE_EQUAL(model.Parameters().n_elem, 1);
+
+  arma::mat quantizedPredictions;
+  model.Predict(input, quantizedPredictions);
+  BOOST_REQUIRE_LE(arma::max(arma::max(arma::abs(predictions -
+      quantizedPredictions))), 0.05 * arma::max(arma::max(arma::abs(
+      predictions))));
+}
+
+/**
+ * Make sure that a network that holds Linear layers inside of a container
+ * layer is rejected, and left as it is.
+ */
+BOOST_AUTO_TEST_CASE(QuantizeSequentialTest)
+{
+  arma::mat input = arma::randu<arma::mat>(10, 50);
+
+  FFN<MeanSquaredError<> > model;
+  Sequential<>* sequential = new Sequential<>();
+  sequential->Add<Linear<> >(10, 16);
+  sequential->Add<SigmoidLayer<> >();
+  model.Add(sequential);
+  model.Add<Linear<> >(16, 3);
+
+  arma::mat predictions;
+  model.Predict(input, predictions);
+  const arma::mat parameters = model.Parameters();
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(Quantize(model, input), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  BOOST_REQUIRE_EQUAL(model.Model().size(), 2);
+  CheckMatrices(parameters, model.Parameters());
+
+  arma::mat newPredictions;
+  model.Predict(input, newPredictions);
+  CheckMatrices(predictions, newPredictions);
+}
+
 /**
  * Test if the custom layers work. The target is to see if the code compiles
  * when the Train and Prediction are called.
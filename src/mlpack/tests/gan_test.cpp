@@ -348,4 +348,107 @@ BOOST_AUTO_TEST_CASE(GANMemorySharingTest)
       trainData);
 }
 
+/**
+ * Noise function for GANOverlapTest that can draw from a given random number
+ * generator.
+ */
+struct GeneratorNoise
+{
+  template<typename GeneratorType>
+  double operator()(GeneratorType& generator)
+  {
+    return std::uniform_real_distribution<>(-8, 8)(generator) +
+        std::normal_distribution<>(0, 0.01)(generator);
+  }
+
+  double operator()() { return (*this)(math::randGen); }
+};
+
+/*
+ * Check that an overlapped training step, which runs the discriminator on the
+ * real and the generated batch at once, gives the same objective and gradient
+ * as the standard step.
+ */
+BOOST_AUTO_TEST_CASE(GANOverlapTest)
+{
+  size_t discriminatorHiddenLayerSize = 8;
+  size_t generatorHiddenLayerSize = 8;
+  size_t batchSize = 8;
+  size_t noiseDim = 1;
+
+  arma::mat trainData(1, 200);
+  trainData.imbue( [&]() { return arma::as_scalar(RandNormal(4, 0.5));});
+
+  // Create the Discriminator network.
+  FFN<SigmoidCrossEntropyError<> > discriminator;
+  discriminator.Add<Linear<> > (1, discriminatorHiddenLayerSize);
+  discriminator.Add<ReLULayer<> >();
+  discriminator.Add<Linear<> > (discriminatorHiddenLayerSize, 1);
+
+  // Create the Generator network.
+  FFN<SigmoidCrossEntropyError<> > generator;
+  generator.Add<Linear<> >(noiseDim, generatorHiddenLayerSize);
+  generator.Add<SoftPlusLayer<> >();
+  generator.Add<Linear<> >(generatorHiddenLayerSize, 1);
+
+  GaussianInitialization gaussian(0, 0.1);
+  std::function<double ()> noiseFunction = [](){ return math::Random(-8, 8) +
+      math::RandNormal(0, 1) * 0.01;};
+  typedef GAN<FFN<SigmoidCrossEntropyError<> >, GaussianInitialization,
+      std::function<double()> > GANType;
+
+  GANType gan(generator, discriminator, gaussian, noiseFunction, noiseDim,
+      batchSize, 1, 0, 1);
+  GANType overlapGAN(generator, discriminator, gaussian, noiseFunction,
+      noiseDim, batchSize, 1, 0, 1);
+  overlapGAN.Overlap() = true;
+
+  gan.ResetData(trainData);
+  overlapGAN.ResetData(trainData);
+  overlapGAN.Parameters() = gan.Parameters();
+
+  // The first batch of noise is drawn in the same order in both modes.
+  arma::mat gradient, overlapGradient;
+  math::RandomSeed(3);
+  const double objective = gan.EvaluateWithGradient(gan.Parameters(), 16,
+      gradient, batchSize);
+  math::RandomSeed(3);
+  const double overlapObjective = overlapGAN.EvaluateWithGradient(
+      overlapGAN.Parameters(), 16, overlapGradient, batchSize);
+
+  BOOST_REQUIRE_CLOSE(objective, overlapObjective, 1e-3);
+  CheckMatrices(gradient, overlapGradient, 1e-3);
+
+  // Training in the overlapped mode has to run through as well.
+  ens::Adam optimizer(0.0003, batchSize, 0.9, 0.999, 1e-8, 50, 1e-5, true);
+  const double result = overlapGAN.Train(trainData, optimizer);
+  BOOST_REQUIRE(std::isfinite(result));
+
+  // A noise function that draws from a given generator has its noise made in
+  // the background, and the result must still only depend on the seed.
+  BOOST_REQUIRE(NoiseTakesGenerator<GeneratorNoise>::value);
+  BOOST_REQUIRE(!NoiseTakesGenerator<std::function<double()> >::value);
+
+  typedef GAN<FFN<SigmoidCrossEntropyError<> >, GaussianInitialization,
+      GeneratorNoise> GeneratorGANType;
+  GeneratorNoise generatorNoise;
+  arma::mat parameters[2];
+  for (size_t run = 0; run < 2; ++run)
+  {
+    GeneratorGANType generatorGAN(generator, discriminator, gaussian,
+        generatorNoise, noiseDim, batchSize, 1, 0, 1);
+    generatorGAN.Overlap() = true;
+    generatorGAN.ResetData(trainData);
+    generatorGAN.Parameters() = gan.Parameters();
+
+    math::RandomSeed(5);
+    ens::Adam generatorOptimizer(0.0003, batchSize, 0.9, 0.999, 1e-8, 50,
+        1e-5, false);
+    BOOST_REQUIRE(std::isfinite(generatorGAN.Train(trainData,
+        generatorOptimizer)));
+    parameters[run] = generatorGAN.Parameters();
+  }
+  CheckMatrices(parameters[0], parameters[1]);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
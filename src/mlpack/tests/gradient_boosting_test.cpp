@@ -0,0 +1,241 @@
+/**
+ * @file gradient_boosting_test.cpp
+ *
+ * Tests for the GradientBoosting class and its losses.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/gradient_boosting/gradient_boosting.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::tree;
+
+BOOST_AUTO_TEST_SUITE(GradientBoostingTest);
+
+/**
+ * Make sure the gradients of the squared error loss are the residuals.
+ */
+BOOST_AUTO_TEST_CASE(SquaredErrorLossGradientsTest)
+{
+  arma::rowvec responses("1.0 2.0 3.0 6.0");
+  arma::mat scores("0.0 2.0 4.0 5.0");
+
+  SquaredErrorLoss loss;
+  arma::vec initialScores;
+  loss.Initialize(responses, initialScores);
+  BOOST_REQUIRE_EQUAL(initialScores.n_elem, 1);
+  BOOST_REQUIRE_CLOSE(initialScores[0], 3.0, 1e-5);
+
+  arma::mat gradients, hessians;
+  loss.Gradients(responses, scores, gradients, hessians);
+  BOOST_REQUIRE_CLOSE(gradients[0], -1.0, 1e-5);
+  BOOST_REQUIRE_SMALL(gradients[1], 1e-5);
+  BOOST_REQUIRE_CLOSE(gradients[2], 1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(gradients[3], -1.0, 1e-5);
+  for (size_t i = 0; i < hessians.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(hessians[i], 1.0, 1e-5);
+
+  BOOST_REQUIRE_CLOSE(loss.Evaluate(responses, scores), 0.75, 1e-5);
+}
+
+/**
+ * Make sure the softmax probabilities sum to one and the gradients of the
+ * cross-entropy sum to zero for every point.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxCrossEntropyLossGradientsTest)
+{
+  arma::Row<size_t> labels("0 1 2 1");
+  arma::mat scores(3, 4, arma::fill::randn);
+
+  SoftmaxCrossEntropyLoss loss;
+  arma::vec initialScores;
+  loss.Initialize(labels, initialScores);
+  BOOST_REQUIRE_EQUAL(loss.NumClasses(), 3);
+  BOOST_REQUIRE_EQUAL(initialScores.n_elem, 3);
+  BOOST_REQUIRE_GT(initialScores[1], initialScores[0]);
+
+  arma::mat probabilities;
+  loss.Probabilities(scores, probabilities);
+  arma::mat gradients, hessians;
+  loss.Gradients(labels, scores, gradients, hessians);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(arma::accu(probabilities.col(i)), 1.0, 1e-5);
+    BOOST_REQUIRE_SMALL(arma::accu(gradients.col(i)), 1e-5);
+    BOOST_REQUIRE_CLOSE(gradients(labels[i], i),
+        probabilities(labels[i], i) - 1.0, 1e-5);
+  }
+
+  BOOST_REQUIRE_GT(arma::min(arma::vectorise(hessians)), 0.0);
+}
+
+/**
+ * Make sure that a regression model fits a simple nonlinear function.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingRegressionTest)
+{
+  arma::mat dataset(2, 2000, arma::fill::randu);
+  arma::rowvec responses = arma::sin(4.0 * dataset.row(0)) +
+      arma::square(dataset.row(1));
+
+  GradientBoosting<SquaredErrorLoss> gb(200, 0.1, 4, 10);
+  const double trainingLoss = gb.Train(dataset, responses);
+  BOOST_REQUIRE_LT(trainingLoss, 0.01);
+  BOOST_REQUIRE_EQUAL(gb.NumTrees(), 200);
+
+  arma::mat testDataset(2, 500, arma::fill::randu);
+  arma::rowvec testResponses = arma::sin(4.0 * testDataset.row(0)) +
+      arma::square(testDataset.row(1));
+  arma::rowvec predictions;
+  gb.Predict(testDataset, predictions);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testDataset.n_cols);
+  const double mse = arma::mean(arma::square(predictions - testResponses));
+  BOOST_REQUIRE_LT(mse, 0.02);
+}
+
+/**
+ * Make sure that a classification model gets reasonable accuracy on the vc2
+ * dataset.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingClassificationTest)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    BOOST_FAIL("Cannot load dataset vc2.csv");
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testDataset;
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test.csv", testDataset))
+    BOOST_FAIL("Cannot load dataset vc2_test.csv");
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    BOOST_FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  GradientBoosting<SoftmaxCrossEntropyLoss> gb(50, 0.1, 3, 5);
+  gb.Train(dataset, labels);
+  BOOST_REQUIRE_EQUAL(gb.NumOutputs(), 3);
+  BOOST_REQUIRE_EQUAL(gb.NumTrees(), 150);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  gb.Classify(testDataset, predictions, probabilities);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testDataset.n_cols);
+  BOOST_REQUIRE_EQUAL(probabilities.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(probabilities.n_cols, testDataset.n_cols);
+  for (size_t i = 0; i < probabilities.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(arma::accu(probabilities.col(i)), 1.0, 1e-5);
+
+  const size_t correct = arma::accu(predictions == testLabels);
+  const double accuracy = (double) correct / (double) testLabels.n_elem;
+  BOOST_REQUIRE_GT(accuracy, 0.7);
+}
+
+/**
+ * Make sure that training stops early when the validation loss stops
+ * improving, and that the model keeps only the best iterations.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingEarlyStoppingTest)
+{
+  // The responses are pure noise, so the validation loss can't keep improving.
+  arma::mat dataset(3, 500, arma::fill::randu);
+  arma::rowvec responses(500, arma::fill::randn);
+  arma::mat validationDataset(3, 200, arma::fill::randu);
+  arma::rowvec validationResponses(200, arma::fill::randn);
+
+  GradientBoosting<SquaredErrorLoss> gb(500, 0.3, 6, 1, 0.0, 1.0, 5);
+  const double validationLoss = gb.Train(dataset, responses,
+      validationDataset, validationResponses);
+  BOOST_REQUIRE_LT(gb.NumTrees(), 500);
+
+  // The kept model must reproduce the best validation loss.
+  arma::rowvec predictions;
+  gb.Predict(validationDataset, predictions);
+  const double mse = arma::mean(arma::square(predictions -
+      validationResponses));
+  BOOST_REQUIRE_CLOSE(mse, validationLoss, 1e-5);
+}
+
+/**
+ * Make sure that training fails on an empty validation set and on a
+ * validation loss that is not finite.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingInvalidValidationTest)
+{
+  arma::mat dataset(3, 100, arma::fill::randu);
+  arma::rowvec responses(100, arma::fill::randn);
+  arma::mat validationDataset(3, 20, arma::fill::randu);
+  arma::rowvec validationResponses(20, arma::fill::randn);
+
+  GradientBoosting<SquaredErrorLoss> gb(10, 0.3, 3, 1, 0.0, 1.0, 5);
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(gb.Train(dataset, responses, arma::mat(3, 0),
+      arma::rowvec()), std::runtime_error);
+
+  validationResponses[0] = arma::datum::nan;
+  BOOST_REQUIRE_THROW(gb.Train(dataset, responses, validationDataset,
+      validationResponses), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Make sure that subsampling still produces a useful model.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingSubsampleTest)
+{
+  arma::mat dataset(2, 2000, arma::fill::randu);
+  arma::rowvec responses = 3.0 * dataset.row(0) - 2.0 * dataset.row(1);
+
+  GradientBoosting<SquaredErrorLoss> gb(100, 0.2, 3, 10, 1.0, 0.5);
+  const double trainingLoss = gb.Train(dataset, responses);
+  BOOST_REQUIRE_LT(trainingLoss, 0.02);
+}
+
+/**
+ * Make sure that a serialized model gives the same predictions.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingSerializationTest)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    BOOST_FAIL("Cannot load dataset vc2.csv");
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  GradientBoosting<SoftmaxCrossEntropyLoss> gb(10, 0.1, 3, 5);
+  gb.Train(dataset, labels);
+
+  arma::Row<size_t> beforePredictions;
+  arma::mat beforeProbabilities;
+  gb.Classify(dataset, beforePredictions, beforeProbabilities);
+
+  GradientBoosting<SoftmaxCrossEntropyLoss> xmlGb, textGb, binaryGb;
+  SerializeObjectAll(gb, xmlGb, textGb, binaryGb);
+
+  arma::Row<size_t> xmlPredictions, textPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, textProbabilities, binaryProbabilities;
+
+  xmlGb.Classify(dataset, xmlPredictions, xmlProbabilities);
+  textGb.Classify(dataset, textPredictions, textProbabilities);
+  binaryGb.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(beforePredictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+  CheckMatrices(beforeProbabilities, xmlProbabilities, textProbabilities,
+      binaryProbabilities);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
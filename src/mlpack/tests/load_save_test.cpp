@@ -12,6 +12,7 @@
 #include <sstream>
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/data_loader.hpp>
 #include <mlpack/core/data/load_arff.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include <boost/test/unit_test.hpp>
@@ -2169,4 +2170,61 @@ BOOST_AUTO_TEST_CASE(DatasetMapperNonUniqueTest)
   BOOST_REQUIRE_EQUAL(dm.UnmapString(nan, 0, 2), "cheese");
 }
 
+/**
+ * Make sure that the DataLoader streams all points of csv and binary files,
+ * in order and shuffled.
+ */
+BOOST_AUTO_TEST_CASE(DataLoaderTest)
+{
+  arma::mat predictors = arma::randu<arma::mat>(4, 23);
+  arma::mat responses = arma::randu<arma::mat>(2, 23);
+  responses.row(0) = arma::regspace<arma::rowvec>(0, 22);
+
+  // Each line of the csv file is a point, the binary file holds one point per
+  // column.
+  BOOST_REQUIRE(data::Save("data_loader_test.csv", predictors));
+  BOOST_REQUIRE(data::Save("data_loader_test.bin", responses, true, false));
+
+  data::DataLoader loader("data_loader_test.csv", "data_loader_test.bin", 5,
+      false);
+  BOOST_REQUIRE_EQUAL(loader.NumPoints(), 23);
+  BOOST_REQUIRE_EQUAL(loader.NumChunks(), 5);
+
+  arma::mat chunkPredictors, chunkResponses;
+  arma::mat allPredictors, allResponses;
+  while (loader.Next(chunkPredictors, chunkResponses))
+  {
+    BOOST_REQUIRE_LE(chunkPredictors.n_cols, 5);
+    allPredictors = arma::join_rows(allPredictors, chunkPredictors);
+    allResponses = arma::join_rows(allResponses, chunkResponses);
+  }
+
+  CheckMatrices(predictors, allPredictors, 1e-2);
+  CheckMatrices(responses, allResponses);
+
+  // A shuffled epoch with an augmentation still visits each point once.
+  loader.Shuffle() = true;
+  loader.Transform() = [](arma::mat& x, arma::mat& /* y */) { x *= 2; };
+  loader.Reset();
+
+  allPredictors.reset();
+  allResponses.reset();
+  while (loader.Next(chunkPredictors, chunkResponses))
+  {
+    allPredictors = arma::join_rows(allPredictors, chunkPredictors);
+    allResponses = arma::join_rows(allResponses, chunkResponses);
+  }
+
+  CheckMatrices(arma::mat(arma::sort(allResponses.row(0))),
+      arma::mat(arma::regspace<arma::rowvec>(0, 22)));
+
+  const arma::uvec order = arma::conv_to<arma::uvec>::from(
+      allResponses.row(0));
+  CheckMatrices(arma::mat(2 * predictors.cols(order)), allPredictors, 1e-2);
+  CheckMatrices(arma::mat(responses.cols(order)), allResponses);
+
+  remove("data_loader_test.csv");
+  remove("data_loader_test.bin");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
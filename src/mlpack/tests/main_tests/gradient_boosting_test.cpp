@@ -0,0 +1,182 @@
+/**
+ * @file gradient_boosting_test.cpp
+ *
+ * Test mlpackMain() of gradient_boosting_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+static const std::string testName = "GradientBoosting";
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/methods/gradient_boosting/gradient_boosting_main.cpp>
+#include "test_helper.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include "../test_tools.hpp"
+
+using namespace mlpack;
+
+struct GradientBoostingTestFixture
+{
+ public:
+  GradientBoostingTestFixture()
+  {
+    // Cache in the options for this program.
+    CLI::RestoreSettings(testName);
+  }
+
+  ~GradientBoostingTestFixture()
+  {
+    // Clear the settings.
+    bindings::tests::CleanMemory();
+    CLI::ClearSettings();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(GradientBoostingMainTest,
+                         GradientBoostingTestFixture);
+
+/**
+ * Check that the number of predictions and probabilities matches the number of
+ * test points for a classification model.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingClassificationOutputTest)
+{
+  arma::mat trainData;
+  if (!data::Load("vc2.csv", trainData))
+    BOOST_FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    BOOST_FAIL("Cannot load test dataset vc2_test.csv!");
+
+  const size_t testSize = testData.n_cols;
+
+  SetInputParam("training", std::move(trainData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("test", std::move(testData));
+  SetInputParam("num_iterations", (int) 10);
+
+  mlpackMain();
+
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::Row<size_t>>("predictions").n_cols,
+      testSize);
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::Row<size_t>>("predictions").n_rows,
+      1);
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("probabilities").n_cols,
+      testSize);
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<arma::mat>("probabilities").n_rows, 3);
+}
+
+/**
+ * Check that the number of predicted responses matches the number of test
+ * points for a regression model.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingRegressionOutputTest)
+{
+  arma::mat trainData(3, 500, arma::fill::randu);
+  arma::rowvec responses = arma::sum(trainData, 0);
+  arma::mat testData(3, 100, arma::fill::randu);
+
+  SetInputParam("training", std::move(trainData));
+  SetInputParam("responses", std::move(responses));
+  SetInputParam("test", std::move(testData));
+  SetInputParam("num_iterations", (int) 10);
+
+  mlpackMain();
+
+  BOOST_REQUIRE_EQUAL(
+      CLI::GetParam<arma::rowvec>("predicted_responses").n_elem, 100);
+}
+
+/**
+ * Make sure a saved model gives the same predictions as the model it was
+ * trained from.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingModelReuseTest)
+{
+  arma::mat trainData;
+  if (!data::Load("vc2.csv", trainData))
+    BOOST_FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    BOOST_FAIL("Cannot load test dataset vc2_test.csv!");
+
+  SetInputParam("training", std::move(trainData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("test", testData);
+  SetInputParam("num_iterations", (int) 10);
+
+  mlpackMain();
+
+  arma::Row<size_t> predictions =
+      std::move(CLI::GetParam<arma::Row<size_t>>("predictions"));
+  arma::mat probabilities =
+      std::move(CLI::GetParam<arma::mat>("probabilities"));
+
+  // Reset the training parameters and use the model.
+  CLI::GetSingleton().Parameters()["training"].wasPassed = false;
+  CLI::GetSingleton().Parameters()["labels"].wasPassed = false;
+
+  SetInputParam("input_model",
+      CLI::GetParam<GradientBoostingModel*>("output_model"));
+  SetInputParam("test", std::move(testData));
+
+  mlpackMain();
+
+  CheckMatrices(predictions,
+      CLI::GetParam<arma::Row<size_t>>("predictions"));
+  CheckMatrices(probabilities, CLI::GetParam<arma::mat>("probabilities"));
+}
+
+/**
+ * Make sure that a nonpositive number of iterations is rejected.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingInvalidIterationsTest)
+{
+  arma::mat trainData(3, 100, arma::fill::randu);
+  arma::rowvec responses(100, arma::fill::randu);
+
+  SetInputParam("training", std::move(trainData));
+  SetInputParam("responses", std::move(responses));
+  SetInputParam("num_iterations", (int) 0);
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Make sure that training must have exactly one of labels or responses.
+ */
+BOOST_AUTO_TEST_CASE(GradientBoostingLabelsAndResponsesTest)
+{
+  arma::mat trainData(3, 100, arma::fill::randu);
+  arma::Row<size_t> labels(100, arma::fill::zeros);
+  arma::rowvec responses(100, arma::fill::randu);
+
+  SetInputParam("training", std::move(trainData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("responses", std::move(responses));
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -98,6 +98,111 @@ BOOST_AUTO_TEST_CASE(CartPoleWithDQN)
   BOOST_REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task with vectorized environments.
+BOOST_AUTO_TEST_CASE(CartPoleWithVectorEnvironmentDQN)
+{
+  // Set up the network.
+  SimpleDQN<> model(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(model), AdamUpdate, decltype(policy)>
+      agent(std::move(config), std::move(model), std::move(policy),
+      std::move(replayMethod));
+
+  // Four copies of the task are stepped together.
+  VectorEnvironment<CartPole> environments(4, CartPole(), 200);
+
+  arma::running_stat<double> averageReturn;
+  size_t steps = 0;
+  bool converged = false;
+  while (steps < 100000)
+  {
+    agent.Step(environments);
+    steps += environments.NumEnvironments();
+
+    for (size_t i = 0; i < environments.FinishedReturns().size(); ++i)
+      averageReturn(environments.FinishedReturns()[i]);
+
+    // Reaching running average return 35 is enough to show it works.
+    if (averageReturn.count() >= 20 && averageReturn.mean() > 35)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  Log::Debug << "Average return: " << averageReturn.mean() << std::endl;
+  BOOST_REQUIRE(converged);
+}
+
+//! Test DQN in Cart Pole task with separate actor and learner threads.
+BOOST_AUTO_TEST_CASE(CartPoleWithActorLearnerDQN)
+{
+  // Set up the network.
+  SimpleDQN<> model(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+  config.NumWorkers() = 2;
+  config.UpdateInterval() = 1;
+  config.ActorLead() = 50;
+  config.PublishInterval() = 5;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(model), AdamUpdate, decltype(policy)>
+      agent(std::move(config), std::move(model), std::move(policy),
+      std::move(replayMethod));
+
+  arma::running_stat<double> averageReturn;
+  bool converged = false;
+  auto measure = [&](double episodeReturn)
+  {
+    averageReturn(episodeReturn);
+
+    // Reaching running average return 35 is enough to show it works.
+    if (averageReturn.count() >= 20 && averageReturn.mean() > 35)
+    {
+      converged = true;
+      return true;
+    }
+
+    return averageReturn.count() > 2000;
+  };
+
+  agent.TrainActorLearner(measure);
+
+  Log::Debug << "Average return: " << averageReturn.mean()
+      << " Actor steps/s: " << agent.ActorStepsPerSecond()
+      << " Learner updates/s: " << agent.LearnerUpdatesPerSecond()
+      << std::endl;
+  BOOST_REQUIRE(converged);
+
+  // The actors can never be more than the allowed lead ahead of the learner.
+  BOOST_REQUIRE_GT(agent.LearnerUpdates(), 0);
+  BOOST_REQUIRE_LE(agent.ActorSteps(), 100 + agent.LearnerUpdates() + 50);
+  BOOST_REQUIRE_GE(agent.TotalSteps(), agent.LearnerUpdates());
+}
+
 //! Test DQN in Cart Pole task with Prioritized Replay.
 BOOST_AUTO_TEST_CASE(CartPoleWithDQNPrioritizedReplay)
 {
@@ -487,4 +487,94 @@ BOOST_AUTO_TEST_CASE(DifferentTreesTest)
   BOOST_REQUIRE_EQUAL(success, true);
 }
 
+/**
+ * Make sure a random forest with the HistogramNumericSplit learns as well as
+ * the default forest on a numeric dataset.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericLearningTest)
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<GiniGain, MultipleRandomDimensionSelect, HistogramNumericSplit>
+      hrf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+  arma::Row<size_t> testLabels;
+  data::Load("vc2_test_labels.txt", testLabels);
+
+  arma::Row<size_t> hrfPredictions;
+  arma::Row<size_t> rfPredictions;
+  hrf.Classify(testDataset, hrfPredictions);
+  rf.Classify(testDataset, rfPredictions);
+
+  const size_t hrfCorrect = arma::accu(hrfPredictions == testLabels);
+  const size_t rfCorrect = arma::accu(rfPredictions == testLabels);
+
+  BOOST_REQUIRE_GE(hrfCorrect, rfCorrect * 0.9);
+  BOOST_REQUIRE_GE(hrfCorrect, size_t(0.7 * testDataset.n_cols));
+}
+
+/**
+ * Make sure that a FlatRandomForest gives the same predictions and
+ * probabilities as the random forest it was built from.
+ */
+BOOST_AUTO_TEST_CASE(FlatRandomForestTest)
+{
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1, 1e-7);
+  FlatRandomForest flatForest(rf);
+  BOOST_REQUIRE_EQUAL(flatForest.NumTrees(), rf.NumTrees());
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  rf.Classify(testDataset, predictions, probabilities);
+  flatForest.Classify(testDataset, flatPredictions, flatProbabilities);
+
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  for (size_t i = 0; i < testDataset.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(flatForest.Classify(testDataset.col(i)),
+        predictions[i]);
+  }
+
+  // A forest of histogram trees can be flattened too.
+  RandomForest<GiniGain, MultipleRandomDimensionSelect, HistogramNumericSplit>
+      hrf(dataset, labels, 3, 10 /* 10 trees */, 1, 1e-7);
+  FlatRandomForest flatHistogramForest(hrf);
+  hrf.Classify(testDataset, predictions, probabilities);
+  flatHistogramForest.Classify(testDataset, flatPredictions,
+      flatProbabilities);
+
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+}
+
+/**
+ * Make sure that an empty FlatRandomForest can't classify points.
+ */
+BOOST_AUTO_TEST_CASE(EmptyFlatRandomForestTest)
+{
+  FlatRandomForest flatForest;
+  arma::mat dataset(3, 10, arma::fill::randu);
+  arma::Row<size_t> predictions;
+
+  BOOST_REQUIRE_THROW(flatForest.Classify(dataset, predictions),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
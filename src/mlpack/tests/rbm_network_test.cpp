@@ -258,4 +258,62 @@ BOOST_AUTO_TEST_CASE(MiscTest)
   BuildVanillaNetwork<arma::Mat<float>>(X, 2);
 }
 
+/*
+ * Check that the parallel Gibbs sampler matches the hidden and visible means
+ * when many chains are sampled at once, and that persistent chains are kept
+ * between calls.
+ */
+BOOST_AUTO_TEST_CASE(BinaryRBMBatchedGibbsTest)
+{
+  const size_t visibleSize = 8;
+  const size_t hiddenSize = 6;
+  const size_t numChains = 20000;
+
+  arma::mat data = arma::randu<arma::mat>(visibleSize, 10);
+  GaussianInitialization gaussian(0, 0.5);
+  RBM<GaussianInitialization> model(data, gaussian, visibleSize, hiddenSize,
+      5, 1, 1, 2, 8, 1, true);
+  model.Reset();
+
+  // Every chain starts from the same visible vector, so the average of the
+  // samples has to approach the mean.
+  arma::mat input = arma::repmat(data.col(0), 1, numChains);
+  arma::mat hiddenMean, hiddenSamples;
+  model.HiddenMean(std::move(arma::mat(data.col(0))), std::move(hiddenMean));
+  model.SampleHidden(std::move(input), std::move(hiddenSamples));
+
+  BOOST_REQUIRE_EQUAL(hiddenSamples.n_cols, numChains);
+  BOOST_REQUIRE_EQUAL(arma::accu(arma::abs(hiddenSamples %
+      (1 - hiddenSamples))), 0.0);
+  arma::vec averageHidden = arma::mean(hiddenSamples, 1);
+  for (size_t i = 0; i < hiddenSize; ++i)
+    BOOST_REQUIRE_SMALL(averageHidden(i) - hiddenMean(i), 0.02);
+
+  arma::mat hidden = arma::repmat(hiddenSamples.col(0), 1, numChains);
+  arma::mat visibleMean, visibleSamples;
+  model.VisibleMean(std::move(arma::mat(hiddenSamples.col(0))),
+      std::move(visibleMean));
+  model.SampleVisible(std::move(hidden), std::move(visibleSamples));
+  arma::vec averageVisible = arma::mean(visibleSamples, 1);
+  for (size_t i = 0; i < visibleSize; ++i)
+    BOOST_REQUIRE_SMALL(averageVisible(i) - visibleMean(i), 0.02);
+
+  // The same seed has to give the same samples.
+  arma::mat first, second;
+  math::RandomSeed(7);
+  model.SampleVisible(std::move(arma::mat(hidden)), std::move(first));
+  math::RandomSeed(7);
+  model.SampleVisible(std::move(arma::mat(hidden)), std::move(second));
+  CheckMatrices(first, second);
+
+  // With persistence, the chains started by the first call are continued
+  // no matter which input is given later.
+  arma::mat negative;
+  model.Gibbs(std::move(arma::mat(data.cols(0, 4))), std::move(negative));
+  BOOST_REQUIRE_EQUAL(model.PersistentState().n_cols, 5);
+  model.Gibbs(std::move(arma::mat(data.cols(0, 1))), std::move(negative));
+  BOOST_REQUIRE_EQUAL(negative.n_cols, 5);
+  CheckMatrices(negative, model.PersistentState());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
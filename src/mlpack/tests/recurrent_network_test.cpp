@@ -1413,6 +1413,244 @@ BOOST_AUTO_TEST_CASE(BRNNTrainReturnObjective)
   BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
 }
 
+/**
+ * Make sure that the reused output parameter workspace of the RNN doesn't
+ * change the gradient, also for nested modules and changing batch sizes.
+ */
+BOOST_AUTO_TEST_CASE(RNNGradientWorkspaceTest)
+{
+  const size_t rho = 5;
+
+  Add<> add(4);
+  Linear<> lookup(1, 4);
+  SigmoidLayer<> sigmoidLayer;
+  Linear<> linear(4, 4);
+  Recurrent<>* recurrent = new Recurrent<>(add, lookup, linear,
+      sigmoidLayer, rho);
+
+  RNN<MeanSquaredError<> > model(rho);
+  model.Add<IdentityLayer<> >();
+  model.Add(recurrent);
+  model.Add<Linear<> >(4, 2);
+
+  model.Predictors() = arma::randu<arma::cube>(1, 6, rho);
+  model.Responses() = arma::randu<arma::cube>(2, 6, rho);
+  model.ResetParameters();
+
+  arma::mat gradient1, gradient2, gradient3;
+  const double objective1 = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient1, 3);
+
+  // Use a different batch size in between.
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient2, 6);
+
+  const double objective3 = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient3, 3);
+
+  BOOST_REQUIRE_CLOSE(objective1, objective3, 1e-5);
+  CheckMatrices(gradient1, gradient3);
+}
+
+/**
+ * Add the layers used by RNNSequenceLengthsTest to the given model.
+ */
+template<typename ModelType>
+void BuildSequenceLengthsModel(ModelType& model, const size_t rho)
+{
+  Add<> add(4);
+  Linear<> lookup(2, 4);
+  SigmoidLayer<> sigmoidLayer;
+  Linear<> linear(4, 4);
+
+  model.Add<IdentityLayer<> >();
+  model.Add(new Recurrent<>(add, lookup, linear, sigmoidLayer, rho));
+  model.Add<LSTM<> >(4, 4, rho);
+  model.Add<Linear<> >(4, 3);
+  model.Add<LogSoftMax<> >();
+}
+
+/**
+ * Make sure that the padded time steps of sequences shorter than the batch
+ * contribute neither to the objective nor to the gradient, by comparing a
+ * padded batch to both sequences evaluated on their own.
+ */
+BOOST_AUTO_TEST_CASE(RNNSequenceLengthsTest)
+{
+  const size_t rho = 5;
+  const arma::cube input = arma::randu<arma::cube>(2, 2, rho);
+  const arma::cube target = arma::floor(
+      arma::randu<arma::cube>(1, 2, rho) * 3) + 1;
+
+  // The first sequence only has three time steps.
+  RNN<NegativeLogLikelihood<> > model(rho);
+  BuildSequenceLengthsModel(model, rho);
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.SequenceLengths() = arma::urowvec("3 5");
+  model.ResetParameters();
+
+  RNN<NegativeLogLikelihood<> > shortModel(3);
+  BuildSequenceLengthsModel(shortModel, rho);
+  shortModel.Predictors() = input.subcube(0, 0, 0, 1, 0, 2);
+  shortModel.Responses() = target.subcube(0, 0, 0, 0, 0, 2);
+  shortModel.ResetParameters();
+  shortModel.Parameters() = model.Parameters();
+
+  RNN<NegativeLogLikelihood<> > longModel(rho);
+  BuildSequenceLengthsModel(longModel, rho);
+  longModel.Predictors() = input.subcube(0, 1, 0, 1, 1, rho - 1);
+  longModel.Responses() = target.subcube(0, 1, 0, 0, 1, rho - 1);
+  longModel.ResetParameters();
+  longModel.Parameters() = model.Parameters();
+
+  arma::mat gradient, shortGradient, longGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 2);
+  const double shortObjective = shortModel.EvaluateWithGradient(
+      shortModel.Parameters(), 0, shortGradient, 1);
+  const double longObjective = longModel.EvaluateWithGradient(
+      longModel.Parameters(), 0, longGradient, 1);
+
+  BOOST_REQUIRE_CLOSE(objective, shortObjective + longObjective, 1e-5);
+  CheckMatrices(gradient, arma::mat(shortGradient + longGradient));
+
+  BOOST_REQUIRE_CLOSE(model.Evaluate(model.Parameters(), 0, 2),
+      shortModel.Evaluate(shortModel.Parameters(), 0, 1) +
+      longModel.Evaluate(longModel.Parameters(), 0, 1), 1e-5);
+}
+
+/**
+ * Make sure that training with sequence lengths leaves the lengths given by
+ * the user in their order, so that the same data can be trained on again.
+ */
+BOOST_AUTO_TEST_CASE(RNNSequenceLengthsOrderTest)
+{
+  const size_t rho = 5;
+  const arma::cube input = arma::randu<arma::cube>(2, 4, rho);
+  const arma::cube target = arma::floor(
+      arma::randu<arma::cube>(1, 4, rho) * 3) + 1;
+  const arma::urowvec lengths("2 5 3 4");
+
+  RNN<NegativeLogLikelihood<> > model(rho);
+  BuildSequenceLengthsModel(model, rho);
+  model.SequenceLengths() = lengths;
+
+  ens::StandardSGD opt(0.1, 2, 8, -100, false);
+  model.Train(input, target, opt);
+
+  const arma::urowvec& trainedLengths = model.SequenceLengths();
+  BOOST_REQUIRE_EQUAL(trainedLengths.n_elem, lengths.n_elem);
+  for (size_t i = 0; i < lengths.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(trainedLengths[i], lengths[i]);
+
+  // Training on the same data again gives the same objective as a fresh model
+  // with the same parameters.
+  RNN<NegativeLogLikelihood<> > freshModel(rho);
+  BuildSequenceLengthsModel(freshModel, rho);
+  freshModel.SequenceLengths() = lengths;
+  freshModel.ResetParameters();
+  freshModel.Parameters() = model.Parameters();
+
+  ens::StandardSGD freshOpt(0.1, 2, 8, -100, false);
+  const double objective = model.Train(input, target, opt);
+  const double freshObjective = freshModel.Train(input, target, freshOpt);
+  BOOST_REQUIRE_CLOSE(objective, freshObjective, 1e-5);
+}
+
+/**
+ * Make sure that shuffling the data of a network trained with sequence lengths
+ * keeps the sequences of each batch sorted together, so that every batch still
+ * runs only as many time steps as its longest sequence needs.
+ */
+BOOST_AUTO_TEST_CASE(RNNSequenceLengthsShuffleTest)
+{
+  const size_t rho = 5;
+  const arma::cube input = arma::randu<arma::cube>(2, 7, rho);
+  const arma::cube target = arma::floor(
+      arma::randu<arma::cube>(1, 7, rho) * 3) + 1;
+
+  RNN<NegativeLogLikelihood<> > model(rho);
+  BuildSequenceLengthsModel(model, rho);
+  model.SequenceLengths() = arma::urowvec("2 5 3 4 1 5 2");
+
+  // The sorted lengths 5 5 | 4 3 | 2 2 | 1 form batches of 5, 4 and 2 steps,
+  // and the last batch of a single sequence of length 1.
+  ens::StandardSGD opt(0.1, 2, 14, -100, true);
+  model.Train(input, target, opt);
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    model.Shuffle();
+
+    size_t steps = 0;
+    for (size_t begin = 0; begin < 6; begin += 2)
+      steps += model.BatchSteps(begin, 2);
+
+    BOOST_REQUIRE_EQUAL(steps, 11);
+    BOOST_REQUIRE_EQUAL(model.BatchSteps(6, 1), 1);
+  }
+}
+
+/**
+ * Add the layers used by RNNStatefulTest to the given model.
+ */
+template<typename ModelType>
+void BuildStatefulModel(ModelType& model)
+{
+  model.Add<IdentityLayer<> >();
+  model.Add<LSTM<> >(3, 5);
+  model.Add<FastLSTM<> >(5, 5);
+  model.Add<Linear<> >(5, 2);
+}
+
+/**
+ * Make sure that a stateful network that processes a sequence in chunks, or
+ * one time step at a time, gives the same objective and predictions as a
+ * network that processes the whole sequence at once.
+ */
+BOOST_AUTO_TEST_CASE(RNNStatefulTest)
+{
+  const size_t steps = 6;
+  const arma::cube input = arma::randu<arma::cube>(3, 4, steps);
+  const arma::cube target = arma::randu<arma::cube>(2, 4, steps);
+
+  RNN<MeanSquaredError<> > model(steps);
+  BuildStatefulModel(model);
+  model.Predictors() = input;
+  model.Responses() = target;
+  model.ResetParameters();
+
+  // Carry the state over three chunks of two time steps.
+  RNN<MeanSquaredError<> > statefulModel(2);
+  BuildStatefulModel(statefulModel);
+  statefulModel.Stateful() = true;
+  statefulModel.Predictors() = input;
+  statefulModel.Responses() = target;
+  statefulModel.ResetParameters();
+  statefulModel.Parameters() = model.Parameters();
+
+  const double objective = model.Evaluate(model.Parameters(), 0, 4);
+  const double statefulObjective = statefulModel.Evaluate(
+      statefulModel.Parameters(), 0, 3);
+  BOOST_REQUIRE_CLOSE(objective, statefulObjective, 1e-5);
+
+  // The gradient is truncated at the chunk boundaries, but the state is still
+  // carried over in the forward pass.
+  arma::mat gradient;
+  BOOST_REQUIRE_CLOSE(statefulModel.EvaluateWithGradient(
+      statefulModel.Parameters(), 0, gradient, 3), statefulObjective, 1e-5);
+
+  arma::cube results;
+  model.Predict(input, results);
+
+  arma::mat output;
+  for (size_t t = 0; t < steps; ++t)
+  {
+    statefulModel.PredictStep(input.slice(t), output);
+    CheckMatrices(output, results.slice(t));
+  }
+}
+
 /**
  * Test that RNN::Train() does not give an error for large rho.
  */
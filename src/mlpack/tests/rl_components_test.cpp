@@ -20,6 +20,7 @@
 #include <mlpack/methods/reinforcement_learning/environment/continuous_double_pole_cart.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
+#include <mlpack/methods/reinforcement_learning/environment/vector_environment.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 
@@ -169,6 +170,128 @@ BOOST_AUTO_TEST_CASE(SimpleCartPoleTest)
   BOOST_REQUIRE_EQUAL(2, CartPole::Action::size);
 }
 
+/**
+ * A CartPole without the batched Sample() overload, so that VectorEnvironment
+ * samples every copy on its own.
+ */
+class UnbatchedCartPole : public CartPole
+{
+ public:
+  UnbatchedCartPole(const CartPole& task = CartPole()) : CartPole(task) { }
+
+  double Sample(const State& state, const Action& action, State& nextState)
+  {
+    return CartPole::Sample(state, action, nextState);
+  }
+};
+
+/**
+ * Step a vectorized environment once and compare every copy against a single
+ * environment that is sampled on its own.
+ */
+template<typename EnvironmentType>
+void CheckVectorEnvironment()
+{
+  const size_t numEnvironments = 6;
+  VectorEnvironment<EnvironmentType> environments(numEnvironments);
+  BOOST_REQUIRE_EQUAL(environments.NumEnvironments(), numEnvironments);
+  BOOST_REQUIRE_EQUAL(environments.States().n_cols, numEnvironments);
+
+  std::vector<typename EnvironmentType::Action> actions(numEnvironments);
+  for (size_t i = 0; i < numEnvironments; ++i)
+  {
+    actions[i] = static_cast<typename EnvironmentType::Action>(
+        i % EnvironmentType::Action::size);
+  }
+
+  const arma::mat states = environments.States();
+  arma::rowvec rewards;
+  arma::mat nextStates;
+  arma::urowvec terminal;
+  environments.Step(actions, rewards, nextStates, terminal);
+
+  for (size_t i = 0; i < numEnvironments; ++i)
+  {
+    EnvironmentType task;
+    typename EnvironmentType::State nextState;
+    const double reward = task.Sample(typename EnvironmentType::State(
+        arma::colvec(states.col(i))), actions[i], nextState);
+
+    CheckMatrices(arma::mat(nextStates.col(i)), nextState.Encode(), 1e-10);
+    BOOST_REQUIRE_CLOSE(rewards[i], reward, 1e-10);
+    BOOST_REQUIRE_EQUAL((bool) terminal[i], task.IsTerminal(nextState));
+  }
+}
+
+/**
+ * Make sure the vectorized environments advance every copy like the single
+ * environment does, with and without a batched Sample() implementation, and
+ * that episodes are restarted at the step limit.
+ */
+BOOST_AUTO_TEST_CASE(VectorEnvironmentTest)
+{
+  CheckVectorEnvironment<CartPole>();
+  CheckVectorEnvironment<MountainCar>();
+  CheckVectorEnvironment<Acrobot>();
+
+  VectorEnvironment<MountainCar> environments(4, MountainCar(), 3);
+  std::vector<MountainCar::Action> actions(4, MountainCar::Action::stop);
+  arma::rowvec rewards;
+  arma::mat nextStates;
+  arma::urowvec terminal;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    environments.Step(actions, rewards, nextStates, terminal);
+    BOOST_REQUIRE(environments.FinishedReturns().empty());
+  }
+
+  environments.Step(actions, rewards, nextStates, terminal);
+  BOOST_REQUIRE_EQUAL(environments.FinishedReturns().size(), 4);
+  for (size_t i = 0; i < 4; ++i)
+    BOOST_REQUIRE_EQUAL(environments.FinishedReturns()[i], -3.0);
+
+  // The batched and the single state Sample() both end an episode after the
+  // maximum number of steps of the environment, and reward its last step with
+  // doneReward.  The step limit defaults to that maximum.
+  const CartPole task(9.8, 1.0, 0.1, 0.5, 10.0, 0.02, 12 * 2 * 3.1416 / 360,
+      2.4, 0.5, 3);
+  math::RandomSeed(7);
+  VectorEnvironment<CartPole> batched(4, task);
+  math::RandomSeed(7);
+  VectorEnvironment<UnbatchedCartPole> unbatched(4, UnbatchedCartPole(task));
+  BOOST_REQUIRE_EQUAL(batched.StepLimit(), 3);
+  BOOST_REQUIRE_EQUAL(unbatched.StepLimit(), 3);
+
+  std::vector<CartPole::Action> cartActions(4);
+  for (size_t i = 0; i < 4; ++i)
+    cartActions[i] = (i % 2) ? CartPole::Action::forward :
+        CartPole::Action::backward;
+
+  arma::rowvec unbatchedRewards;
+  arma::mat unbatchedNextStates;
+  arma::urowvec unbatchedTerminal;
+  for (size_t step = 0; step < 5; ++step)
+  {
+    batched.Step(cartActions, rewards, nextStates, terminal);
+    unbatched.Step(cartActions, unbatchedRewards, unbatchedNextStates,
+        unbatchedTerminal);
+
+    CheckMatrices(nextStates, unbatchedNextStates, 1e-10);
+    CheckMatrices(rewards, unbatchedRewards, 1e-10);
+    for (size_t i = 0; i < 4; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(terminal[i], unbatchedTerminal[i]);
+      BOOST_REQUIRE_EQUAL((bool) terminal[i], step == 2);
+    }
+  }
+
+  BOOST_REQUIRE(batched.FinishedReturns().empty());
+  batched.Step(cartActions, rewards, nextStates, terminal);
+  BOOST_REQUIRE_EQUAL(batched.FinishedReturns().size(), 4);
+  for (size_t i = 0; i < 4; ++i)
+    BOOST_REQUIRE_CLOSE(batched.FinishedReturns()[i], 2.5, 1e-10);
+}
+
 /**
  * Constructs a DoublePoleCart instance and check if the main routine works as
  * it should be.
@@ -281,4 +404,29 @@ BOOST_AUTO_TEST_CASE(GreedyPolicyTest)
   BOOST_REQUIRE_CLOSE(actionValue[action], actionValue.max(), 1e-5);
 }
 
+/**
+ * Make sure that the policy and the environment draw from a given generator
+ * reproducibly and leave the mlpack generator alone.
+ */
+BOOST_AUTO_TEST_CASE(GeneratorSampleTest)
+{
+  GreedyPolicy<CartPole> policy(0.5, 10, 0.5);
+  CartPole env;
+  arma::colvec actionValue = arma::randn<arma::colvec>(CartPole::Action::size);
+
+  std::mt19937 first(7), second(7);
+  const std::mt19937 global = math::randGen;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(policy.Sample(actionValue, first),
+        policy.Sample(actionValue, second));
+
+    const arma::colvec state = env.InitialSample(first).Encode();
+    BOOST_REQUIRE(arma::approx_equal(state, env.InitialSample(second).Encode(),
+        "absdiff", 1e-10));
+    BOOST_REQUIRE_LE(arma::abs(state).max(), 0.05);
+  }
+  BOOST_REQUIRE(global == math::randGen);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
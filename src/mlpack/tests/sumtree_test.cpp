@@ -91,4 +91,40 @@ BOOST_AUTO_TEST_CASE(BatchUpdate)
   BOOST_CHECK_EQUAL(sumtree.FindPrefixSum(3.0), 3);
 }
 
+/**
+ * Test that partial batch updates and batched prefix sum searches agree with
+ * single updates and single searches, also for a capacity that is not a power
+ * of two.
+ */
+BOOST_AUTO_TEST_CASE(BatchUpdatePartialAndBatchedSearch)
+{
+  const size_t capacities[] = { 5, 16 };
+  for (const size_t capacity : capacities)
+  {
+    SumTree<double> batchTree(capacity), singleTree(capacity);
+    arma::colvec values = arma::randu<arma::colvec>(capacity);
+    for (size_t i = 0; i < capacity; ++i)
+    {
+      batchTree.Set(i, values[i]);
+      singleTree.Set(i, values[i]);
+    }
+
+    // Update a few leaves, including a repeated one.
+    arma::ucolvec indices = {1, 3, capacity - 1, 3};
+    arma::colvec data = {0.5, 2.0, 0.1, 1.5};
+    batchTree.BatchUpdate(indices, data);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      singleTree.Set(indices[i], data[i]);
+
+    BOOST_REQUIRE_CLOSE(batchTree.Sum(), singleTree.Sum(), 1e-10);
+
+    arma::colvec masses = arma::randu<arma::colvec>(50) * singleTree.Sum();
+    arma::ucolvec found;
+    batchTree.FindPrefixSums(masses, found);
+    BOOST_REQUIRE_EQUAL(found.n_elem, masses.n_elem);
+    for (size_t i = 0; i < masses.n_elem; ++i)
+      BOOST_REQUIRE_EQUAL(found[i], singleTree.FindPrefixSum(masses[i]));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();